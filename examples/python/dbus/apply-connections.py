@@ -0,0 +1,159 @@
+#!/usr/bin/env python
+# SPDX-License-Identifier: GPL-2.0-or-later
+#
+# Copyright (C) 2026 Red Hat, Inc.
+#
+
+#
+# This example adds, replaces and deletes many dummy connection profiles,
+# once with one AddConnection2()/Update2()/Delete() call per profile, and
+# once with a single ApplyConnections() call per step, and prints how long
+# each took.
+#
+# Usage: apply-connections.py [COUNT] [--to-disk]
+#
+# By default, 10000 profiles are created in memory only. With --to-disk,
+# they are written as keyfiles.
+#
+
+import sys, time, uuid
+import dbus
+
+NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK = 0x1
+NM_SETTINGS_ADD_CONNECTION2_FLAG_IN_MEMORY = 0x2
+NM_SETTINGS_ADD_CONNECTION2_FLAG_BLOCK_AUTOCONNECT = 0x20
+
+NM_SETTINGS_UPDATE2_FLAG_TO_DISK = 0x1
+NM_SETTINGS_UPDATE2_FLAG_IN_MEMORY = 0x2
+NM_SETTINGS_UPDATE2_FLAG_BLOCK_AUTOCONNECT = 0x20
+
+count = 10000
+to_disk = False
+for arg in sys.argv[1:]:
+    if arg == "--to-disk":
+        to_disk = True
+    else:
+        count = int(arg)
+
+if to_disk:
+    add_flags = NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK
+    update_flags = NM_SETTINGS_UPDATE2_FLAG_TO_DISK
+else:
+    add_flags = NM_SETTINGS_ADD_CONNECTION2_FLAG_IN_MEMORY
+    update_flags = NM_SETTINGS_UPDATE2_FLAG_IN_MEMORY
+add_flags |= NM_SETTINGS_ADD_CONNECTION2_FLAG_BLOCK_AUTOCONNECT
+update_flags |= NM_SETTINGS_UPDATE2_FLAG_BLOCK_AUTOCONNECT
+
+bus = dbus.SystemBus()
+proxy = bus.get_object(
+    "org.freedesktop.NetworkManager", "/org/freedesktop/NetworkManager/Settings"
+)
+settings = dbus.Interface(proxy, "org.freedesktop.NetworkManager.Settings")
+
+
+def make_profile(i, u, prio):
+    return dbus.Dictionary(
+        {
+            "connection": dbus.Dictionary(
+                {
+                    "type": "dummy",
+                    "uuid": u,
+                    "id": "apply-connections-%d" % i,
+                    "interface-name": "apc%d" % i,
+                    "autoconnect": False,
+                    "autoconnect-priority": dbus.Int32(prio),
+                }
+            ),
+            "ipv4": dbus.Dictionary({"method": "disabled"}),
+            "ipv6": dbus.Dictionary({"method": "ignore"}),
+        },
+        signature="sa{sv}",
+    )
+
+
+def empty_settings():
+    return dbus.Dictionary({}, signature="sa{sv}")
+
+
+def measure(what, func):
+    start = time.monotonic()
+    func()
+    print("%-40s %8.3f s" % (what, time.monotonic() - start))
+
+
+def check_results(results):
+    for path, error in results:
+        if error:
+            raise Exception("operation failed: %s" % error)
+
+
+def run_single():
+    uuids = [str(uuid.uuid4()) for i in range(count)]
+    paths = []
+
+    def add():
+        for i in range(count):
+            path, result = settings.AddConnection2(
+                make_profile(i, uuids[i], 0), dbus.UInt32(add_flags), {}
+            )
+            paths.append(path)
+
+    def replace():
+        for i in range(count):
+            con = dbus.Interface(
+                bus.get_object("org.freedesktop.NetworkManager", paths[i]),
+                "org.freedesktop.NetworkManager.Settings.Connection",
+            )
+            con.Update2(make_profile(i, uuids[i], 1), dbus.UInt32(update_flags), {})
+
+    def delete():
+        for path in paths:
+            con = dbus.Interface(
+                bus.get_object("org.freedesktop.NetworkManager", path),
+                "org.freedesktop.NetworkManager.Settings.Connection",
+            )
+            con.Delete()
+
+    measure("AddConnection2() x %d" % count, add)
+    measure("Update2() x %d" % count, replace)
+    measure("Delete() x %d" % count, delete)
+
+
+def run_batch():
+    uuids = [str(uuid.uuid4()) for i in range(count)]
+    paths = []
+
+    def apply(operations):
+        results = settings.ApplyConnections(
+            dbus.Array(operations, signature="(soa{sa{sv}})"),
+            dbus.UInt32(add_flags),
+            {},
+            timeout=600,
+        )
+        check_results(results)
+        return results
+
+    def add():
+        results = apply(
+            [("add", "/", make_profile(i, uuids[i], 0)) for i in range(count)]
+        )
+        paths.extend([path for path, error in results])
+
+    def replace():
+        apply(
+            [
+                ("update", paths[i], make_profile(i, uuids[i], 1))
+                for i in range(count)
+            ]
+        )
+
+    def delete():
+        apply([("delete", path, empty_settings()) for path in paths])
+
+    measure("ApplyConnections(add x %d)" % count, add)
+    measure("ApplyConnections(update x %d)" % count, replace)
+    measure("ApplyConnections(delete x %d)" % count, delete)
+
+
+run_single()
+run_batch()
@@ -1810,6 +1810,7 @@ nm_utils_platform_capture_ip_setting(NMPlatform *platform,
     const char                        *method = NULL;
     char                               sbuf[NM_INET_ADDRSTRLEN];
     const NMPlatformIPXRoute          *best_default_route = NULL;
+    gs_unref_ptrarray GPtrArray       *s_routes           = NULL;
 
     s_ip =
         NM_SETTING_IP_CONFIG(IS_IPv4 ? nm_setting_ip4_config_new() : nm_setting_ip6_config_new());
@@ -1886,8 +1887,8 @@ nm_utils_platform_capture_ip_setting(NMPlatform *platform,
 
     nmp_lookup_init_object_by_ifindex(&lookup, NMP_OBJECT_TYPE_IP_ROUTE(IS_IPv4), ifindex);
     nm_platform_iter_obj_for_each (&iter, platform, &lookup, &obj) {
-        const NMPlatformIPXRoute         *route   = NMP_OBJECT_CAST_IPX_ROUTE(obj);
-        nm_auto_unref_ip_route NMIPRoute *s_route = NULL;
+        const NMPlatformIPXRoute *route = NMP_OBJECT_CAST_IPX_ROUTE(obj);
+        NMIPRoute                *s_route;
 
         if (!IS_IPv4) {
             /* Ignore link-local route. */
@@ -1913,7 +1914,14 @@ nm_utils_platform_capture_ip_setting(NMPlatform *platform,
                                          nm_platform_ip_route_get_gateway(addr_family, &route->rx),
                                          route->rx.metric,
                                          NULL);
-        nm_setting_ip_config_add_route(s_ip, s_route);
+        if (!s_routes)
+            s_routes = g_ptr_array_new_with_free_func((GDestroyNotify) nm_ip_route_unref);
+        g_ptr_array_add(s_routes, s_route);
+    }
+    if (s_routes) {
+        _nm_setting_ip_config_add_routes(s_ip,
+                                         (NMIPRoute *const *) s_routes->pdata,
+                                         s_routes->len);
     }
 
     if (best_default_route && nm_setting_ip_config_get_num_addresses(s_ip) > 0) {
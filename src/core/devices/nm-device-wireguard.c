@@ -70,6 +70,10 @@ G_STATIC_ASSERT(NM_WIREGUARD_SYMMETRIC_KEY_LEN == NMP_WIREGUARD_SYMMETRIC_KEY_LE
 
 #define RETRY_IN_MSEC_MAX ((gint64) (30 * 60 * 1000))
 
+/* the maximum number of peer endpoints that we resolve in parallel. Further requests
+ * are queued and started as earlier ones complete. */
+#define RESOLVE_PARALLEL_MAX 16u
+
 typedef enum {
     LINK_CONFIG_MODE_FULL,
     LINK_CONFIG_MODE_REAPPLY,
@@ -103,10 +107,20 @@ typedef struct {
 
     CList lst_peers;
 
+    /* linked in lst_resolve_queue_head while waiting for a free resolve slot. */
+    CList lst_resolve_queue;
+
     PeerEndpointResolveData ep_resolv;
 
+    /* the endpoint that we last configured in kernel. With LINK_CONFIG_MODE_ENDPOINTS
+     * we only send peers whose resolved endpoint differs from this. */
+    NMSockAddrUnion ep_configured;
+
     /* dirty flag used during _peers_update_all(). */
     bool dirty_update_all : 1;
+
+    /* whether the endpoint is part of the change that link_config() is about to send. */
+    bool ep_configure_pending : 1;
 } PeerData;
 
 NM_GOBJECT_PROPERTIES_DEFINE(NMDeviceWireGuard, PROP_PUBLIC_KEY, PROP_LISTEN_PORT, PROP_FWMARK, );
@@ -120,6 +134,8 @@ typedef struct {
     CList       lst_peers_head;
     GHashTable *peers;
 
+    CList lst_resolve_queue_head;
+
     /* counts the numbers of peers that are currently resolving. */
     guint peers_resolving_cnt;
 
@@ -543,6 +559,12 @@ _peers_resolving_cnt_decrement(NMDeviceWireGuard *self)
 
     nm_assert(_peers_resolving_cnt(priv) == priv->peers_resolving_cnt);
 
+    if (!c_list_is_empty(&priv->lst_resolve_queue_head)) {
+        _peers_resolve_start(
+            self,
+            c_list_first_entry(&priv->lst_resolve_queue_head, PeerData, lst_resolve_queue));
+    }
+
     if (priv->peers_resolving_cnt == 0) {
         if (nm_device_get_state(NM_DEVICE(self)) == NM_DEVICE_STATE_CONFIG) {
             _LOGT(LOGD_DEVICE,
@@ -564,6 +586,7 @@ _peers_remove(NMDeviceWireGuard *self, PeerData *peer_data)
         nm_assert_not_reached();
 
     c_list_unlink_stale(&peer_data->lst_peers);
+    c_list_unlink(&peer_data->lst_resolve_queue);
     nm_wireguard_peer_unref(peer_data->peer);
     if (nm_clear_g_cancellable(&peer_data->ep_resolv.cancellable))
         _peers_resolving_cnt_decrement(self);
@@ -589,12 +612,14 @@ _peers_add(NMDeviceWireGuard *self, NMWireGuardPeer *peer)
 
     peer_data  = g_slice_new(PeerData);
     *peer_data = (PeerData){
-        .self = self,
-        .peer = nm_wireguard_peer_ref(peer),
+        .self              = self,
+        .peer              = nm_wireguard_peer_ref(peer),
+        .lst_resolve_queue = C_LIST_INIT(peer_data->lst_resolve_queue),
         .ep_resolv =
             {
                 .sockaddr = NM_SOCK_ADDR_UNION_INIT_UNSPEC,
             },
+        .ep_configured = NM_SOCK_ADDR_UNION_INIT_UNSPEC,
     };
 
     c_list_link_tail(&priv->lst_peers_head, &peer_data->lst_peers);
@@ -879,10 +904,28 @@ _peers_resolve_start(NMDeviceWireGuard *self, PeerData *peer_data)
     gs_unref_object GResolver *resolver = NULL;
     const char                *host;
 
-    resolver = g_resolver_get_default();
-
     nm_assert(!peer_data->ep_resolv.cancellable);
 
+    if (priv->peers_resolving_cnt >= RESOLVE_PARALLEL_MAX) {
+        /* Don't flood the resolver when many peers need resolving at once (for example,
+         * on activation or after DNS changed). Queue the peer; it gets started
+         * by _peers_resolving_cnt_decrement(). Like with an ongoing request, the
+         * global retry timer doesn't need to guard it. */
+        if (!c_list_is_linked(&peer_data->lst_resolve_queue)) {
+            c_list_link_tail(&priv->lst_resolve_queue_head, &peer_data->lst_resolve_queue);
+            _LOGT(LOGD_DEVICE,
+                  "wireguard-peer[%s]: queue resolving endpoint \"%s\"",
+                  nm_wireguard_peer_get_public_key(peer_data->peer),
+                  nm_wireguard_peer_get_endpoint(peer_data->peer));
+        }
+        peer_data->ep_resolv.next_try_at_nsec = NEXT_TRY_AT_NSEC_PAST;
+        return;
+    }
+
+    c_list_unlink(&peer_data->lst_resolve_queue);
+
+    resolver = g_resolver_get_default();
+
     peer_data->ep_resolv.cancellable = g_cancellable_new();
     priv->peers_resolving_cnt++;
 
@@ -982,6 +1025,7 @@ _peers_update(NMDeviceWireGuard *self,
     if (nm_sock_addr_union_cmp(&peer_data->ep_resolv.sockaddr, &sockaddr) != 0)
         changed = TRUE;
 
+    c_list_unlink(&peer_data->lst_resolve_queue);
     if (nm_clear_g_cancellable(&peer_data->ep_resolv.cancellable))
         _peers_resolving_cnt_decrement(self);
 
@@ -1021,18 +1065,26 @@ _peers_remove_all(NMDeviceWireGuard *self)
     NMDeviceWireGuardPrivate *priv = NM_DEVICE_WIREGUARD_GET_PRIVATE(self);
     PeerData                 *peer_data;
 
+    /* drop the queue first, so that cancelling the ongoing requests does not
+     * start the queued ones. */
+    while ((peer_data = c_list_first_entry(&priv->lst_resolve_queue_head,
+                                           PeerData,
+                                           lst_resolve_queue)))
+        c_list_unlink(&peer_data->lst_resolve_queue);
+
     while ((peer_data = c_list_first_entry(&priv->lst_peers_head, PeerData, lst_peers)))
         _peers_remove(self, peer_data);
 }
 
 static void
-_peers_update_all(NMDeviceWireGuard *self, NMSettingWireGuard *s_wg, gboolean *out_peers_removed)
+_peers_update_all(NMDeviceWireGuard *self, NMSettingWireGuard *s_wg, GArray **out_removed_peers)
 {
     NMDeviceWireGuardPrivate *priv = NM_DEVICE_WIREGUARD_GET_PRIVATE(self);
     PeerData                 *peer_data_safe;
     PeerData                 *peer_data;
     guint                     i, n;
-    gboolean                  peers_removed = FALSE;
+
+    nm_assert(!out_removed_peers || !*out_removed_peers);
 
     c_list_for_each_entry (peer_data, &priv->lst_peers_head, lst_peers)
         peer_data->dirty_update_all = TRUE;
@@ -1052,18 +1104,45 @@ _peers_update_all(NMDeviceWireGuard *self, NMSettingWireGuard *s_wg, gboolean *o
     }
 
     c_list_for_each_entry_safe (peer_data, peer_data_safe, &priv->lst_peers_head, lst_peers) {
-        if (peer_data->dirty_update_all) {
-            _peers_remove(self, peer_data);
-            peers_removed = TRUE;
+        if (!peer_data->dirty_update_all)
+            continue;
+
+        if (out_removed_peers) {
+            NMPWireGuardPeer plp = {};
+
+            /* remember the public key, so that link_config() can remove just this
+             * peer from kernel. */
+            if (nm_utils_base64secret_decode(nm_wireguard_peer_get_public_key(peer_data->peer),
+                                             sizeof(plp.public_key),
+                                             plp.public_key)) {
+                if (!*out_removed_peers)
+                    *out_removed_peers = g_array_new(FALSE, FALSE, sizeof(NMPWireGuardPeer));
+                g_array_append_val(*out_removed_peers, plp);
+            }
         }
+
+        _peers_remove(self, peer_data);
     }
+}
+
+static void
+_peers_endpoints_configured(NMDeviceWireGuardPrivate *priv, gboolean success)
+{
+    PeerData *peer_data;
 
-    NM_SET_OUT(out_peers_removed, peers_removed);
+    c_list_for_each_entry (peer_data, &priv->lst_peers_head, lst_peers) {
+        if (!peer_data->ep_configure_pending)
+            continue;
+        peer_data->ep_configure_pending = FALSE;
+        if (success)
+            peer_data->ep_configured = peer_data->ep_resolv.sockaddr;
+    }
 }
 
 static void
 _peers_get_platform_list(NMDeviceWireGuardPrivate            *priv,
                          LinkConfigMode                       config_mode,
+                         GArray                              *removed_peers,
                          NMPWireGuardPeer                   **out_peers,
                          NMPlatformWireGuardChangePeerFlags **out_peer_flags,
                          guint                               *out_len,
@@ -1088,6 +1167,9 @@ _peers_get_platform_list(NMDeviceWireGuardPrivate            *priv,
 
     nm_assert(len == c_list_length(&priv->lst_peers_head));
 
+    if (removed_peers)
+        len += removed_peers->len;
+
     if (len == 0)
         return;
 
@@ -1100,6 +1182,21 @@ _peers_get_platform_list(NMDeviceWireGuardPrivate            *priv,
         NMPWireGuardPeer                   *plp = &plpeers[i_good];
         NMSettingSecretFlags                psk_secret_flags;
 
+        peer_data->ep_configure_pending = FALSE;
+
+        if (config_mode == LINK_CONFIG_MODE_FULL) {
+            /* we are going to replace all peers. */
+            peer_data->ep_configured = (NMSockAddrUnion) NM_SOCK_ADDR_UNION_INIT_UNSPEC;
+        } else if (config_mode == LINK_CONFIG_MODE_ENDPOINTS
+                   && (peer_data->ep_resolv.sockaddr.sa.sa_family == AF_UNSPEC
+                       || nm_sock_addr_union_cmp(&peer_data->ep_resolv.sockaddr,
+                                                 &peer_data->ep_configured)
+                              == 0)) {
+            /* only peers with a new endpoint need an update. Rewriting the others
+             * is expensive with many peers and would undo kernel's roaming. */
+            continue;
+        }
+
         if (!nm_utils_base64secret_decode(nm_wireguard_peer_get_public_key(peer_data->peer),
                                           sizeof(plp->public_key),
                                           plp->public_key))
@@ -1175,6 +1272,8 @@ _peers_get_platform_list(NMDeviceWireGuardPrivate            *priv,
             plp->_construct_idx_end = allowed_ips->len;
         }
 
+        peer_data->ep_configure_pending =
+            NM_FLAGS_HAS(*plf, NM_PLATFORM_WIREGUARD_CHANGE_PEER_FLAG_HAS_ENDPOINT);
         i_good++;
         continue;
 
@@ -1182,6 +1281,14 @@ skip:
         memset(plp, 0, sizeof(*plp));
     }
 
+    if (removed_peers) {
+        for (i = 0; i < removed_peers->len; i++) {
+            plpeers[i_good]      = nm_g_array_index(removed_peers, NMPWireGuardPeer, i);
+            plpeer_flags[i_good] = NM_PLATFORM_WIREGUARD_CHANGE_PEER_FLAG_REMOVE_ME;
+            i_good++;
+        }
+    }
+
     if (i_good == 0)
         return;
 
@@ -1428,11 +1535,11 @@ link_config(NMDeviceWireGuard   *self,
     NMActStageReturn                            ret;
     gs_unref_array GArray                      *allowed_ips_data = NULL;
     NMPlatformLnkWireGuard                      wg_lnk;
-    gs_free NMPWireGuardPeer                   *plpeers      = NULL;
-    gs_free NMPlatformWireGuardChangePeerFlags *plpeer_flags = NULL;
-    guint                                       plpeers_len  = 0;
+    gs_free NMPWireGuardPeer                   *plpeers       = NULL;
+    gs_free NMPlatformWireGuardChangePeerFlags *plpeer_flags  = NULL;
+    guint                                       plpeers_len   = 0;
+    gs_unref_array GArray                      *removed_peers = NULL;
     const char                                 *setting_name;
-    gboolean                                    peers_removed;
     NMPlatformWireGuardChangeFlags              wg_change_flags;
     int                                         ifindex;
     int                                         r;
@@ -1484,14 +1591,18 @@ link_config(NMDeviceWireGuard   *self,
         return NM_ACT_STAGE_RETURN_FAILURE;
     }
 
-    _peers_update_all(self, s_wg, &peers_removed);
+    /* On reapply, peers that are no longer in the profile get removed individually
+     * instead of replacing all peers. That keeps the existing sessions of the other
+     * peers alive and is much cheaper with many peers. */
+    _peers_update_all(self,
+                      s_wg,
+                      NM_IN_SET(config_mode, LINK_CONFIG_MODE_REAPPLY) ? &removed_peers : NULL);
 
     wg_lnk = (NMPlatformLnkWireGuard){};
 
     wg_change_flags = NM_PLATFORM_WIREGUARD_CHANGE_FLAG_NONE;
 
-    if (NM_IN_SET(config_mode, LINK_CONFIG_MODE_FULL)
-        || (NM_IN_SET(config_mode, LINK_CONFIG_MODE_REAPPLY) && peers_removed))
+    if (NM_IN_SET(config_mode, LINK_CONFIG_MODE_FULL))
         wg_change_flags |= NM_PLATFORM_WIREGUARD_CHANGE_FLAG_REPLACE_PEERS;
 
     if (NM_IN_SET(config_mode, LINK_CONFIG_MODE_FULL, LINK_CONFIG_MODE_REAPPLY)) {
@@ -1517,11 +1628,17 @@ link_config(NMDeviceWireGuard   *self,
 
     _peers_get_platform_list(priv,
                              config_mode,
+                             removed_peers,
                              &plpeers,
                              &plpeer_flags,
                              &plpeers_len,
                              &allowed_ips_data);
 
+    if (plpeers_len == 0 && wg_change_flags == NM_PLATFORM_WIREGUARD_CHANGE_FLAG_NONE) {
+        _LOGT(LOGD_DEVICE, "wireguard link config (%s): nothing to change", reason);
+        return NM_ACT_STAGE_RETURN_SUCCESS;
+    }
+
     r = nm_platform_link_wireguard_change(nm_device_get_platform(NM_DEVICE(self)),
                                           ifindex,
                                           &wg_lnk,
@@ -1532,6 +1649,8 @@ link_config(NMDeviceWireGuard   *self,
 
     nm_explicit_bzero(plpeers, sizeof(plpeers[0]) * plpeers_len);
 
+    _peers_endpoints_configured(priv, r >= 0);
+
     if (r < 0) {
         NM_SET_OUT(out_failure_reason, NM_DEVICE_STATE_REASON_CONFIG_FAILED);
         return NM_ACT_STAGE_RETURN_FAILURE;
@@ -1953,6 +2072,7 @@ nm_device_wireguard_init(NMDeviceWireGuard *self)
     NMDeviceWireGuardPrivate *priv = NM_DEVICE_WIREGUARD_GET_PRIVATE(self);
 
     c_list_init(&priv->lst_peers_head);
+    c_list_init(&priv->lst_resolve_queue_head);
     priv->peers = g_hash_table_new(_peer_data_hash, _peer_data_equal);
 }
 
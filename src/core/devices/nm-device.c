@@ -141,6 +141,7 @@ typedef struct {
     NMPlatformAsyncCallback callback;
     gpointer                callback_data;
     NMPlatformSriovParams   sriov_params;
+    gint64                  start_msec;
 } SriovOp;
 
 typedef enum {
@@ -552,6 +553,10 @@ typedef struct _NMDevicePrivate {
     guint32           ip6_mtu_initial;
     NMDeviceMtuSource mtu_source;
 
+    /* Platform sysctl counters when the activation started (state PREPARE). */
+    guint64 activation_sysctl_n_get;
+    guint64 activation_sysctl_n_set;
+
     guint32 v4_route_table;
     guint32 v6_route_table;
 
@@ -4810,6 +4815,9 @@ _set_ifindex(NMDevice *self, int ifindex, gboolean is_ip_ifindex)
 
     *p_ifindex = ifindex;
 
+    if (!is_ip_ifindex && priv->manager)
+        nm_manager_update_device_ifindex(priv->manager, self);
+
     ip_ifindex_new = nm_device_get_ip_ifindex(self);
 
     if (priv->l3cfg) {
@@ -7828,6 +7836,7 @@ sriov_op_start(NMDevice *self, SriovOp *op)
 
     op->cancellable     = g_cancellable_new();
     op->device          = g_object_ref(self);
+    op->start_msec      = nm_utils_get_monotonic_timestamp_msec();
     priv->sriov.pending = op;
 
     nm_platform_link_set_sriov_params_async(nm_device_get_platform(self),
@@ -7849,6 +7858,13 @@ sriov_op_cb(GError *error, gpointer user_data)
 
     g_clear_object(&op->cancellable);
 
+    if (!error) {
+        _LOGD(LOGD_DEVICE,
+              "sriov: setting parameters for %u VFs took %" G_GINT64_FORMAT " msec",
+              op->sriov_params.num_vfs,
+              nm_utils_get_monotonic_timestamp_msec() - op->start_msec);
+    }
+
     if (op->callback)
         op->callback(error, op->callback_data);
 
@@ -10067,9 +10083,13 @@ sriov_params_cb(GError *error, gpointer user_data)
         return;
     }
 
-    if (!nm_platform_link_set_sriov_vfs(nm_device_get_platform(self),
-                                        priv->ifindex,
-                                        (const NMPlatformVF *const *) plat_vfs)) {
+    /* All VFs are configured with a single RTM_NEWLINK message. Skip it if
+     * the profile has no per-VF settings, as the request (and the link refresh
+     * that follows it) gets expensive for a PF with many VFs. */
+    if (plat_vfs[0]
+        && !nm_platform_link_set_sriov_vfs(nm_device_get_platform(self),
+                                           priv->ifindex,
+                                           (const NMPlatformVF *const *) plat_vfs)) {
         _LOGW(LOGD_DEVICE, "failed to apply SR-IOV VF configurations");
     }
 
@@ -16926,6 +16946,9 @@ _set_state_full(NMDevice *self, NMDeviceState state, NMDeviceStateReason reason,
         }
         break;
     case NM_DEVICE_STATE_PREPARE:
+        nm_platform_sysctl_get_stats(nm_device_get_platform(self),
+                                     &priv->activation_sysctl_n_get,
+                                     &priv->activation_sysctl_n_set);
         nm_device_update_initial_hw_address(self);
         break;
     case NM_DEVICE_STATE_NEED_AUTH:
@@ -17028,6 +17051,19 @@ _set_state_full(NMDevice *self, NMDeviceState state, NMDeviceStateReason reason,
         break;
     case NM_DEVICE_STATE_ACTIVATED:
         _LOGI(LOGD_DEVICE, "Activation: successful, device activated.");
+        if (_LOGD_ENABLED(LOGD_DEVICE)) {
+            guint64 n_get;
+            guint64 n_set;
+
+            /* The counters are per platform instance, so they also include
+             * accesses by other devices that activate at the same time. */
+            nm_platform_sysctl_get_stats(nm_device_get_platform(self), &n_get, &n_set);
+            _LOGD(LOGD_DEVICE,
+                  "Activation: %" G_GUINT64_FORMAT " sysctl reads and %" G_GUINT64_FORMAT
+                  " sysctl writes since preparing",
+                  n_get - priv->activation_sysctl_n_get,
+                  n_set - priv->activation_sysctl_n_set);
+        }
         nm_device_update_metered(self);
         nm_dispatcher_call_device(NM_DISPATCHER_ACTION_UP, self, req, NULL, NULL, NULL);
         _pacrunner_manager_add(self);
@@ -145,6 +145,9 @@ struct _NMDevice {
     CList                    devices_lst;
     CList                    devcon_dev_lst_head;
 
+    /* The ifindex under which NMManager indexes the device, or zero. */
+    int devices_by_ifindex_key;
+
     CList    policy_auto_activate_lst;
     GSource *policy_auto_activate_idle_source;
 };
@@ -273,6 +273,17 @@ _dbus_manager_init(NMConfig *config)
     }
 
     nm_assert(c_a_q_type == NM_CONFIG_CONFIGURE_AND_QUIT_DISABLED);
+
+    nm_dbus_manager_set_properties_changed_delay(
+        busmgr,
+        nm_config_data_get_value_int64(nm_config_get_data_orig(config),
+                                       NM_CONFIG_KEYFILE_GROUP_MAIN,
+                                       NM_CONFIG_KEYFILE_KEY_MAIN_DBUS_PROPERTIES_DELAY,
+                                       10,
+                                       0,
+                                       1000,
+                                       0));
+
     return nm_dbus_manager_setup(busmgr);
 }
 
@@ -473,7 +484,7 @@ main(int argc, char *argv[])
     if (!_dbus_manager_init(config))
         goto done_no_manager;
 
-    nm_linux_platform_setup();
+    nm_linux_platform_setup_with_tc_cache();
 
     NM_UTILS_KEEP_ALIVE(config, nm_netns_get(), "NMConfig-depends-on-NMNetns");
 
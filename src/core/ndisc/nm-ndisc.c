@@ -37,6 +37,15 @@
 
 /*****************************************************************************/
 
+typedef enum {
+    EXPIRY_LIST_GATEWAYS,
+    EXPIRY_LIST_ADDRESSES,
+    EXPIRY_LIST_ROUTES,
+    EXPIRY_LIST_DNS_SERVERS,
+    EXPIRY_LIST_DNS_DOMAINS,
+    _EXPIRY_LIST_NUM,
+} ExpiryList;
+
 struct _NMNDiscPrivate {
     /* this *must* be the first field. */
     NMNDiscDataInternal rdata;
@@ -58,6 +67,16 @@ struct _NMNDiscPrivate {
 
     GSource *timeout_expire_source;
 
+    /* For each list in rdata, a lower bound for the earliest expiry of its
+     * items. Only lists whose bound is already reached get walked when the
+     * expiry timer fires, and the timer itself is rescheduled from these
+     * values without looking at the items. */
+    gint64 expiry_next_msec[_EXPIRY_LIST_NUM];
+
+    /* Bitmask of ExpiryList for which expiry_next_msec is only a lower bound.
+     * For the other lists it is the exact earliest expiry. */
+    guint expiry_next_inexact;
+
     NMUtilsIPv6IfaceId iid;
     gboolean           iid_is_token;
 
@@ -280,6 +299,115 @@ _get_exp(char *buf, gsize buf_size, gint64 now_msec, gint64 expiry_time)
 #define get_exp(buf, now_msec, item) \
     _get_exp((buf), G_N_ELEMENTS(buf), (now_msec), (item)->expiry_msec)
 
+/* Update the bound of @list after an item changed its expiry from
+ * @old_expiry_msec to @new_expiry_msec. For new items, pass
+ * NM_NDISC_EXPIRY_INFINITY as @old_expiry_msec, for removed items as
+ * @new_expiry_msec. */
+static void
+_expiry_track(NMNDisc *ndisc, ExpiryList list, gint64 old_expiry_msec, gint64 new_expiry_msec)
+{
+    NMNDiscPrivate *priv = NM_NDISC_GET_PRIVATE(ndisc);
+
+    nm_assert(list >= 0 && list < _EXPIRY_LIST_NUM);
+
+    if (new_expiry_msec <= priv->expiry_next_msec[list])
+        priv->expiry_next_msec[list] = new_expiry_msec;
+    else if (old_expiry_msec == priv->expiry_next_msec[list]) {
+        /* The item might have been the earliest one. The bound is still
+         * valid, but no longer exact. */
+        priv->expiry_next_inexact |= (1u << list);
+    }
+}
+
+static void
+_expiry_set(NMNDiscPrivate *priv, ExpiryList list, gint64 expiry_msec)
+{
+    priv->expiry_next_msec[list] = expiry_msec;
+    priv->expiry_next_inexact &= ~(1u << list);
+}
+
+static gboolean
+_expiry_list_due(NMNDiscPrivate *priv, ExpiryList list, guint len, gint64 now_msec)
+{
+    if (len == 0) {
+        _expiry_set(priv, list, NM_NDISC_EXPIRY_INFINITY);
+        return FALSE;
+    }
+
+    return priv->expiry_next_msec[list] <= now_msec;
+}
+
+static void
+_expiry_reset(NMNDiscPrivate *priv)
+{
+    guint i;
+
+    for (i = 0; i < _EXPIRY_LIST_NUM; i++)
+        _expiry_set(priv, i, NM_NDISC_EXPIRY_INFINITY);
+}
+
+static GArray *
+_expiry_list_get_array(NMNDiscDataInternal *rdata, ExpiryList list)
+{
+    switch (list) {
+    case EXPIRY_LIST_GATEWAYS:
+        return rdata->gateways;
+    case EXPIRY_LIST_ADDRESSES:
+        return rdata->addresses;
+    case EXPIRY_LIST_ROUTES:
+        return rdata->routes;
+    case EXPIRY_LIST_DNS_SERVERS:
+        return rdata->dns_servers;
+    case EXPIRY_LIST_DNS_DOMAINS:
+        return rdata->dns_domains;
+    case _EXPIRY_LIST_NUM:
+        break;
+    }
+    return nm_assert_unreachable_val(NULL);
+}
+
+static gint64
+_expiry_list_get_item(GArray *array, ExpiryList list, guint idx)
+{
+    switch (list) {
+    case EXPIRY_LIST_GATEWAYS:
+        return nm_g_array_index(array, NMNDiscGateway, idx).expiry_msec;
+    case EXPIRY_LIST_ADDRESSES:
+        return nm_g_array_index(array, NMNDiscAddress, idx).expiry_msec;
+    case EXPIRY_LIST_ROUTES:
+        return nm_g_array_index(array, NMNDiscRoute, idx).expiry_msec;
+    case EXPIRY_LIST_DNS_SERVERS:
+        return nm_g_array_index(array, NMNDiscDNSServer, idx).expiry_msec;
+    case EXPIRY_LIST_DNS_DOMAINS:
+        return nm_g_array_index(array, NMNDiscDNSDomain, idx).expiry_msec;
+    case _EXPIRY_LIST_NUM:
+        break;
+    }
+    return nm_assert_unreachable_val(NM_NDISC_EXPIRY_INFINITY);
+}
+
+/* Returns the exact earliest expiry of @list. Only lists whose items changed
+ * since the last walk need to be scanned. */
+static gint64
+_expiry_list_get_next(NMNDisc *ndisc, ExpiryList list)
+{
+    NMNDiscPrivate *priv = NM_NDISC_GET_PRIVATE(ndisc);
+    GArray         *array;
+    gint64          expiry_msec;
+    guint           i;
+
+    if (!NM_FLAGS_ANY(priv->expiry_next_inexact, (1u << list)))
+        return priv->expiry_next_msec[list];
+
+    array       = _expiry_list_get_array(&priv->rdata, list);
+    expiry_msec = NM_NDISC_EXPIRY_INFINITY;
+    for (i = 0; i < array->len; i++)
+        expiry_msec = NM_MIN(expiry_msec, _expiry_list_get_item(array, list, i));
+
+    _expiry_set(priv, list, expiry_msec);
+    return expiry_msec;
+}
+
 /*****************************************************************************/
 
 NMPNetns *
@@ -463,12 +591,20 @@ nm_ndisc_add_gateway(NMNDisc *ndisc, const NMNDiscGateway *new_item, gint64 now_
 
         if (IN6_ARE_ADDR_EQUAL(&item->address, &new_item->address)) {
             if (new_item->expiry_msec <= now_msec) {
+                _expiry_track(ndisc,
+                              EXPIRY_LIST_GATEWAYS,
+                              item->expiry_msec,
+                              NM_NDISC_EXPIRY_INFINITY);
                 g_array_remove_index(rdata->gateways, i);
                 _ASSERT_data_gateways(rdata);
                 return TRUE;
             }
 
             if (item->preference != new_item->preference) {
+                _expiry_track(ndisc,
+                              EXPIRY_LIST_GATEWAYS,
+                              item->expiry_msec,
+                              NM_NDISC_EXPIRY_INFINITY);
                 g_array_remove_index(rdata->gateways, i);
                 continue;
             }
@@ -476,6 +612,7 @@ nm_ndisc_add_gateway(NMNDisc *ndisc, const NMNDiscGateway *new_item, gint64 now_
             if (item->expiry_msec == new_item->expiry_msec)
                 return FALSE;
 
+            _expiry_track(ndisc, EXPIRY_LIST_GATEWAYS, item->expiry_msec, new_item->expiry_msec);
             item->expiry_msec = new_item->expiry_msec;
             _ASSERT_data_gateways(rdata);
             return TRUE;
@@ -499,6 +636,7 @@ nm_ndisc_add_gateway(NMNDisc *ndisc, const NMNDiscGateway *new_item, gint64 now_
     g_array_insert_val(rdata->gateways,
                        insert_idx == G_MAXUINT ? rdata->gateways->len : insert_idx,
                        *new_item);
+    _expiry_track(ndisc, EXPIRY_LIST_GATEWAYS, NM_NDISC_EXPIRY_INFINITY, new_item->expiry_msec);
     _ASSERT_data_gateways(rdata);
     return TRUE;
 }
@@ -631,6 +769,10 @@ nm_ndisc_add_address(NMNDisc              *ndisc,
             new_expiry_preferred_msec = NM_MIN(new_expiry_preferred_msec, new_expiry_msec);
         } else {
             if (new_item->expiry_msec <= now_msec) {
+                _expiry_track(ndisc,
+                              EXPIRY_LIST_ADDRESSES,
+                              existing->expiry_msec,
+                              NM_NDISC_EXPIRY_INFINITY);
                 g_array_remove_index(rdata->addresses, i);
                 return TRUE;
             }
@@ -646,6 +788,7 @@ nm_ndisc_add_address(NMNDisc              *ndisc,
             return FALSE;
         }
 
+        _expiry_track(ndisc, EXPIRY_LIST_ADDRESSES, existing->expiry_msec, new_expiry_msec);
         existing->expiry_msec           = new_expiry_msec;
         existing->expiry_preferred_msec = new_expiry_preferred_msec;
         return TRUE;
@@ -675,6 +818,7 @@ nm_ndisc_add_address(NMNDisc              *ndisc,
         }
     }
 
+    _expiry_track(ndisc, EXPIRY_LIST_ADDRESSES, NM_NDISC_EXPIRY_INFINITY, new2->expiry_msec);
     return TRUE;
 }
 
@@ -723,11 +867,19 @@ nm_ndisc_add_route(NMNDisc *ndisc, const NMNDiscRoute *new_item, gint64 now_msec
             && IN6_ARE_ADDR_EQUAL(&item->gateway, &new_item->gateway)
             && item->on_link == new_item->on_link) {
             if (new_item->expiry_msec <= now_msec) {
+                _expiry_track(ndisc,
+                              EXPIRY_LIST_ROUTES,
+                              item->expiry_msec,
+                              NM_NDISC_EXPIRY_INFINITY);
                 g_array_remove_index(rdata->routes, i);
                 return TRUE;
             }
 
             if (item->preference != new_item->preference) {
+                _expiry_track(ndisc,
+                              EXPIRY_LIST_ROUTES,
+                              item->expiry_msec,
+                              NM_NDISC_EXPIRY_INFINITY);
                 g_array_remove_index(rdata->routes, i);
                 changed = TRUE;
                 continue;
@@ -737,6 +889,7 @@ nm_ndisc_add_route(NMNDisc *ndisc, const NMNDiscRoute *new_item, gint64 now_msec
                 && IN6_ARE_ADDR_EQUAL(&item->gateway, &new_item->gateway))
                 return FALSE;
 
+            _expiry_track(ndisc, EXPIRY_LIST_ROUTES, item->expiry_msec, new_item->expiry_msec);
             item->expiry_msec = new_item->expiry_msec;
             item->gateway     = new_item->gateway;
             return TRUE;
@@ -760,6 +913,7 @@ nm_ndisc_add_route(NMNDisc *ndisc, const NMNDiscRoute *new_item, gint64 now_msec
     }
 
     g_array_insert_val(rdata->routes, insert_idx == G_MAXUINT ? 0u : insert_idx, *new_item);
+    _expiry_track(ndisc, EXPIRY_LIST_ROUTES, NM_NDISC_EXPIRY_INFINITY, new_item->expiry_msec);
     return TRUE;
 }
 
@@ -778,6 +932,10 @@ nm_ndisc_add_dns_server(NMNDisc *ndisc, const NMNDiscDNSServer *new_item, gint64
 
         if (IN6_ARE_ADDR_EQUAL(&item->address, &new_item->address)) {
             if (new_item->expiry_msec <= now_msec) {
+                _expiry_track(ndisc,
+                              EXPIRY_LIST_DNS_SERVERS,
+                              item->expiry_msec,
+                              NM_NDISC_EXPIRY_INFINITY);
                 g_array_remove_index(rdata->dns_servers, i);
                 return TRUE;
             }
@@ -785,6 +943,7 @@ nm_ndisc_add_dns_server(NMNDisc *ndisc, const NMNDiscDNSServer *new_item, gint64
             if (item->expiry_msec == new_item->expiry_msec)
                 return FALSE;
 
+            _expiry_track(ndisc, EXPIRY_LIST_DNS_SERVERS, item->expiry_msec, new_item->expiry_msec);
             item->expiry_msec = new_item->expiry_msec;
             return TRUE;
         }
@@ -797,6 +956,7 @@ nm_ndisc_add_dns_server(NMNDisc *ndisc, const NMNDiscDNSServer *new_item, gint64
         return FALSE;
 
     g_array_append_val(rdata->dns_servers, *new_item);
+    _expiry_track(ndisc, EXPIRY_LIST_DNS_SERVERS, NM_NDISC_EXPIRY_INFINITY, new_item->expiry_msec);
     return TRUE;
 }
 
@@ -817,6 +977,10 @@ nm_ndisc_add_dns_domain(NMNDisc *ndisc, const NMNDiscDNSDomain *new_item, gint64
 
         if (nm_streq(item->domain, new_item->domain)) {
             if (new_item->expiry_msec <= now_msec) {
+                _expiry_track(ndisc,
+                              EXPIRY_LIST_DNS_DOMAINS,
+                              item->expiry_msec,
+                              NM_NDISC_EXPIRY_INFINITY);
                 g_array_remove_index(rdata->dns_domains, i);
                 return TRUE;
             }
@@ -824,6 +988,7 @@ nm_ndisc_add_dns_domain(NMNDisc *ndisc, const NMNDiscDNSDomain *new_item, gint64
             if (item->expiry_msec == new_item->expiry_msec)
                 return FALSE;
 
+            _expiry_track(ndisc, EXPIRY_LIST_DNS_DOMAINS, item->expiry_msec, new_item->expiry_msec);
             item->expiry_msec = new_item->expiry_msec;
             return TRUE;
         }
@@ -840,6 +1005,7 @@ nm_ndisc_add_dns_domain(NMNDisc *ndisc, const NMNDiscDNSDomain *new_item, gint64
         .domain      = g_strdup(new_item->domain),
         .expiry_msec = new_item->expiry_msec,
     };
+    _expiry_track(ndisc, EXPIRY_LIST_DNS_DOMAINS, NM_NDISC_EXPIRY_INFINITY, item->expiry_msec);
     return TRUE;
 }
 
@@ -1181,6 +1347,7 @@ nm_ndisc_set_iid(NMNDisc *ndisc, const NMUtilsIPv6IfaceId iid, gboolean is_token
         if (rdata->addresses->len) {
             _LOGD("IPv6 interface identifier changed, flushing addresses");
             g_array_remove_range(rdata->addresses, 0, rdata->addresses->len);
+            _expiry_set(priv, EXPIRY_LIST_ADDRESSES, NM_NDISC_EXPIRY_INFINITY);
             nm_ndisc_emit_config_change(ndisc, NM_NDISC_CONFIG_ADDRESSES);
             solicit_timer_start(ndisc);
         }
@@ -1276,6 +1443,7 @@ nm_ndisc_stop(NMNDisc *ndisc)
     g_array_set_size(rdata->dns_servers, 0);
     g_array_set_size(rdata->dns_domains, 0);
     priv->rdata.public.hop_limit = 64;
+    _expiry_reset(priv);
 
     nm_clear_g_source_inst(&priv->ra_timeout_source);
     nm_clear_g_source(&priv->send_ra_id);
@@ -1312,6 +1480,10 @@ nm_ndisc_dad_failed(NMNDisc *ndisc, GArray *addresses, gboolean emit_changed_sig
                 changed = TRUE;
 
                 if (!complete_address(ndisc, item)) {
+                    _expiry_track(ndisc,
+                                  EXPIRY_LIST_ADDRESSES,
+                                  item->expiry_msec,
+                                  NM_NDISC_EXPIRY_INFINITY);
                     g_array_remove_index(rdata->addresses, j);
                     continue;
                 }
@@ -1435,176 +1607,199 @@ _array_set_size_max(GArray *array, guint size_max)
 }
 
 static void
-clean_gateways(NMNDisc *ndisc, gint64 now_msec, NMNDiscConfigMap *changed, gint64 *next_msec)
+clean_gateways(NMNDisc *ndisc, gint64 now_msec, NMNDiscConfigMap *changed)
 {
-    NMNDiscDataInternal *rdata = &NM_NDISC_GET_PRIVATE(ndisc)->rdata;
-    NMNDiscGateway      *arr;
-    guint                i;
-    guint                j;
+    NMNDiscPrivate      *priv  = NM_NDISC_GET_PRIVATE(ndisc);
+    NMNDiscDataInternal *rdata = &priv->rdata;
 
-    if (rdata->gateways->len == 0)
-        return;
+    if (_expiry_list_due(priv, EXPIRY_LIST_GATEWAYS, rdata->gateways->len, now_msec)) {
+        NMNDiscGateway *arr       = &nm_g_array_first(rdata->gateways, NMNDiscGateway);
+        gint64          next_msec = NM_NDISC_EXPIRY_INFINITY;
+        guint           i;
+        guint           j;
 
-    arr = &nm_g_array_first(rdata->gateways, NMNDiscGateway);
+        for (i = 0, j = 0; i < rdata->gateways->len; i++) {
+            if (!expiry_next(now_msec, arr[i].expiry_msec, &next_msec))
+                continue;
+            if (i != j)
+                arr[j] = arr[i];
+            j++;
+        }
 
-    for (i = 0, j = 0; i < rdata->gateways->len; i++) {
-        if (!expiry_next(now_msec, arr[i].expiry_msec, next_msec))
-            continue;
-        if (i != j)
-            arr[j] = arr[i];
-        j++;
-    }
+        if (i != j) {
+            *changed |= NM_NDISC_CONFIG_GATEWAYS;
+            g_array_set_size(rdata->gateways, j);
+        }
 
-    if (i != j) {
-        *changed |= NM_NDISC_CONFIG_GATEWAYS;
-        g_array_set_size(rdata->gateways, j);
+        _expiry_set(priv, EXPIRY_LIST_GATEWAYS, next_msec);
     }
 
-    if (_array_set_size_max(rdata->gateways, _SIZE_MAX_GATEWAYS))
+    if (_array_set_size_max(rdata->gateways, _SIZE_MAX_GATEWAYS)) {
+        priv->expiry_next_inexact |= (1u << EXPIRY_LIST_GATEWAYS);
         *changed |= NM_NDISC_CONFIG_GATEWAYS;
+    }
 
     _ASSERT_data_gateways(rdata);
 }
 
 static void
-clean_addresses(NMNDisc *ndisc, gint64 now_msec, NMNDiscConfigMap *changed, gint64 *next_msec)
+clean_addresses(NMNDisc *ndisc, gint64 now_msec, NMNDiscConfigMap *changed)
 {
     NMNDiscPrivate      *priv  = NM_NDISC_GET_PRIVATE(ndisc);
-    NMNDiscDataInternal *rdata = &NM_NDISC_GET_PRIVATE(ndisc)->rdata;
-    NMNDiscAddress      *arr;
-    guint                i;
-    guint                j;
+    NMNDiscDataInternal *rdata = &priv->rdata;
 
-    if (rdata->addresses->len == 0)
-        return;
+    if (_expiry_list_due(priv, EXPIRY_LIST_ADDRESSES, rdata->addresses->len, now_msec)) {
+        NMNDiscAddress *arr       = &nm_g_array_first(rdata->addresses, NMNDiscAddress);
+        gint64          next_msec = NM_NDISC_EXPIRY_INFINITY;
+        guint           i;
+        guint           j;
 
-    arr = &nm_g_array_first(rdata->addresses, NMNDiscAddress);
+        for (i = 0, j = 0; i < rdata->addresses->len; i++) {
+            if (!expiry_next(now_msec, arr[i].expiry_msec, &next_msec))
+                continue;
+            if (i != j)
+                arr[j] = arr[i];
+            j++;
+        }
 
-    for (i = 0, j = 0; i < rdata->addresses->len; i++) {
-        if (!expiry_next(now_msec, arr[i].expiry_msec, next_msec))
-            continue;
-        if (i != j)
-            arr[j] = arr[i];
-        j++;
-    }
+        if (i != j) {
+            *changed |= NM_NDISC_CONFIG_ADDRESSES;
+            g_array_set_size(rdata->addresses, j);
+        }
 
-    if (i != j) {
-        *changed = NM_NDISC_CONFIG_ADDRESSES;
-        g_array_set_size(rdata->addresses, j);
+        _expiry_set(priv, EXPIRY_LIST_ADDRESSES, next_msec);
     }
 
-    if (_array_set_size_max(rdata->gateways, priv->config.max_addresses))
+    if (_array_set_size_max(rdata->addresses, priv->config.max_addresses)) {
+        priv->expiry_next_inexact |= (1u << EXPIRY_LIST_ADDRESSES);
         *changed |= NM_NDISC_CONFIG_ADDRESSES;
+    }
 }
 
 static void
-clean_routes(NMNDisc *ndisc, gint64 now_msec, NMNDiscConfigMap *changed, gint64 *next_msec)
+clean_routes(NMNDisc *ndisc, gint64 now_msec, NMNDiscConfigMap *changed)
 {
-    NMNDiscDataInternal *rdata = &NM_NDISC_GET_PRIVATE(ndisc)->rdata;
-    NMNDiscRoute        *arr;
-    guint                i;
-    guint                j;
+    NMNDiscPrivate      *priv  = NM_NDISC_GET_PRIVATE(ndisc);
+    NMNDiscDataInternal *rdata = &priv->rdata;
 
-    if (rdata->routes->len == 0)
-        return;
+    if (_expiry_list_due(priv, EXPIRY_LIST_ROUTES, rdata->routes->len, now_msec)) {
+        NMNDiscRoute *arr       = &nm_g_array_first(rdata->routes, NMNDiscRoute);
+        gint64        next_msec = NM_NDISC_EXPIRY_INFINITY;
+        guint         i;
+        guint         j;
 
-    arr = &nm_g_array_first(rdata->routes, NMNDiscRoute);
+        for (i = 0, j = 0; i < rdata->routes->len; i++) {
+            if (!expiry_next(now_msec, arr[i].expiry_msec, &next_msec))
+                continue;
+            if (i != j)
+                arr[j] = arr[i];
+            j++;
+        }
 
-    for (i = 0, j = 0; i < rdata->routes->len; i++) {
-        if (!expiry_next(now_msec, arr[i].expiry_msec, next_msec))
-            continue;
-        if (i != j)
-            arr[j] = arr[i];
-        j++;
-    }
+        if (i != j) {
+            *changed |= NM_NDISC_CONFIG_ROUTES;
+            g_array_set_size(rdata->routes, j);
+        }
 
-    if (i != j) {
-        *changed |= NM_NDISC_CONFIG_ROUTES;
-        g_array_set_size(rdata->routes, j);
+        _expiry_set(priv, EXPIRY_LIST_ROUTES, next_msec);
     }
 
-    if (_array_set_size_max(rdata->gateways, _SIZE_MAX_ROUTES))
+    if (_array_set_size_max(rdata->routes, _SIZE_MAX_ROUTES)) {
+        priv->expiry_next_inexact |= (1u << EXPIRY_LIST_ROUTES);
         *changed |= NM_NDISC_CONFIG_ROUTES;
+    }
 }
 
 static void
-clean_dns_servers(NMNDisc *ndisc, gint64 now_msec, NMNDiscConfigMap *changed, gint64 *next_msec)
+clean_dns_servers(NMNDisc *ndisc, gint64 now_msec, NMNDiscConfigMap *changed)
 {
-    NMNDiscDataInternal *rdata = &NM_NDISC_GET_PRIVATE(ndisc)->rdata;
-    NMNDiscDNSServer    *arr;
-    guint                i;
-    guint                j;
+    NMNDiscPrivate      *priv  = NM_NDISC_GET_PRIVATE(ndisc);
+    NMNDiscDataInternal *rdata = &priv->rdata;
 
-    if (rdata->dns_servers->len == 0)
-        return;
+    if (_expiry_list_due(priv, EXPIRY_LIST_DNS_SERVERS, rdata->dns_servers->len, now_msec)) {
+        NMNDiscDNSServer *arr       = &nm_g_array_first(rdata->dns_servers, NMNDiscDNSServer);
+        gint64            next_msec = NM_NDISC_EXPIRY_INFINITY;
+        guint             i;
+        guint             j;
 
-    arr = &nm_g_array_first(rdata->dns_servers, NMNDiscDNSServer);
+        for (i = 0, j = 0; i < rdata->dns_servers->len; i++) {
+            if (!expiry_next(now_msec, arr[i].expiry_msec, &next_msec))
+                continue;
+            if (i != j)
+                arr[j] = arr[i];
+            j++;
+        }
 
-    for (i = 0, j = 0; i < rdata->dns_servers->len; i++) {
-        if (!expiry_next(now_msec, arr[i].expiry_msec, next_msec))
-            continue;
-        if (i != j)
-            arr[j] = arr[i];
-        j++;
-    }
+        if (i != j) {
+            *changed |= NM_NDISC_CONFIG_DNS_SERVERS;
+            g_array_set_size(rdata->dns_servers, j);
+        }
 
-    if (i != j) {
-        *changed |= NM_NDISC_CONFIG_DNS_SERVERS;
-        g_array_set_size(rdata->dns_servers, j);
+        _expiry_set(priv, EXPIRY_LIST_DNS_SERVERS, next_msec);
     }
 
-    if (_array_set_size_max(rdata->gateways, _SIZE_MAX_DNS_SERVERS))
+    if (_array_set_size_max(rdata->dns_servers, _SIZE_MAX_DNS_SERVERS)) {
+        priv->expiry_next_inexact |= (1u << EXPIRY_LIST_DNS_SERVERS);
         *changed |= NM_NDISC_CONFIG_DNS_SERVERS;
+    }
 }
 
 static void
-clean_dns_domains(NMNDisc *ndisc, gint64 now_msec, NMNDiscConfigMap *changed, gint64 *next_msec)
+clean_dns_domains(NMNDisc *ndisc, gint64 now_msec, NMNDiscConfigMap *changed)
 {
-    NMNDiscDataInternal *rdata = &NM_NDISC_GET_PRIVATE(ndisc)->rdata;
-    NMNDiscDNSDomain    *arr;
-    guint                i;
-    guint                j;
+    NMNDiscPrivate      *priv  = NM_NDISC_GET_PRIVATE(ndisc);
+    NMNDiscDataInternal *rdata = &priv->rdata;
 
-    if (rdata->dns_domains->len == 0)
-        return;
+    if (_expiry_list_due(priv, EXPIRY_LIST_DNS_DOMAINS, rdata->dns_domains->len, now_msec)) {
+        NMNDiscDNSDomain *arr       = &nm_g_array_first(rdata->dns_domains, NMNDiscDNSDomain);
+        gint64            next_msec = NM_NDISC_EXPIRY_INFINITY;
+        guint             i;
+        guint             j;
 
-    arr = &nm_g_array_first(rdata->dns_domains, NMNDiscDNSDomain);
+        for (i = 0, j = 0; i < rdata->dns_domains->len; i++) {
+            if (!expiry_next(now_msec, arr[i].expiry_msec, &next_msec))
+                continue;
 
-    for (i = 0, j = 0; i < rdata->dns_domains->len; i++) {
-        if (!expiry_next(now_msec, arr[i].expiry_msec, next_msec))
-            continue;
+            if (i != j) {
+                g_free(arr[j].domain);
+                arr[j]        = arr[i];
+                arr[i].domain = NULL;
+            }
+
+            j++;
+        }
 
         if (i != j) {
-            g_free(arr[j].domain);
-            arr[j]        = arr[i];
-            arr[i].domain = NULL;
+            *changed |= NM_NDISC_CONFIG_DNS_DOMAINS;
+            g_array_set_size(rdata->dns_domains, j);
         }
 
-        j++;
+        _expiry_set(priv, EXPIRY_LIST_DNS_DOMAINS, next_msec);
     }
 
-    if (i != 0) {
+    if (_array_set_size_max(rdata->dns_domains, _SIZE_MAX_DNS_DOMAINS)) {
+        priv->expiry_next_inexact |= (1u << EXPIRY_LIST_DNS_DOMAINS);
         *changed |= NM_NDISC_CONFIG_DNS_DOMAINS;
-        g_array_set_size(rdata->dns_domains, j);
     }
-
-    if (_array_set_size_max(rdata->gateways, _SIZE_MAX_DNS_DOMAINS))
-        *changed |= NM_NDISC_CONFIG_DNS_DOMAINS;
 }
 
 static void
 check_timestamps(NMNDisc *ndisc, gint64 now_msec, NMNDiscConfigMap changed)
 {
     NMNDiscPrivate *priv      = NM_NDISC_GET_PRIVATE(ndisc);
-    gint64          next_msec = G_MAXINT64;
+    gint64          next_msec = NM_NDISC_EXPIRY_INFINITY;
+    guint           i;
 
     _LOGT("router-data: check for changed router advertisement data");
 
-    clean_gateways(ndisc, now_msec, &changed, &next_msec);
-    clean_addresses(ndisc, now_msec, &changed, &next_msec);
-    clean_routes(ndisc, now_msec, &changed, &next_msec);
-    clean_dns_servers(ndisc, now_msec, &changed, &next_msec);
-    clean_dns_domains(ndisc, now_msec, &changed, &next_msec);
+    clean_gateways(ndisc, now_msec, &changed);
+    clean_addresses(ndisc, now_msec, &changed);
+    clean_routes(ndisc, now_msec, &changed);
+    clean_dns_servers(ndisc, now_msec, &changed);
+    clean_dns_domains(ndisc, now_msec, &changed);
+
+    for (i = 0; i < _EXPIRY_LIST_NUM; i++)
+        next_msec = NM_MIN(next_msec, priv->expiry_next_msec[i]);
 
     nm_assert(next_msec > now_msec);
 
@@ -1671,41 +1866,31 @@ calc_pre_expiry_rs_msec(NMNDisc *ndisc)
     NMNDiscPrivate      *priv        = NM_NDISC_GET_PRIVATE(ndisc);
     NMNDiscDataInternal *rdata       = &priv->rdata;
     gint64               expiry_msec = NM_NDISC_EXPIRY_INFINITY;
+    ExpiryList           list;
     guint                i;
 
-    for (i = 0; i < rdata->gateways->len; i++) {
-        _calc_pre_expiry_rs_msec_worker(
-            &expiry_msec,
-            priv->last_rs_msec,
-            nm_g_array_index(rdata->gateways, NMNDiscGateway, i).expiry_msec);
-    }
-
-    for (i = 0; i < rdata->addresses->len; i++) {
-        _calc_pre_expiry_rs_msec_worker(
-            &expiry_msec,
-            priv->last_rs_msec,
-            nm_g_array_index(rdata->addresses, NMNDiscAddress, i).expiry_msec);
-    }
+    for (list = 0; list < _EXPIRY_LIST_NUM; list++) {
+        gint64  list_expiry_msec = _expiry_list_get_next(ndisc, list);
+        GArray *array;
 
-    for (i = 0; i < rdata->routes->len; i++) {
-        _calc_pre_expiry_rs_msec_worker(
-            &expiry_msec,
-            priv->last_rs_msec,
-            nm_g_array_index(rdata->routes, NMNDiscRoute, i).expiry_msec);
-    }
+        if (list_expiry_msec >= expiry_msec)
+            continue;
 
-    for (i = 0; i < rdata->dns_servers->len; i++) {
-        _calc_pre_expiry_rs_msec_worker(
-            &expiry_msec,
-            priv->last_rs_msec,
-            nm_g_array_index(rdata->dns_servers, NMNDiscDNSServer, i).expiry_msec);
-    }
+        if (list_expiry_msec >= priv->last_rs_msec + NM_NDISC_PRE_EXPIRY_MIN_LIFETIME_MSEC) {
+            /* The earliest item of the list qualifies, no need to look
+             * at the others. */
+            expiry_msec = list_expiry_msec;
+            continue;
+        }
 
-    for (i = 0; i < rdata->dns_domains->len; i++) {
-        _calc_pre_expiry_rs_msec_worker(
-            &expiry_msec,
-            priv->last_rs_msec,
-            nm_g_array_index(rdata->dns_domains, NMNDiscDNSDomain, i).expiry_msec);
+        /* The earliest item expires too soon after the last solicitation
+         * to be considered. Only in that case we need to walk the list. */
+        array = _expiry_list_get_array(rdata, list);
+        for (i = 0; i < array->len; i++) {
+            _calc_pre_expiry_rs_msec_worker(&expiry_msec,
+                                            priv->last_rs_msec,
+                                            _expiry_list_get_item(array, list, i));
+        }
     }
 
     return expiry_msec - solicit_retransmit_time_jitter(NM_NDISC_PRE_EXPIRY_TIME_MSEC);
@@ -1926,6 +2111,7 @@ nm_ndisc_init(NMNDisc *ndisc)
     rdata->dns_domains = g_array_new(FALSE, FALSE, sizeof(NMNDiscDNSDomain));
     g_array_set_clear_func(rdata->dns_domains, dns_domain_free);
     priv->rdata.public.hop_limit = 64;
+    _expiry_reset(priv);
 }
 
 static void
@@ -656,6 +656,83 @@ test_dns_solicit_loop(void)
 
 /*****************************************************************************/
 
+#define TEST_MANY_ROUTES_N 500u
+
+static void
+test_many_routes_changed(NMNDisc              *ndisc,
+                         const NMNDiscData    *rdata,
+                         guint                 changed_i,
+                         const NML3ConfigData *l3cd,
+                         TestData             *data)
+{
+    NMNDiscConfigMap changed = changed_i;
+    guint            i;
+
+    switch (data->counter++) {
+    case 0:
+        g_assert(NM_FLAGS_HAS(changed, NM_NDISC_CONFIG_ROUTES));
+        g_assert_cmpint(rdata->routes_n, ==, TEST_MANY_ROUTES_N);
+        g_assert(nm_fake_ndisc_done(NM_FAKE_NDISC(ndisc)));
+        break;
+    case 1:
+        /* Only the routes expired, nothing else is reported as changed. */
+        g_assert_cmpint(changed, ==, NM_NDISC_CONFIG_ROUTES);
+        g_assert_cmpint(rdata->routes_n, ==, TEST_MANY_ROUTES_N / 2);
+        for (i = 0; i < rdata->routes_n; i++)
+            g_assert_cmpint(rdata->routes[i].expiry_msec, ==, data->timestamp_msec_1 + 10000);
+        match_gateway(rdata,
+                      0,
+                      "fe80::1",
+                      data->timestamp_msec_1 + 10000,
+                      NM_ICMPV6_ROUTER_PREF_MEDIUM);
+        g_main_loop_quit(data->loop);
+        break;
+    default:
+        g_assert_not_reached();
+    }
+}
+
+static void
+test_many_routes(void)
+{
+    nm_auto_unref_gmainloop GMainLoop *loop     = g_main_loop_new(NULL, FALSE);
+    gs_unref_object NMFakeNDisc       *ndisc    = ndisc_new();
+    const gint64                       now_msec = nm_utils_get_monotonic_timestamp_msec();
+    TestData                           data     = {
+                                      .loop             = loop,
+                                      .timestamp_msec_1 = now_msec,
+    };
+    guint id;
+    guint i;
+
+    /* A large RA with many route information options, half of which expire
+     * early. The expiry timer must drop exactly those. */
+    id = nm_fake_ndisc_add_ra(ndisc, 1, NM_NDISC_DHCP_LEVEL_NONE, 4, 1500);
+    g_assert(id);
+    nm_fake_ndisc_add_gateway(ndisc, id, "fe80::1", now_msec + 10000, NM_ICMPV6_ROUTER_PREF_MEDIUM);
+    for (i = 0; i < TEST_MANY_ROUTES_N; i++) {
+        char network[NM_INET_ADDRSTRLEN];
+
+        nm_sprintf_buf(network, "2001:db8:%x::", i);
+        nm_fake_ndisc_add_prefix(ndisc,
+                                 id,
+                                 network,
+                                 48,
+                                 "fe80::1",
+                                 now_msec + ((i % 2) ? 10000 : 2000),
+                                 now_msec + ((i % 2) ? 10000 : 2000),
+                                 NM_ICMPV6_ROUTER_PREF_MEDIUM);
+    }
+
+    g_signal_connect(ndisc, NM_NDISC_CONFIG_RECEIVED, G_CALLBACK(test_many_routes_changed), &data);
+
+    nm_ndisc_start(NM_NDISC(ndisc));
+    nmtst_main_loop_run_assert(data.loop, 15000);
+    g_assert_cmpint(data.counter, ==, 2);
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE();
 
 int
@@ -676,6 +753,7 @@ main(int argc, char **argv)
     g_test_add_func("/ndisc/preference-order", test_preference_order);
     g_test_add_func("/ndisc/preference-changed", test_preference_changed);
     g_test_add_func("/ndisc/dns-solicit-loop", test_dns_solicit_loop);
+    g_test_add_func("/ndisc/many-routes", test_many_routes);
 
     return g_test_run();
 }
@@ -8,6 +8,7 @@
 #include "nm-auth-manager.h"
 
 #include "c-list/src/c-list.h"
+#include "libnm-glib-aux/nm-c-list.h"
 #include "libnm-glib-aux/nm-dbus-aux.h"
 #include "nm-errors.h"
 #include "libnm-core-intern/nm-core-internal.h"
@@ -21,6 +22,15 @@
 #define CANCELLATION_ID_PREFIX  "cancellation-id-"
 #define CANCELLATION_TIMEOUT_MS 5000
 
+/* Non-interactive decisions of polkit are cached for a while. The cache gets
+ * flushed when polkit notifies about changes and entries are dropped when the
+ * D-Bus client disconnects. */
+#define AUTH_CACHE_MAX_SIZE     64
+#define AUTH_CACHE_MAX_AGE_MSEC (60 * NM_UTILS_MSEC_PER_SEC)
+
+/* How often to log the hits and misses of the cache, if there were lookups. */
+#define AUTH_CACHE_SUMMARY_INTERVAL_SEC 300
+
 /*****************************************************************************/
 
 NM_GOBJECT_PROPERTIES_DEFINE_BASE(PROP_POLKIT_ENABLED, );
@@ -35,11 +45,25 @@ static guint signals[LAST_SIGNAL] = {0};
 typedef struct {
     CList            calls_lst_head;
     GDBusConnection *dbus_connection;
+    NMDBusManager   *dbus_mgr;
     GCancellable    *main_cancellable;
     char            *name_owner;
     guint64          call_numid_counter;
     guint            changed_id;
     guint            name_owner_changed_id;
+    gulong           sender_vanished_id;
+
+    struct {
+        GHashTable *idx;
+        CList       lru_lst_head;
+        GSource    *summary_source;
+        guint64     hits;
+        guint64     misses;
+        guint64     hits_reported;
+        guint64     misses_reported;
+        guint       generation;
+    } cache;
+
     bool             disposing : 1;
     bool             shutting_down : 1;
     bool             got_name_owner : 1;
@@ -125,28 +149,247 @@ nm_auth_manager_get_polkit_enabled(NMAuthManager *self)
 
 /*****************************************************************************/
 
+typedef enum {
+    POLKIT_CHECK_AUTHORIZATION_FLAGS_NONE                   = 0,
+    POLKIT_CHECK_AUTHORIZATION_FLAGS_ALLOW_USER_INTERACTION = (1 << 0),
+} PolkitCheckAuthorizationFlags;
+
+typedef struct {
+    CList                         lru_lst;
+    char                         *dbus_sender;
+    char                         *action_id;
+    gulong                        pid;
+    gulong                        uid;
+    guint64                       start_time;
+    gint64                        timestamp_msec;
+    PolkitCheckAuthorizationFlags flags;
+    bool                          is_authorized;
+} AuthCacheEntry;
+
+static guint
+_auth_cache_entry_hash(gconstpointer ptr)
+{
+    const AuthCacheEntry *entry = ptr;
+    NMHashState           h;
+
+    nm_hash_init(&h, 1529366283u);
+    nm_hash_update_vals(&h, entry->pid, entry->uid, entry->start_time, entry->flags);
+    nm_hash_update_str0(&h, entry->dbus_sender);
+    nm_hash_update_str0(&h, entry->action_id);
+    return nm_hash_complete(&h);
+}
+
+static gboolean
+_auth_cache_entry_equal(gconstpointer ptr_a, gconstpointer ptr_b)
+{
+    const AuthCacheEntry *a = ptr_a;
+    const AuthCacheEntry *b = ptr_b;
+
+    return a->pid == b->pid && a->uid == b->uid && a->start_time == b->start_time
+           && a->flags == b->flags && nm_streq0(a->dbus_sender, b->dbus_sender)
+           && nm_streq0(a->action_id, b->action_id);
+}
+
+static void
+_auth_cache_entry_free(AuthCacheEntry *entry)
+{
+    c_list_unlink_stale(&entry->lru_lst);
+    g_free(entry->dbus_sender);
+    g_free(entry->action_id);
+    nm_g_slice_free(entry);
+}
+
+static gboolean
+_auth_cache_subject_is_cacheable(NMAuthSubject *subject, PolkitCheckAuthorizationFlags flags)
+{
+    /* Only cache requests without user interaction. Also, we require a D-Bus
+     * sender, so that we can drop the entry once the client disconnects. */
+    return flags == POLKIT_CHECK_AUTHORIZATION_FLAGS_NONE
+           && nm_auth_subject_get_subject_type(subject) == NM_AUTH_SUBJECT_TYPE_UNIX_PROCESS
+           && nm_auth_subject_get_unix_process_dbus_sender(subject)
+           && nm_auth_subject_get_unix_process_start_time(subject) != 0;
+}
+
+static inline AuthCacheEntry
+_auth_cache_entry_init_lookup(NMAuthSubject                *subject,
+                              const char                   *action_id,
+                              PolkitCheckAuthorizationFlags flags)
+{
+    return (AuthCacheEntry){
+        .dbus_sender = (char *) nm_auth_subject_get_unix_process_dbus_sender(subject),
+        .action_id   = (char *) action_id,
+        .pid         = nm_auth_subject_get_unix_process_pid(subject),
+        .uid         = nm_auth_subject_get_unix_process_uid(subject),
+        .start_time  = nm_auth_subject_get_unix_process_start_time(subject),
+        .flags       = flags,
+    };
+}
+
+static void
+_auth_cache_flush(NMAuthManager *self, const char *reason)
+{
+    NMAuthManagerPrivate *priv = NM_AUTH_MANAGER_GET_PRIVATE(self);
+    guint                 n;
+
+    /* Requests that are currently in flight must not populate the cache
+     * with a result that might already be outdated. */
+    priv->cache.generation++;
+
+    n = priv->cache.idx ? g_hash_table_size(priv->cache.idx) : 0u;
+    if (n == 0)
+        return;
+
+    _LOGT("cache: flush %u entries (%s, hits %" G_GUINT64_FORMAT ", misses %" G_GUINT64_FORMAT
+          ")",
+          n,
+          reason,
+          priv->cache.hits,
+          priv->cache.misses);
+    g_hash_table_remove_all(priv->cache.idx);
+}
+
+static void
+_auth_cache_log_summary(NMAuthManager *self)
+{
+    NMAuthManagerPrivate *priv = NM_AUTH_MANAGER_GET_PRIVATE(self);
+
+    if (priv->cache.hits == priv->cache.hits_reported
+        && priv->cache.misses == priv->cache.misses_reported)
+        return;
+
+    _LOGD("cache: %u entries, hits %" G_GUINT64_FORMAT " (+%" G_GUINT64_FORMAT
+          "), misses %" G_GUINT64_FORMAT " (+%" G_GUINT64_FORMAT ")",
+          priv->cache.idx ? g_hash_table_size(priv->cache.idx) : 0u,
+          priv->cache.hits,
+          priv->cache.hits - priv->cache.hits_reported,
+          priv->cache.misses,
+          priv->cache.misses - priv->cache.misses_reported);
+
+    priv->cache.hits_reported   = priv->cache.hits;
+    priv->cache.misses_reported = priv->cache.misses;
+}
+
+static gboolean
+_auth_cache_summary_cb(gpointer user_data)
+{
+    NMAuthManager        *self = user_data;
+    NMAuthManagerPrivate *priv = NM_AUTH_MANAGER_GET_PRIVATE(self);
+
+    nm_clear_g_source_inst(&priv->cache.summary_source);
+    _auth_cache_log_summary(self);
+    return G_SOURCE_CONTINUE;
+}
+
+static const AuthCacheEntry *
+_auth_cache_lookup(NMAuthManager                *self,
+                   NMAuthSubject                *subject,
+                   const char                   *action_id,
+                   PolkitCheckAuthorizationFlags flags)
+{
+    NMAuthManagerPrivate *priv = NM_AUTH_MANAGER_GET_PRIVATE(self);
+    AuthCacheEntry        needle;
+    AuthCacheEntry       *entry;
+
+    /* Summarize the hits and misses at debug level, at most once per interval
+     * and only while there are lookups. */
+    if (!priv->cache.summary_source && _LOGD_ENABLED()) {
+        priv->cache.summary_source =
+            nm_g_timeout_add_seconds_source(AUTH_CACHE_SUMMARY_INTERVAL_SEC,
+                                            _auth_cache_summary_cb,
+                                            self);
+    }
+
+    needle = _auth_cache_entry_init_lookup(subject, action_id, flags);
+
+    entry = g_hash_table_lookup(priv->cache.idx, &needle);
+    if (entry
+        && entry->timestamp_msec + AUTH_CACHE_MAX_AGE_MSEC
+               <= nm_utils_get_monotonic_timestamp_msec()) {
+        g_hash_table_remove(priv->cache.idx, entry);
+        entry = NULL;
+    }
+
+    if (!entry) {
+        priv->cache.misses++;
+        return NULL;
+    }
+
+    priv->cache.hits++;
+    nm_c_list_move_front(&priv->cache.lru_lst_head, &entry->lru_lst);
+    return entry;
+}
+
+static void
+_auth_cache_add(NMAuthManager                *self,
+                NMAuthSubject                *subject,
+                const char                   *action_id,
+                PolkitCheckAuthorizationFlags flags,
+                gboolean                      is_authorized)
+{
+    NMAuthManagerPrivate *priv = NM_AUTH_MANAGER_GET_PRIVATE(self);
+    AuthCacheEntry       *entry;
+
+    entry  = g_slice_new(AuthCacheEntry);
+    *entry = _auth_cache_entry_init_lookup(subject, action_id, flags);
+    entry->dbus_sender    = g_strdup(entry->dbus_sender);
+    entry->action_id      = g_strdup(entry->action_id);
+    entry->timestamp_msec = nm_utils_get_monotonic_timestamp_msec();
+    entry->is_authorized  = is_authorized;
+    c_list_link_front(&priv->cache.lru_lst_head, &entry->lru_lst);
+
+    /* replaces (and frees) a previous entry with the same key. */
+    g_hash_table_add(priv->cache.idx, entry);
+
+    if (g_hash_table_size(priv->cache.idx) > AUTH_CACHE_MAX_SIZE) {
+        g_hash_table_remove(priv->cache.idx,
+                            c_list_last_entry(&priv->cache.lru_lst_head, AuthCacheEntry, lru_lst));
+    }
+}
+
 static void
 _emit_changed_signal(NMAuthManager *self)
 {
+    _auth_cache_flush(self, "polkit changed");
     g_signal_emit(self, signals[CHANGED_SIGNAL], 0);
 }
 
-typedef enum {
-    POLKIT_CHECK_AUTHORIZATION_FLAGS_NONE                   = 0,
-    POLKIT_CHECK_AUTHORIZATION_FLAGS_ALLOW_USER_INTERACTION = (1 << 0),
-} PolkitCheckAuthorizationFlags;
-
 struct _NMAuthManagerCallId {
     CList                                   calls_lst;
     NMAuthManager                          *self;
     GCancellable                           *dbus_cancellable;
     NMAuthManagerCheckAuthorizationCallback callback;
     gpointer                                user_data;
+    NMAuthSubject                          *cache_subject;
+    char                                   *cache_action_id;
     guint64                                 call_numid;
     guint                                   idle_id;
+    guint                                   cache_generation;
     bool                                    idle_is_authorized : 1;
 };
 
+static void
+_sender_vanished_cb(NMDBusManager *dbus_mgr, const char *sender, NMAuthManager *self)
+{
+    NMAuthManagerPrivate *priv = NM_AUTH_MANAGER_GET_PRIVATE(self);
+    NMAuthManagerCallId  *call_id;
+    AuthCacheEntry       *entry;
+    AuthCacheEntry       *entry_safe;
+
+    /* A pending request of this sender must not populate the cache once it
+     * completes, because no later signal would remove that entry. */
+    c_list_for_each_entry (call_id, &priv->calls_lst_head, calls_lst) {
+        if (call_id->cache_subject
+            && nm_streq0(nm_auth_subject_get_unix_process_dbus_sender(call_id->cache_subject),
+                         sender))
+            g_clear_object(&call_id->cache_subject);
+    }
+
+    c_list_for_each_entry_safe (entry, entry_safe, &priv->cache.lru_lst_head, lru_lst) {
+        if (nm_streq(entry->dbus_sender, sender))
+            g_hash_table_remove(priv->cache.idx, entry);
+    }
+}
+
 #define cancellation_id_to_str_a(call_numid)                     \
     nm_sprintf_bufa(NM_STRLEN(CANCELLATION_ID_PREFIX) + 60,      \
                     CANCELLATION_ID_PREFIX "%" G_GUINT64_FORMAT, \
@@ -165,6 +408,8 @@ _call_id_free(NMAuthManagerCallId *call_id)
         return;
     }
 
+    g_clear_object(&call_id->cache_subject);
+    nm_clear_g_free(&call_id->cache_action_id);
     g_object_unref(call_id->self);
     g_slice_free(NMAuthManagerCallId, call_id);
 }
@@ -260,6 +505,17 @@ _call_check_authorize_cb(GObject *proxy, GAsyncResult *res, gpointer user_data)
     if (!error) {
         g_variant_get(value, "((bb@a{ss}))", &is_authorized, &is_challenge, NULL);
         _LOG2T(call_id, "completed: authorized=%d, challenge=%d", is_authorized, is_challenge);
+
+        /* A challenge is not a definitive answer. The user might authenticate
+         * via an agent, so don't cache that. */
+        if (call_id->cache_subject && !is_challenge
+            && call_id->cache_generation == priv->cache.generation) {
+            _auth_cache_add(self,
+                            call_id->cache_subject,
+                            call_id->cache_action_id,
+                            POLKIT_CHECK_AUTHORIZATION_FLAGS_NONE,
+                            is_authorized);
+        }
     } else
         _LOG2T(call_id, "completed: failed: %s", error->message);
 
@@ -310,6 +566,7 @@ nm_auth_manager_check_authorization(NMAuthManager                          *self
     PolkitCheckAuthorizationFlags flags;
     char                          subject_buf[64];
     NMAuthManagerCallId          *call_id;
+    const AuthCacheEntry         *cache_entry;
 
     g_return_val_if_fail(NM_IS_AUTH_MANAGER(self), NULL);
     g_return_val_if_fail(NM_IN_SET(nm_auth_subject_get_subject_type(subject),
@@ -357,6 +614,15 @@ nm_auth_manager_check_authorization(NMAuthManager                          *self
                priv->auth_polkit_mode == NM_AUTH_POLKIT_MODE_ALLOW_ALL ? "grant" : "deny");
         call_id->idle_is_authorized = (priv->auth_polkit_mode == NM_AUTH_POLKIT_MODE_ALLOW_ALL);
         call_id->idle_id            = g_idle_add(_call_on_idle, call_id);
+    } else if (_auth_cache_subject_is_cacheable(subject, flags)
+               && (cache_entry = _auth_cache_lookup(self, subject, action_id, flags))) {
+        _LOG2T(call_id,
+               "CheckAuthorization(%s), subject=%s (cached: %s authorization)",
+               action_id,
+               nm_auth_subject_to_string(subject, subject_buf, sizeof(subject_buf)),
+               cache_entry->is_authorized ? "grant" : "deny");
+        call_id->idle_is_authorized = cache_entry->is_authorized;
+        call_id->idle_id            = g_idle_add(_call_on_idle, call_id);
     } else {
         GVariant       *parameters;
         GVariantBuilder builder;
@@ -384,6 +650,12 @@ nm_auth_manager_check_authorization(NMAuthManager                          *self
 
         call_id->dbus_cancellable = g_cancellable_new();
 
+        if (_auth_cache_subject_is_cacheable(subject, flags)) {
+            call_id->cache_subject    = g_object_ref(subject);
+            call_id->cache_action_id  = g_strdup(action_id);
+            call_id->cache_generation = priv->cache.generation;
+        }
+
         nm_assert(priv->main_cancellable);
 
         g_dbus_connection_call(priv->dbus_connection,
@@ -469,6 +741,7 @@ _name_owner_changed(NMAuthManager *self, const char *name_owner, gboolean is_ini
     if (is_changed) {
         old_name_owner   = g_steal_pointer(&priv->name_owner);
         priv->name_owner = g_strdup(name_owner);
+        _auth_cache_flush(self, "polkit name owner changed");
     } else {
         if (!is_initial)
             return;
@@ -601,6 +874,12 @@ nm_auth_manager_init(NMAuthManager *self)
     NMAuthManagerPrivate *priv = NM_AUTH_MANAGER_GET_PRIVATE(self);
 
     c_list_init(&priv->calls_lst_head);
+    c_list_init(&priv->cache.lru_lst_head);
+    priv->cache.idx = g_hash_table_new_full(_auth_cache_entry_hash,
+                                            _auth_cache_entry_equal,
+                                            (GDestroyNotify) _auth_cache_entry_free,
+                                            NULL);
+
     priv->auth_polkit_mode = NM_AUTH_POLKIT_MODE_ROOT_ONLY;
 }
 
@@ -653,6 +932,14 @@ constructed(GObject *object)
                                                           self,
                                                           NULL);
 
+    /* Reuse the NameOwnerChanged subscription of NMDBusManager to drop cache
+     * entries of disconnected clients. */
+    priv->dbus_mgr           = g_object_ref(nm_dbus_manager_get());
+    priv->sender_vanished_id = g_signal_connect(priv->dbus_mgr,
+                                                NM_DBUS_MANAGER_SENDER_VANISHED,
+                                                G_CALLBACK(_sender_vanished_cb),
+                                                self);
+
     nm_dbus_connection_call_get_name_owner(priv->dbus_connection,
                                            POLKIT_SERVICE,
                                            -1,
@@ -712,6 +999,14 @@ dispose(GObject *object)
 
     nm_clear_g_dbus_connection_signal(priv->dbus_connection, &priv->changed_id);
 
+    nm_clear_g_signal_handler(priv->dbus_mgr, &priv->sender_vanished_id);
+    g_clear_object(&priv->dbus_mgr);
+
+    nm_clear_g_source_inst(&priv->cache.summary_source);
+    _auth_cache_log_summary(self);
+    _auth_cache_flush(self, "dispose");
+    nm_clear_pointer(&priv->cache.idx, g_hash_table_destroy);
+
     G_OBJECT_CLASS(nm_auth_manager_parent_class)->dispose(object);
 
     g_clear_object(&priv->dbus_connection);
@@ -42,6 +42,11 @@ typedef struct {
     NMUnmanFlagOp      unmanaged_explicit;
     NMActivationReason activation_reason;
     gulong             dev_exported_change_id;
+
+    /* the number of parent and controller devices above this one, when creating
+     * the checkpoint. Used to roll back parents and controllers before their
+     * children and ports. */
+    guint rollback_depth;
 } DeviceCheckpoint;
 
 NM_GOBJECT_PROPERTIES_DEFINE(NMCheckpoint, PROP_DEVICES, PROP_CREATED, PROP_ROLLBACK_TIMEOUT, );
@@ -56,9 +61,17 @@ struct _NMCheckpointPrivate {
     /* private members */
     NMManager              *manager;
     NMCheckpointCreateFlags flags;
-    GHashTable             *connection_uuids;
     gulong                  dev_removed_id;
 
+    /* With NM_CHECKPOINT_CREATE_FLAG_DELETE_NEW_CONNECTIONS, we don't take a snapshot
+     * of all profiles. Instead, we track the profiles that got added and removed
+     * while the checkpoint exists. */
+    NMSettings *settings;
+    GHashTable *connection_uuids_added;
+    GHashTable *connection_uuids_removed;
+    gulong      connection_added_id;
+    gulong      connection_removed_id;
+
     NMCheckpointTimeoutCallback timeout_cb;
     gpointer                    timeout_data;
 
@@ -459,19 +472,120 @@ restore_and_activate_connection(NMCheckpoint *self, DeviceCheckpoint *dev_checkp
     return TRUE;
 }
 
+static guint32
+_rollback_device(NMCheckpoint *self, DeviceCheckpoint *dev_checkpoint)
+{
+    NMDevice *device = dev_checkpoint->device;
+    guint32   result = NM_ROLLBACK_RESULT_OK;
+
+    _LOGD("rollback: restoring device %s (state %d, realized %d, explicitly unmanaged %d, "
+          "connection-unsaved %d, connection-shadowed %d, connection-shadowed-owned %d)",
+          dev_checkpoint->original_dev_name,
+          (int) dev_checkpoint->state,
+          dev_checkpoint->realized,
+          dev_checkpoint->unmanaged_explicit,
+          dev_checkpoint->settings_connection_is_unsaved,
+          !!dev_checkpoint->settings_connection_shadowed,
+          dev_checkpoint->settings_connection_is_shadowed_owned);
+
+    if (nm_device_is_real(device)) {
+        if (!dev_checkpoint->realized) {
+            _LOGD("rollback: device was not realized, unmanage it");
+            nm_device_set_unmanaged_by_flags_queue(device,
+                                                   NM_UNMANAGED_USER_EXPLICIT,
+                                                   NM_UNMAN_FLAG_OP_SET_UNMANAGED,
+                                                   NM_DEVICE_STATE_REASON_NOW_UNMANAGED);
+            return result;
+        }
+    } else {
+        if (dev_checkpoint->realized) {
+            if (dev_checkpoint->is_software) {
+                /* try to recreate software device */
+                _LOGD("rollback: software device not realized, will re-activate");
+                goto activate;
+            } else {
+                _LOGD("rollback: device is not realized");
+                result = NM_ROLLBACK_RESULT_ERR_FAILED;
+            }
+        }
+        return result;
+    }
+
+    /* Manage the device again if needed */
+    if (nm_device_get_unmanaged_flags(device, NM_UNMANAGED_USER_EXPLICIT)
+        && dev_checkpoint->unmanaged_explicit != NM_UNMAN_FLAG_OP_SET_UNMANAGED) {
+        _LOGD("rollback: restore unmanaged user-explicit");
+        nm_device_set_unmanaged_by_flags_queue(device,
+                                               NM_UNMANAGED_USER_EXPLICIT,
+                                               dev_checkpoint->unmanaged_explicit,
+                                               NM_DEVICE_STATE_REASON_NOW_MANAGED);
+    }
+
+    if (dev_checkpoint->state == NM_DEVICE_STATE_UNMANAGED) {
+        if (nm_device_get_state(device) != NM_DEVICE_STATE_UNMANAGED
+            || dev_checkpoint->unmanaged_explicit == NM_UNMAN_FLAG_OP_SET_UNMANAGED) {
+            _LOGD("rollback: explicitly unmanage device");
+            nm_device_set_unmanaged_by_flags_queue(device,
+                                                   NM_UNMANAGED_USER_EXPLICIT,
+                                                   NM_UNMAN_FLAG_OP_SET_UNMANAGED,
+                                                   NM_DEVICE_STATE_REASON_NOW_UNMANAGED);
+        }
+        return result;
+    }
+
+activate:
+    if (dev_checkpoint->applied_connection) {
+        if (!restore_and_activate_connection(self, dev_checkpoint)) {
+            result = NM_ROLLBACK_RESULT_ERR_FAILED;
+            return result;
+        }
+    } else {
+        /* The device was initially disconnected, deactivate any existing connection */
+
+        if (nm_device_get_state(device) > NM_DEVICE_STATE_DISCONNECTED
+            && nm_device_get_state(device) < NM_DEVICE_STATE_DEACTIVATING) {
+            _LOGD("rollback: disconnecting device");
+            nm_device_state_changed(device,
+                                    NM_DEVICE_STATE_DEACTIVATING,
+                                    NM_DEVICE_STATE_REASON_USER_REQUESTED);
+        }
+    }
+
+    return result;
+}
+
+static int
+_dev_checkpoint_cmp_rollback_order(gconstpointer pa, gconstpointer pb, gpointer user_data)
+{
+    const DeviceCheckpoint *a = *((const DeviceCheckpoint *const *) pa);
+    const DeviceCheckpoint *b = *((const DeviceCheckpoint *const *) pb);
+
+    NM_CMP_FIELD(a, b, rollback_depth);
+    NM_CMP_FIELD_STR0(a, b, original_dev_name);
+    return 0;
+}
+
 GVariant *
 nm_checkpoint_rollback(NMCheckpoint *self)
 {
-    NMCheckpointPrivate *priv = NM_CHECKPOINT_GET_PRIVATE(self);
-    DeviceCheckpoint    *dev_checkpoint;
-    GHashTableIter       iter;
-    NMDevice            *device;
-    GVariantBuilder      builder;
-    uint                 i;
+    NMCheckpointPrivate         *priv = NM_CHECKPOINT_GET_PRIVATE(self);
+    DeviceCheckpoint            *dev_checkpoint;
+    GHashTableIter               iter;
+    NMDevice                    *device;
+    GVariantBuilder              builder;
+    gs_unref_ptrarray GPtrArray *dev_checkpoints = NULL;
+    gint64                       start_nsec;
+    gint64                       dev_start_nsec;
+    gint64                       duration_nsec;
+    gint64                       max_duration_nsec = 0;
+    const char                  *max_duration_dev  = NULL;
+    uint                         i;
 
     _LOGI("rollback of %s", nm_dbus_object_get_path(NM_DBUS_OBJECT(self)));
     g_variant_builder_init(&builder, G_VARIANT_TYPE("a{su}"));
 
+    start_nsec = nm_utils_get_monotonic_timestamp_nsec();
+
     /* Start creating removed devices (if any and if possible) */
     if (priv->removed_devices) {
         for (i = 0; i < priv->removed_devices->len; i++) {
@@ -493,108 +607,80 @@ nm_checkpoint_rollback(NMCheckpoint *self)
         }
     }
 
-    /* Start rolling-back each device */
+    /* Roll back parents and controllers before the devices that depend on them.
+     * The activations themselves are asynchronous and proceed in parallel, but
+     * issuing them in this order avoids that ports and child devices first get
+     * activated while their controller/parent is still being torn down. */
+    dev_checkpoints = g_ptr_array_sized_new(g_hash_table_size(priv->devices));
     g_hash_table_iter_init(&iter, priv->devices);
-    while (g_hash_table_iter_next(&iter, (gpointer *) &device, (gpointer *) &dev_checkpoint)) {
-        guint32 result = NM_ROLLBACK_RESULT_OK;
-
-        _LOGD("rollback: restoring device %s (state %d, realized %d, explicitly unmanaged %d, "
-              "connection-unsaved %d, connection-shadowed %d, connection-shadowed-owned %d)",
-              dev_checkpoint->original_dev_name,
-              (int) dev_checkpoint->state,
-              dev_checkpoint->realized,
-              dev_checkpoint->unmanaged_explicit,
-              dev_checkpoint->settings_connection_is_unsaved,
-              !!dev_checkpoint->settings_connection_shadowed,
-              dev_checkpoint->settings_connection_is_shadowed_owned);
-
-        if (nm_device_is_real(device)) {
-            if (!dev_checkpoint->realized) {
-                _LOGD("rollback: device was not realized, unmanage it");
-                nm_device_set_unmanaged_by_flags_queue(device,
-                                                       NM_UNMANAGED_USER_EXPLICIT,
-                                                       NM_UNMAN_FLAG_OP_SET_UNMANAGED,
-                                                       NM_DEVICE_STATE_REASON_NOW_UNMANAGED);
-                goto next_dev;
-            }
-        } else {
-            if (dev_checkpoint->realized) {
-                if (dev_checkpoint->is_software) {
-                    /* try to recreate software device */
-                    _LOGD("rollback: software device not realized, will re-activate");
-                    goto activate;
-                } else {
-                    _LOGD("rollback: device is not realized");
-                    result = NM_ROLLBACK_RESULT_ERR_FAILED;
-                }
-            }
-            goto next_dev;
-        }
-
-        /* Manage the device again if needed */
-        if (nm_device_get_unmanaged_flags(device, NM_UNMANAGED_USER_EXPLICIT)
-            && dev_checkpoint->unmanaged_explicit != NM_UNMAN_FLAG_OP_SET_UNMANAGED) {
-            _LOGD("rollback: restore unmanaged user-explicit");
-            nm_device_set_unmanaged_by_flags_queue(device,
-                                                   NM_UNMANAGED_USER_EXPLICIT,
-                                                   dev_checkpoint->unmanaged_explicit,
-                                                   NM_DEVICE_STATE_REASON_NOW_MANAGED);
+    while (g_hash_table_iter_next(&iter, NULL, (gpointer *) &dev_checkpoint))
+        g_ptr_array_add(dev_checkpoints, dev_checkpoint);
+    g_ptr_array_sort_with_data(dev_checkpoints, _dev_checkpoint_cmp_rollback_order, NULL);
+
+    for (i = 0; i < dev_checkpoints->len; i++) {
+        guint32 result;
+
+        dev_checkpoint = dev_checkpoints->pdata[i];
+
+        if (!dev_checkpoint->device) {
+            /* the device was removed while rolling back another device. */
+            g_variant_builder_add(&builder,
+                                  "{su}",
+                                  dev_checkpoint->original_dev_path,
+                                  (guint32) NM_ROLLBACK_RESULT_ERR_NO_DEVICE);
+            continue;
         }
 
-        if (dev_checkpoint->state == NM_DEVICE_STATE_UNMANAGED) {
-            if (nm_device_get_state(device) != NM_DEVICE_STATE_UNMANAGED
-                || dev_checkpoint->unmanaged_explicit == NM_UNMAN_FLAG_OP_SET_UNMANAGED) {
-                _LOGD("rollback: explicitly unmanage device");
-                nm_device_set_unmanaged_by_flags_queue(device,
-                                                       NM_UNMANAGED_USER_EXPLICIT,
-                                                       NM_UNMAN_FLAG_OP_SET_UNMANAGED,
-                                                       NM_DEVICE_STATE_REASON_NOW_UNMANAGED);
-            }
-            goto next_dev;
-        }
+        dev_start_nsec = nm_utils_get_monotonic_timestamp_nsec();
+        result         = _rollback_device(self, dev_checkpoint);
+        duration_nsec  = nm_utils_get_monotonic_timestamp_nsec() - dev_start_nsec;
 
-activate:
-        if (dev_checkpoint->applied_connection) {
-            if (!restore_and_activate_connection(self, dev_checkpoint)) {
-                result = NM_ROLLBACK_RESULT_ERR_FAILED;
-                goto next_dev;
-            }
-        } else {
-            /* The device was initially disconnected, deactivate any existing connection */
+        _LOGT("rollback: device %s (depth %u) done with result %u in %" G_GINT64_FORMAT " usec",
+              dev_checkpoint->original_dev_name,
+              dev_checkpoint->rollback_depth,
+              (guint) result,
+              duration_nsec / NM_UTILS_NSEC_PER_USEC);
 
-            if (nm_device_get_state(device) > NM_DEVICE_STATE_DISCONNECTED
-                && nm_device_get_state(device) < NM_DEVICE_STATE_DEACTIVATING) {
-                _LOGD("rollback: disconnecting device");
-                nm_device_state_changed(device,
-                                        NM_DEVICE_STATE_DEACTIVATING,
-                                        NM_DEVICE_STATE_REASON_USER_REQUESTED);
-            }
+        if (duration_nsec > max_duration_nsec) {
+            max_duration_nsec = duration_nsec;
+            max_duration_dev  = dev_checkpoint->original_dev_name;
         }
 
-next_dev:
         g_variant_builder_add(&builder, "{su}", dev_checkpoint->original_dev_path, result);
     }
 
+    _LOGD("rollback: restored %u devices in %" G_GINT64_FORMAT
+          " msec (slowest %s, %" G_GINT64_FORMAT " msec)",
+          dev_checkpoints->len,
+          (nm_utils_get_monotonic_timestamp_nsec() - start_nsec) / NM_UTILS_NSEC_PER_MSEC,
+          max_duration_dev ?: "none",
+          max_duration_nsec / NM_UTILS_NSEC_PER_MSEC);
+
     if (NM_FLAGS_HAS(priv->flags, NM_CHECKPOINT_CREATE_FLAG_DELETE_NEW_CONNECTIONS)) {
-        NMSettingsConnection          *con;
-        gs_free NMSettingsConnection **list = NULL;
-
-        g_return_val_if_fail(priv->connection_uuids, NULL);
-        list = nm_settings_get_connections_clone(
-            NM_SETTINGS_GET,
-            NULL,
-            NULL,
-            NULL,
-            nm_settings_connection_cmp_autoconnect_priority_p_with_data,
-            NULL);
-
-        for (i = 0; list[i]; i++) {
-            con = list[i];
-            if (!g_hash_table_contains(priv->connection_uuids,
-                                       nm_settings_connection_get_uuid(con))) {
-                _LOGD("rollback: deleting new connection %s", nm_settings_connection_get_uuid(con));
-                nm_settings_connection_delete(con, FALSE);
-            }
+        gs_unref_ptrarray GPtrArray *list = NULL;
+        const char                  *uuid;
+
+        g_return_val_if_fail(priv->connection_uuids_added, NULL);
+
+        list = g_ptr_array_new_with_free_func(g_object_unref);
+        g_hash_table_iter_init(&iter, priv->connection_uuids_added);
+        while (g_hash_table_iter_next(&iter, (gpointer *) &uuid, NULL)) {
+            NMSettingsConnection *con;
+
+            con = nm_settings_get_connection_by_uuid(priv->settings, uuid);
+            if (con)
+                g_ptr_array_add(list, g_object_ref(con));
+        }
+
+        g_ptr_array_sort_with_data(list,
+                                   nm_settings_connection_cmp_autoconnect_priority_p_with_data,
+                                   NULL);
+
+        for (i = 0; i < list->len; i++) {
+            NMSettingsConnection *con = list->pdata[i];
+
+            _LOGD("rollback: deleting new connection %s", nm_settings_connection_get_uuid(con));
+            nm_settings_connection_delete(con, FALSE);
         }
     }
 
@@ -695,6 +781,55 @@ _dev_exported_changed(NMDBusObject *obj, NMCheckpoint *checkpoint)
     _move_dev_to_removed_devices(NM_DEVICE(obj), checkpoint);
 }
 
+static void
+_connection_added_cb(NMSettings *settings, NMSettingsConnection *sett_conn, gpointer user_data)
+{
+    NMCheckpoint        *self = user_data;
+    NMCheckpointPrivate *priv = NM_CHECKPOINT_GET_PRIVATE(self);
+    const char          *uuid = nm_settings_connection_get_uuid(sett_conn);
+
+    /* A profile that existed when creating the checkpoint and that got re-added
+     * is not a new connection. */
+    if (g_hash_table_contains(priv->connection_uuids_removed, uuid))
+        return;
+
+    g_hash_table_add(priv->connection_uuids_added, g_strdup(uuid));
+}
+
+static void
+_connection_removed_cb(NMSettings *settings, NMSettingsConnection *sett_conn, gpointer user_data)
+{
+    NMCheckpoint        *self = user_data;
+    NMCheckpointPrivate *priv = NM_CHECKPOINT_GET_PRIVATE(self);
+    const char          *uuid = nm_settings_connection_get_uuid(sett_conn);
+
+    if (g_hash_table_remove(priv->connection_uuids_added, uuid))
+        return;
+
+    g_hash_table_add(priv->connection_uuids_removed, g_strdup(uuid));
+}
+
+static guint
+_device_get_rollback_depth(NMDevice *device, guint level)
+{
+    NMDevice *dep;
+    guint     depth = 0;
+
+    /* protect against loops and absurdly deep stacks. */
+    if (level >= 16)
+        return 0;
+
+    dep = nm_device_parent_get_device(device);
+    if (dep)
+        depth = NM_MAX(depth, 1u + _device_get_rollback_depth(dep, level + 1u));
+
+    dep = nm_device_get_controller(device);
+    if (dep)
+        depth = NM_MAX(depth, 1u + _device_get_rollback_depth(dep, level + 1u));
+
+    return depth;
+}
+
 static DeviceCheckpoint *
 device_checkpoint_create(NMCheckpoint *self, NMDevice *device)
 {
@@ -717,6 +852,7 @@ device_checkpoint_create(NMCheckpoint *self, NMDevice *device)
     dev_checkpoint->state                  = nm_device_get_state(device);
     dev_checkpoint->is_software            = nm_device_is_software(device);
     dev_checkpoint->realized               = nm_device_is_real(device);
+    dev_checkpoint->rollback_depth         = _device_get_rollback_depth(device, 0);
     dev_checkpoint->dev_exported_change_id = g_signal_connect(device,
                                                               NM_DBUS_OBJECT_EXPORTED_CHANGED,
                                                               G_CALLBACK(_dev_exported_changed),
@@ -738,9 +874,12 @@ device_checkpoint_create(NMCheckpoint *self, NMDevice *device)
         settings_connection = nm_act_request_get_settings_connection(act_request);
         applied_connection  = nm_act_request_get_applied_connection(act_request);
 
-        dev_checkpoint->applied_connection  = nm_simple_connection_new_clone(applied_connection);
-        dev_checkpoint->settings_connection = nm_simple_connection_new_clone(
-            nm_settings_connection_get_connection(settings_connection));
+        /* The connection of a NMSettingsConnection is never modified. On update,
+         * it gets replaced by a new instance. We can just keep a reference. The
+         * applied connection can change in place (for example on reapply), so clone it. */
+        dev_checkpoint->applied_connection = nm_simple_connection_new_clone(applied_connection);
+        dev_checkpoint->settings_connection =
+            g_object_ref(nm_settings_connection_get_connection(settings_connection));
         dev_checkpoint->ac_version_id =
             nm_active_connection_version_id_get(NM_ACTIVE_CONNECTION(act_request));
         dev_checkpoint->activation_reason =
@@ -875,11 +1014,10 @@ nm_checkpoint_new(NMManager              *manager,
                   guint32                 rollback_timeout_s,
                   NMCheckpointCreateFlags flags)
 {
-    NMCheckpoint                *self;
-    NMCheckpointPrivate         *priv;
-    NMSettingsConnection *const *con;
-    gint64                       rollback_timeout_ms;
-    guint                        i;
+    NMCheckpoint        *self;
+    NMCheckpointPrivate *priv;
+    gint64               rollback_timeout_ms;
+    guint                i;
 
     g_return_val_if_fail(manager, NULL);
     g_return_val_if_fail(devices, NULL);
@@ -900,11 +1038,19 @@ nm_checkpoint_new(NMManager              *manager,
     }
 
     if (NM_FLAGS_HAS(flags, NM_CHECKPOINT_CREATE_FLAG_DELETE_NEW_CONNECTIONS)) {
-        priv->connection_uuids = g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, NULL);
-        for (con = nm_settings_get_connections(NM_SETTINGS_GET, NULL); *con; con++) {
-            g_hash_table_add(priv->connection_uuids,
-                             g_strdup(nm_settings_connection_get_uuid(*con)));
-        }
+        priv->settings = g_object_ref(NM_SETTINGS_GET);
+        priv->connection_uuids_added =
+            g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, NULL);
+        priv->connection_uuids_removed =
+            g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, NULL);
+        priv->connection_added_id   = g_signal_connect(priv->settings,
+                                                     NM_SETTINGS_SIGNAL_CONNECTION_ADDED,
+                                                     G_CALLBACK(_connection_added_cb),
+                                                     self);
+        priv->connection_removed_id = g_signal_connect(priv->settings,
+                                                       NM_SETTINGS_SIGNAL_CONNECTION_REMOVED,
+                                                       G_CALLBACK(_connection_removed_cb),
+                                                       self);
     }
 
     for (i = 0; i < devices->len; i++) {
@@ -945,7 +1091,11 @@ dispose(GObject *object)
     nm_assert(c_list_is_empty(&self->checkpoints_lst));
 
     nm_clear_pointer(&priv->devices, g_hash_table_unref);
-    nm_clear_pointer(&priv->connection_uuids, g_hash_table_unref);
+    nm_clear_g_signal_handler(priv->settings, &priv->connection_added_id);
+    nm_clear_g_signal_handler(priv->settings, &priv->connection_removed_id);
+    g_clear_object(&priv->settings);
+    nm_clear_pointer(&priv->connection_uuids_added, g_hash_table_unref);
+    nm_clear_pointer(&priv->connection_uuids_removed, g_hash_table_unref);
     nm_clear_pointer(&priv->removed_devices, g_ptr_array_unref);
     nm_global_dns_config_free(priv->global_dns_config);
 
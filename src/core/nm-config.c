@@ -846,6 +846,7 @@ static const ConfigGroup config_groups[] = {
                              NM_CONFIG_KEYFILE_KEY_MAIN_AUTH_POLKIT,
                              NM_CONFIG_KEYFILE_KEY_MAIN_AUTOCONNECT_RETRIES_DEFAULT,
                              NM_CONFIG_KEYFILE_KEY_MAIN_CONFIGURE_AND_QUIT,
+                             NM_CONFIG_KEYFILE_KEY_MAIN_DBUS_PROPERTIES_DELAY,
                              NM_CONFIG_KEYFILE_KEY_MAIN_DEBUG,
                              NM_CONFIG_KEYFILE_KEY_MAIN_DHCP,
                              NM_CONFIG_KEYFILE_KEY_MAIN_DNS,
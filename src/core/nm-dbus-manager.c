@@ -31,18 +31,30 @@
 /*****************************************************************************/
 
 typedef struct {
-    CList  caller_info_lst;
-    gulong uid;
-    gulong pid;
-    gint64 uid_checked_at;
-    gint64 pid_checked_at;
-    bool   uid_valid : 1;
-    bool   pid_valid : 1;
-    char   sender[0];
+    CList                              pending_lst;
+    GDBusMethodInvocation             *invocation;
+    NMDBusObject                      *obj;
+    const NMDBusInterfaceInfoExtended *interface_info;
+} CallerInfoPendingCall;
+
+typedef struct {
+    /* method calls that wait for the credentials to be fetched. */
+    CList         pending_lst_head;
+    GCancellable *cancellable;
+    gulong        uid;
+    gulong        pid;
+    bool          fetched : 1;
+    bool          uid_valid : 1;
+    bool          pid_valid : 1;
+    bool          vanished : 1;
+    char          sender[];
 } CallerInfo;
 
 typedef struct {
     GVariant *value;
+
+    /* whether the property changed and a PropertiesChanged signal is pending. */
+    bool dirty : 1;
 } PropertyCacheData;
 
 typedef struct {
@@ -51,7 +63,13 @@ typedef struct {
     NMDBusObjectClass *klass;
     guint              info_idx;
     guint              registration_id;
-    PropertyCacheData  property_cache[];
+
+    /* the "a{sv}" dictionary with all properties of the interface, as used by
+     * GetManagedObjects() and InterfacesAdded. Like the values in @property_cache,
+     * it gets dropped when one of the properties changes. */
+    GVariant *properties_value;
+
+    PropertyCacheData property_cache[];
 } RegistrationData;
 
 /* we require that @path is the first member of NMDBusManagerData
@@ -61,6 +79,7 @@ G_STATIC_ASSERT(G_STRUCT_OFFSET(struct _NMDBusObjectInternal, path) == 0);
 enum {
     PRIVATE_CONNECTION_NEW,
     PRIVATE_CONNECTION_DISCONNECTED,
+    SENDER_VANISHED,
 
     LAST_SIGNAL
 };
@@ -78,7 +97,23 @@ typedef struct {
 
     GDBusConnection *main_dbus_connection;
 
-    CList caller_info_lst_head;
+    /* Credentials of D-Bus peers by unique name. Unique names are never reused by
+     * the bus, so an entry is valid until NameOwnerChanged reports the name gone. */
+    GHashTable *caller_infos;
+    guint       name_owner_changed_id;
+    guint64     n_blocking_caller_lookups;
+
+    /* objects with pending PropertiesChanged signals, that get emitted together
+     * by _obj_flush_all_properties_changed(). */
+    CList    dirty_objs_lst_head;
+    GSource *properties_changed_source;
+    guint    properties_changed_delay_msec;
+    guint64  n_properties_notified;
+    guint64  n_properties_changed_emitted;
+    guint64  n_properties_values_built;
+
+    /* method calls that were dispatched to a handler, but not yet replied. */
+    guint n_pending_method_calls;
 
     guint objmgr_registration_id;
     bool  started : 1;
@@ -448,139 +483,146 @@ private_server_get_connection_by_owner(PrivateServer *s, const char *owner)
 static void
 _caller_info_free(CallerInfo *caller_info)
 {
-    c_list_unlink_stale(&caller_info->caller_info_lst);
+    nm_assert(c_list_is_empty(&caller_info->pending_lst_head));
+    nm_assert(!caller_info->cancellable);
+
     g_free(caller_info);
 }
 
-static gboolean
-_bus_get_unix_pid(NMDBusManager *self, const char *sender, gulong *out_pid)
+static CallerInfo *
+_caller_info_new(NMDBusManager *self, const char *sender)
 {
-    NMDBusManagerPrivate      *priv     = NM_DBUS_MANAGER_GET_PRIVATE(self);
-    guint32                    unix_pid = G_MAXUINT32;
-    gs_unref_variant GVariant *ret      = NULL;
+    NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
+    CallerInfo           *caller_info;
+    gsize                 l = strlen(sender) + 1;
+
+    caller_info  = g_malloc(sizeof(CallerInfo) + l);
+    *caller_info = (CallerInfo){
+        .pending_lst_head = C_LIST_INIT(caller_info->pending_lst_head),
+        .uid              = G_MAXULONG,
+        .pid              = G_MAXULONG,
+    };
+    memcpy(caller_info->sender, sender, l);
+    g_hash_table_insert(priv->caller_infos, caller_info->sender, caller_info);
+    return caller_info;
+}
 
-    if (!priv->main_dbus_connection)
-        return FALSE;
+static void
+_caller_info_set_credentials(CallerInfo *caller_info, GVariant *credentials)
+{
+    guint32 v;
 
-    ret = g_dbus_connection_call_sync(priv->main_dbus_connection,
-                                      DBUS_SERVICE_DBUS,
-                                      DBUS_PATH_DBUS,
-                                      DBUS_INTERFACE_DBUS,
-                                      "GetConnectionUnixProcessID",
-                                      g_variant_new("(s)", sender),
-                                      G_VARIANT_TYPE("(u)"),
-                                      G_DBUS_CALL_FLAGS_NONE,
-                                      2000,
-                                      NULL,
-                                      NULL);
-    if (!ret)
-        return FALSE;
+    nm_assert(g_variant_is_of_type(credentials, G_VARIANT_TYPE("a{sv}")));
 
-    g_variant_get(ret, "(u)", &unix_pid);
+    caller_info->fetched = TRUE;
 
-    *out_pid = (gulong) unix_pid;
-    return TRUE;
+    caller_info->uid_valid = g_variant_lookup(credentials, "UnixUserID", "u", &v);
+    caller_info->uid       = caller_info->uid_valid ? (gulong) v : G_MAXULONG;
+
+    caller_info->pid_valid = g_variant_lookup(credentials, "ProcessID", "u", &v);
+    caller_info->pid       = caller_info->pid_valid ? (gulong) v : G_MAXULONG;
 }
 
-static gboolean
-_bus_get_unix_user(NMDBusManager *self, const char *sender, gulong *out_user)
+static GVariant *
+_bus_get_connection_credentials(NMDBusManager *self, const char *sender)
 {
-    NMDBusManagerPrivate      *priv     = NM_DBUS_MANAGER_GET_PRIVATE(self);
-    guint32                    unix_uid = G_MAXUINT32;
-    gs_unref_variant GVariant *ret      = NULL;
+    NMDBusManagerPrivate      *priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
+    gs_unref_variant GVariant *ret  = NULL;
 
     if (!priv->main_dbus_connection)
-        return FALSE;
+        return NULL;
 
     ret = g_dbus_connection_call_sync(priv->main_dbus_connection,
                                       DBUS_SERVICE_DBUS,
                                       DBUS_PATH_DBUS,
                                       DBUS_INTERFACE_DBUS,
-                                      "GetConnectionUnixUser",
+                                      "GetConnectionCredentials",
                                       g_variant_new("(s)", sender),
-                                      G_VARIANT_TYPE("(u)"),
+                                      G_VARIANT_TYPE("(a{sv})"),
                                       G_DBUS_CALL_FLAGS_NONE,
                                       2000,
                                       NULL,
                                       NULL);
     if (!ret)
-        return FALSE;
-
-    g_variant_get(ret, "(u)", &unix_uid);
+        return NULL;
 
-    *out_user = (gulong) unix_uid;
-    return TRUE;
+    return g_variant_get_child_value(ret, 0);
 }
 
-static const CallerInfo *
-_get_caller_info_ensure(NMDBusManager *self,
-                        const char    *sender,
-                        gboolean       ensure_uid,
-                        gboolean       ensure_pid)
+static gboolean
+_get_caller_info_ensure(NMDBusManager *self, const char *sender, gulong *out_uid, gulong *out_pid)
 {
     NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
     CallerInfo           *caller_info;
-    CallerInfo           *ci;
-    gint64                now_ns;
-    gsize                 num;
 
-#define CALLER_INFO_MAX_AGE (NM_UTILS_NSEC_PER_SEC * 1)
+    caller_info = g_hash_table_lookup(priv->caller_infos, sender);
 
-    /* Linear search the cache for the sender.
-     *
-     * The number of cached caller-infos is limited. Hence, it's O(1) and
-     * the list is reasonably short.
-     * Also, the entire caching assumes that we repeatedly ask for the
-     * same sender. That means, we expect to find the right caller info
-     * at the front of the list. */
-    num         = 1;
-    caller_info = NULL;
-    c_list_for_each_entry (ci, &priv->caller_info_lst_head, caller_info_lst) {
-        if (nm_streq(sender, ci->sender)) {
-            caller_info = ci;
-            break;
-        }
-        num++;
-    }
+    if (!caller_info || !caller_info->fetched) {
+        gs_unref_variant GVariant *credentials = NULL;
 
-    if (caller_info)
-        nm_c_list_move_front(&priv->caller_info_lst_head, &caller_info->caller_info_lst);
-    else {
-        gsize l = strlen(sender) + 1;
-
-        caller_info  = g_malloc(sizeof(CallerInfo) + l);
-        *caller_info = (CallerInfo){
-            .uid_checked_at = -CALLER_INFO_MAX_AGE,
-            .pid_checked_at = -CALLER_INFO_MAX_AGE,
-        };
-        memcpy(caller_info->sender, sender, l);
-        c_list_link_front(&priv->caller_info_lst_head, &caller_info->caller_info_lst);
-
-        /* only cache the last few entries. */
-        while (TRUE) {
-            nm_assert(num > 0 && num == c_list_length(&priv->caller_info_lst_head));
-            if (num-- <= 5)
-                break;
-            _caller_info_free(
-                c_list_last_entry(&priv->caller_info_lst_head, CallerInfo, caller_info_lst));
+        /* Usually, the credentials were already fetched asynchronously before
+         * the method call got dispatched (see _caller_info_defer_method_call()).
+         * This blocking lookup is the fallback for other callers. */
+        priv->n_blocking_caller_lookups++;
+        credentials = _bus_get_connection_credentials(self, sender);
+        if (!credentials) {
+            NM_SET_OUT(out_uid, G_MAXULONG);
+            NM_SET_OUT(out_pid, G_MAXULONG);
+            return FALSE;
         }
+
+        if (!caller_info)
+            caller_info = _caller_info_new(self, sender);
+        _caller_info_set_credentials(caller_info, credentials);
     }
 
-    now_ns = nm_utils_get_monotonic_timestamp_nsec();
+    NM_SET_OUT(out_uid, caller_info->uid);
+    NM_SET_OUT(out_pid, caller_info->pid);
 
-    if (ensure_uid && (now_ns - caller_info->uid_checked_at) > CALLER_INFO_MAX_AGE) {
-        caller_info->uid_checked_at = now_ns;
-        if (!(caller_info->uid_valid = _bus_get_unix_user(self, sender, &caller_info->uid)))
-            caller_info->uid = G_MAXULONG;
-    }
+    if (out_uid && !caller_info->uid_valid)
+        return FALSE;
+    if (out_pid && !caller_info->pid_valid)
+        return FALSE;
+    return TRUE;
+}
 
-    if (ensure_pid && (now_ns - caller_info->pid_checked_at) > CALLER_INFO_MAX_AGE) {
-        caller_info->pid_checked_at = now_ns;
-        if (!(caller_info->pid_valid = _bus_get_unix_pid(self, sender, &caller_info->pid)))
-            caller_info->pid = G_MAXULONG;
+static void
+_name_owner_changed_cb(GDBusConnection *connection,
+                       const char      *sender_name,
+                       const char      *object_path,
+                       const char      *interface_name,
+                       const char      *signal_name,
+                       GVariant        *parameters,
+                       gpointer         user_data)
+{
+    NMDBusManager        *self = user_data;
+    NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
+    CallerInfo           *caller_info;
+    const char           *name;
+    const char           *old_owner;
+    const char           *new_owner;
+
+    if (!g_variant_is_of_type(parameters, G_VARIANT_TYPE("(sss)")))
+        return;
+
+    g_variant_get(parameters, "(&s&s&s)", &name, &old_owner, &new_owner);
+
+    if (new_owner[0] != '\0' || name[0] != ':')
+        return;
+
+    g_signal_emit(self, signals[SENDER_VANISHED], 0, name);
+
+    caller_info = g_hash_table_lookup(priv->caller_infos, name);
+    if (!caller_info)
+        return;
+
+    if (caller_info->cancellable) {
+        /* The lookup is still in progress. Drop the entry once it completes. */
+        caller_info->vanished = TRUE;
+        return;
     }
 
-    return caller_info;
+    g_hash_table_remove(priv->caller_infos, caller_info->sender);
 }
 
 static gboolean
@@ -593,7 +635,6 @@ _get_caller_info(NMDBusManager         *self,
                  gulong                *out_pid)
 {
     NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
-    const CallerInfo     *caller_info;
     const char           *sender;
 
     if (context) {
@@ -641,17 +682,8 @@ _get_caller_info(NMDBusManager         *self,
         return FALSE;
     }
 
-    caller_info = _get_caller_info_ensure(self, sender, !!out_uid, !!out_pid);
-
-    NM_SET_OUT(out_sender, caller_info->sender);
-    NM_SET_OUT(out_uid, caller_info->uid);
-    NM_SET_OUT(out_pid, caller_info->pid);
-
-    if (out_uid && !caller_info->uid_valid)
-        return FALSE;
-    if (out_pid && !caller_info->pid_valid)
-        return FALSE;
-    return TRUE;
+    NM_SET_OUT(out_sender, sender);
+    return _get_caller_info_ensure(self, sender, out_uid, out_pid);
 }
 
 gboolean
@@ -723,7 +755,6 @@ gboolean
 nm_dbus_manager_get_unix_user(NMDBusManager *self, const char *sender, gulong *out_uid)
 {
     NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
-    const CallerInfo     *caller_info;
     PrivateServer        *s;
 
     g_return_val_if_fail(sender != NULL, FALSE);
@@ -741,9 +772,7 @@ nm_dbus_manager_get_unix_user(NMDBusManager *self, const char *sender, gulong *o
     }
 
     /* Otherwise, a bus connection */
-    caller_info = _get_caller_info_ensure(self, sender, TRUE, FALSE);
-    *out_uid    = caller_info->uid;
-    if (!caller_info->uid_valid) {
+    if (!_get_caller_info_ensure(self, sender, out_uid, NULL)) {
         _LOGW("failed to get unix user for dbus sender '%s'", sender);
         return FALSE;
     }
@@ -762,19 +791,43 @@ _reg_data_get_interface_info(RegistrationData *reg_data)
 
 /*****************************************************************************/
 
+static void _obj_flush_all_properties_changed(NMDBusManager *self);
+
 static void
-dbus_vtable_method_call(GDBusConnection       *connection,
-                        const char            *sender,
-                        const char            *object_path,
-                        const char            *interface_name,
-                        const char            *method_name,
-                        GVariant              *parameters,
-                        GDBusMethodInvocation *invocation,
-                        gpointer               user_data)
+_method_call_replied_cb(gpointer user_data, GObject *invocation)
+{
+    NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE(user_data);
+
+    nm_assert(priv->n_pending_method_calls > 0);
+    priv->n_pending_method_calls--;
+}
+
+static void
+_method_call_track(NMDBusManager *self, GDBusMethodInvocation *invocation)
+{
+    NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
+
+    /* The reply must not overtake the PropertiesChanged signals of changes that
+     * happened before it. Flush what is pending now, and while the call is not
+     * replied, emit further changes right away (see _nm_dbus_manager_obj_notify()).
+     * The invocation gets destroyed when the handler returns the reply. */
+    _obj_flush_all_properties_changed(self);
+
+    priv->n_pending_method_calls++;
+    g_object_weak_ref(G_OBJECT(invocation), _method_call_replied_cb, self);
+}
+
+static void
+_method_call_handle(RegistrationData      *reg_data,
+                    GDBusConnection       *connection,
+                    const char            *sender,
+                    const char            *interface_name,
+                    const char            *method_name,
+                    GVariant              *parameters,
+                    GDBusMethodInvocation *invocation)
 {
     NMDBusManager                     *self;
     NMDBusManagerPrivate              *priv;
-    RegistrationData                  *reg_data       = user_data;
     NMDBusObject                      *obj            = reg_data->obj;
     const NMDBusInterfaceInfoExtended *interface_info = _reg_data_get_interface_info(reg_data);
     const NMDBusMethodInfoExtended    *method_info    = NULL;
@@ -815,6 +868,7 @@ dbus_vtable_method_call(GDBusConnection       *connection,
             return;
         }
 
+        _method_call_track(self, invocation);
         priv->set_property_handler(obj,
                                    interface_info,
                                    property_info,
@@ -850,6 +904,7 @@ dbus_vtable_method_call(GDBusConnection       *connection,
         return;
     }
 
+    _method_call_track(self, invocation);
     method_info->handle(reg_data->obj,
                         interface_info,
                         method_info,
@@ -859,24 +914,170 @@ dbus_vtable_method_call(GDBusConnection       *connection,
                         parameters);
 }
 
+static void
+_caller_info_pending_call_dispatch(CallerInfoPendingCall *pending_call)
+{
+    GDBusMethodInvocation *invocation = pending_call->invocation;
+    RegistrationData      *reg_data;
+
+    c_list_unlink_stale(&pending_call->pending_lst);
+
+    /* The object might have been unregistered while we were waiting. */
+    if (nm_streq0(pending_call->obj->internal.path,
+                  g_dbus_method_invocation_get_object_path(invocation))) {
+        c_list_for_each_entry (reg_data,
+                               &pending_call->obj->internal.registration_lst_head,
+                               registration_lst) {
+            if (_reg_data_get_interface_info(reg_data) != pending_call->interface_info)
+                continue;
+
+            _method_call_handle(reg_data,
+                                g_dbus_method_invocation_get_connection(invocation),
+                                g_dbus_method_invocation_get_sender(invocation),
+                                g_dbus_method_invocation_get_interface_name(invocation),
+                                g_dbus_method_invocation_get_method_name(invocation),
+                                g_dbus_method_invocation_get_parameters(invocation),
+                                invocation);
+            goto out;
+        }
+    }
+
+    g_dbus_method_invocation_return_error(invocation,
+                                          G_DBUS_ERROR,
+                                          G_DBUS_ERROR_UNKNOWN_OBJECT,
+                                          "Object %s no longer exists",
+                                          g_dbus_method_invocation_get_object_path(invocation));
+
+out:
+    g_object_unref(pending_call->obj);
+    nm_g_slice_free(pending_call);
+}
+
+static void
+_caller_info_fetch_cb(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+    NMDBusManager             *self;
+    CallerInfo                *caller_info;
+    CallerInfoPendingCall     *pending_call;
+    gs_unref_variant GVariant *ret         = NULL;
+    gs_unref_variant GVariant *credentials = NULL;
+    gs_free_error GError      *error       = NULL;
+
+    nm_utils_user_data_unpack(user_data, &self, &caller_info);
+
+    ret = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), result, &error);
+    if (nm_utils_error_is_cancelled(error))
+        return;
+
+    g_clear_object(&caller_info->cancellable);
+
+    if (ret) {
+        credentials = g_variant_get_child_value(ret, 0);
+        _caller_info_set_credentials(caller_info, credentials);
+    } else
+        _LOGD("failure to get credentials of %s: %s", caller_info->sender, error->message);
+
+    /* Dispatch the method calls in the order in which they were received.
+     * If the lookup failed, the handlers will fail the authorization while
+     * retrying the lookup synchronously. */
+    while ((pending_call = c_list_first_entry(&caller_info->pending_lst_head,
+                                              CallerInfoPendingCall,
+                                              pending_lst)))
+        _caller_info_pending_call_dispatch(pending_call);
+
+    if (caller_info->vanished || !caller_info->fetched)
+        g_hash_table_remove(NM_DBUS_MANAGER_GET_PRIVATE(self)->caller_infos, caller_info->sender);
+}
+
+static gboolean
+_caller_info_defer_method_call(RegistrationData      *reg_data,
+                               GDBusConnection       *connection,
+                               const char            *sender,
+                               GDBusMethodInvocation *invocation)
+{
+    NMDBusManager         *self = nm_dbus_object_get_manager(reg_data->obj);
+    NMDBusManagerPrivate  *priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
+    CallerInfo            *caller_info;
+    CallerInfoPendingCall *pending_call;
+
+    /* Handlers usually authenticate the caller, which requires its credentials.
+     * Fetch them asynchronously before dispatching the method call, instead of
+     * blocking the main loop on a D-Bus roundtrip in the handler. */
+
+    if (!sender || connection != priv->main_dbus_connection || priv->name_owner_changed_id == 0)
+        return FALSE;
+
+    caller_info = g_hash_table_lookup(priv->caller_infos, sender);
+    if (caller_info && caller_info->fetched)
+        return FALSE;
+
+    if (!caller_info)
+        caller_info = _caller_info_new(self, sender);
+
+    if (!caller_info->cancellable) {
+        caller_info->cancellable = g_cancellable_new();
+        g_dbus_connection_call(priv->main_dbus_connection,
+                               DBUS_SERVICE_DBUS,
+                               DBUS_PATH_DBUS,
+                               DBUS_INTERFACE_DBUS,
+                               "GetConnectionCredentials",
+                               g_variant_new("(s)", sender),
+                               G_VARIANT_TYPE("(a{sv})"),
+                               G_DBUS_CALL_FLAGS_NONE,
+                               2000,
+                               caller_info->cancellable,
+                               _caller_info_fetch_cb,
+                               nm_utils_user_data_pack(self, caller_info));
+    }
+
+    pending_call  = g_slice_new(CallerInfoPendingCall);
+    *pending_call = (CallerInfoPendingCall){
+        .invocation     = invocation,
+        .obj            = g_object_ref(reg_data->obj),
+        .interface_info = _reg_data_get_interface_info(reg_data),
+    };
+    c_list_link_tail(&caller_info->pending_lst_head, &pending_call->pending_lst);
+    return TRUE;
+}
+
+static void
+dbus_vtable_method_call(GDBusConnection       *connection,
+                        const char            *sender,
+                        const char            *object_path,
+                        const char            *interface_name,
+                        const char            *method_name,
+                        GVariant              *parameters,
+                        GDBusMethodInvocation *invocation,
+                        gpointer               user_data)
+{
+    RegistrationData *reg_data = user_data;
+
+    if (_caller_info_defer_method_call(reg_data, connection, sender, invocation))
+        return;
+
+    _method_call_handle(reg_data,
+                        connection,
+                        sender,
+                        interface_name,
+                        method_name,
+                        parameters,
+                        invocation);
+}
+
 static GVariant *
-_obj_get_property(RegistrationData *reg_data, guint property_idx, gboolean refetch)
+_obj_get_property(RegistrationData *reg_data, guint property_idx)
 {
     const NMDBusInterfaceInfoExtended *interface_info = _reg_data_get_interface_info(reg_data);
     const NMDBusPropertyInfoExtended  *property_info;
     GVariant                          *value;
 
+    value = reg_data->property_cache[property_idx].value;
+    if (value)
+        goto out;
+
     property_info =
         (const NMDBusPropertyInfoExtended *) (interface_info->parent.properties[property_idx]);
 
-    if (refetch)
-        nm_clear_g_variant(&reg_data->property_cache[property_idx].value);
-    else {
-        value = reg_data->property_cache[property_idx].value;
-        if (value)
-            goto out;
-    }
-
     value = nm_dbus_utils_get_property(G_OBJECT(reg_data->obj),
                                        property_info->parent.signature,
                                        property_info->property_name);
@@ -903,7 +1104,7 @@ dbus_vtable_get_property(GDBusConnection *connection,
                                                       &property_idx))
         g_return_val_if_reached(NULL);
 
-    return _obj_get_property(reg_data, property_idx, FALSE);
+    return _obj_get_property(reg_data, property_idx);
 }
 
 static const GDBusInterfaceVTable dbus_vtable = {
@@ -915,6 +1116,92 @@ static const GDBusInterfaceVTable dbus_vtable = {
     .set_property = NULL,
 };
 
+static void
+_obj_flush_properties_changed(NMDBusManager *self, NMDBusObject *obj)
+{
+    NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
+    RegistrationData     *reg_data;
+    guint                 i;
+
+    nm_assert(c_list_contains(&priv->dirty_objs_lst_head, &obj->internal.dirty_lst));
+
+    c_list_unlink(&obj->internal.dirty_lst);
+
+    /* The properties are added to the GVariant in the order in which the D-Bus
+     * property-info is declared, and with their current value. All notifications
+     * since the last flush are merged into one signal per interface. */
+    c_list_for_each_entry (reg_data, &obj->internal.registration_lst_head, registration_lst) {
+        const NMDBusInterfaceInfoExtended *interface_info = _reg_data_get_interface_info(reg_data);
+        gboolean                           has_properties = FALSE;
+        GVariantBuilder                    builder;
+        GVariantBuilder                    invalidated_builder;
+        GVariant                          *args;
+
+        if (!interface_info->parent.properties)
+            continue;
+
+        for (i = 0; interface_info->parent.properties[i]; i++) {
+            const NMDBusPropertyInfoExtended *property_info =
+                (const NMDBusPropertyInfoExtended *) interface_info->parent.properties[i];
+            gs_unref_variant GVariant *value = NULL;
+
+            if (!reg_data->property_cache[i].dirty)
+                continue;
+
+            reg_data->property_cache[i].dirty = FALSE;
+
+            value = _obj_get_property(reg_data, i);
+
+            if (!has_properties) {
+                has_properties = TRUE;
+                g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
+            }
+            g_variant_builder_add(&builder, "{sv}", property_info->parent.name, value);
+        }
+
+        if (!has_properties)
+            continue;
+
+        args = g_variant_builder_end(&builder);
+
+        obj->internal.n_properties_changed_emitted++;
+        priv->n_properties_changed_emitted++;
+
+        g_variant_builder_init(&invalidated_builder, G_VARIANT_TYPE("as"));
+        g_dbus_connection_emit_signal(
+            priv->main_dbus_connection,
+            NULL,
+            obj->internal.path,
+            DBUS_INTERFACE_PROPERTIES,
+            "PropertiesChanged",
+            g_variant_new("(s@a{sv}as)", interface_info->parent.name, args, &invalidated_builder),
+            NULL);
+    }
+}
+
+static void
+_obj_flush_all_properties_changed(NMDBusManager *self)
+{
+    NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
+    NMDBusObject         *obj;
+
+    /* Called before emitting any other signal, so that clients see the
+     * signals in the order in which the changes happened. */
+    nm_clear_g_source_inst(&priv->properties_changed_source);
+
+    while ((obj = c_list_first_entry(&priv->dirty_objs_lst_head,
+                                     NMDBusObject,
+                                     internal.dirty_lst)))
+        _obj_flush_properties_changed(self, obj);
+}
+
+static gboolean
+_obj_flush_properties_changed_cb(gpointer user_data)
+{
+    _obj_flush_all_properties_changed(user_data);
+    return G_SOURCE_CONTINUE;
+}
+
 static void
 _obj_register(NMDBusManager *self, NMDBusObject *obj)
 {
@@ -992,6 +1279,8 @@ _obj_register(NMDBusManager *self, NMDBusObject *obj)
 
     nm_assert(!c_list_is_empty(&obj->internal.registration_lst_head));
 
+    _obj_flush_all_properties_changed(self);
+
     /* Currently, the interfaces of an object do not changed and strictly depend on the object glib type.
      * We don't need more flexibility, and it simplifies the code. Hence, now emit interface-added
      * signal for the new object.
@@ -1029,6 +1318,13 @@ _obj_unregister(NMDBusManager *self, NMDBusObject *obj)
     nm_assert(priv->started);
     nm_assert(!c_list_is_empty(&obj->internal.registration_lst_head));
 
+    _obj_flush_all_properties_changed(self);
+
+    _LOGT("unregister %s: merged %u property notifications into %u PropertiesChanged signals",
+          obj->internal.path,
+          obj->internal.n_properties_notified,
+          obj->internal.n_properties_changed_emitted);
+
     g_variant_builder_init(&builder, G_VARIANT_TYPE("as"));
 
     while ((reg_data = c_list_last_entry(&obj->internal.registration_lst_head,
@@ -1047,6 +1343,7 @@ _obj_unregister(NMDBusManager *self, NMDBusObject *obj)
             for (i = 0; interface_info->parent.properties[i]; i++)
                 nm_clear_g_variant(&reg_data->property_cache[i].value);
         }
+        nm_clear_g_variant(&reg_data->properties_value);
 
         g_type_class_unref(reg_data->klass);
         g_free(reg_data);
@@ -1154,6 +1451,7 @@ _nm_dbus_manager_obj_notify(NMDBusObject *obj, guint n_pspecs, const GParamSpec
     NMDBusManagerPrivate *priv;
     RegistrationData     *reg_data;
     guint                 i, p;
+    gboolean              has_dirty = FALSE;
 
     nm_assert(NM_IS_DBUS_OBJECT(obj));
     nm_assert(obj->internal.path);
@@ -1174,15 +1472,11 @@ _nm_dbus_manager_obj_notify(NMDBusObject *obj, guint n_pspecs, const GParamSpec
      * (interfaces x properties) is static and possibly small, this naive search is effectively
      * O(1). We might wanna introduce some index to lookup the properties in question faster.
      *
-     * The nice part of this implementation is however, that the order in which properties
-     * are added to the GVariant is strictly defined to be the order in which the D-Bus property-info
-     * is declared. Getting a defined ordering with some smart lookup would be hard. */
+     * The signal is not emitted right away. Instead, the properties are marked as dirty
+     * and emitted together with later changes by _obj_flush_properties_changed().
+     * That way, a burst of changes results in one PropertiesChanged signal per interface. */
     c_list_for_each_entry (reg_data, &obj->internal.registration_lst_head, registration_lst) {
         const NMDBusInterfaceInfoExtended *interface_info = _reg_data_get_interface_info(reg_data);
-        gboolean                           has_properties = FALSE;
-        GVariantBuilder                    builder;
-        GVariantBuilder                    invalidated_builder;
-        GVariant                          *args;
 
         if (!interface_info->parent.properties)
             continue;
@@ -1192,36 +1486,47 @@ _nm_dbus_manager_obj_notify(NMDBusObject *obj, guint n_pspecs, const GParamSpec
                 (const NMDBusPropertyInfoExtended *) interface_info->parent.properties[i];
 
             for (p = 0; p < n_pspecs; p++) {
-                const GParamSpec          *pspec = pspecs[p];
-                gs_unref_variant GVariant *value = NULL;
-
-                if (!nm_streq(property_info->property_name, pspec->name))
+                if (!nm_streq(property_info->property_name, pspecs[p]->name))
                     continue;
 
-                value = _obj_get_property(reg_data, i, TRUE);
-
-                if (!has_properties) {
-                    has_properties = TRUE;
-                    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
-                }
-                g_variant_builder_add(&builder, "{sv}", property_info->parent.name, value);
+                /* Properties.Get and GetManagedObjects must already see the new value. */
+                nm_clear_g_variant(&reg_data->property_cache[i].value);
+                nm_clear_g_variant(&reg_data->properties_value);
+                reg_data->property_cache[i].dirty = TRUE;
+                obj->internal.n_properties_notified++;
+                priv->n_properties_notified++;
+                has_dirty = TRUE;
             }
         }
+    }
 
-        if (!has_properties)
-            continue;
+    if (!has_dirty)
+        return;
 
-        args = g_variant_builder_end(&builder);
+    if (c_list_is_empty(&obj->internal.dirty_lst))
+        c_list_link_tail(&priv->dirty_objs_lst_head, &obj->internal.dirty_lst);
 
-        g_variant_builder_init(&invalidated_builder, G_VARIANT_TYPE("as"));
-        g_dbus_connection_emit_signal(
-            priv->main_dbus_connection,
-            NULL,
-            obj->internal.path,
-            DBUS_INTERFACE_PROPERTIES,
-            "PropertiesChanged",
-            g_variant_new("(s@a{sv}as)", interface_info->parent.name, args, &invalidated_builder),
-            NULL);
+    if (priv->n_pending_method_calls > 0) {
+        /* A method call waits for its reply. The change might be the result of
+         * that call, so the client must see the signal before the reply. */
+        _obj_flush_all_properties_changed(self);
+        return;
+    }
+
+    if (!priv->properties_changed_source) {
+        if (priv->properties_changed_delay_msec == 0) {
+            priv->properties_changed_source =
+                nm_g_source_attach(nm_g_idle_source_new(G_PRIORITY_DEFAULT,
+                                                        _obj_flush_properties_changed_cb,
+                                                        self,
+                                                        NULL),
+                                   NULL);
+        } else {
+            priv->properties_changed_source =
+                nm_g_timeout_add_source(priv->properties_changed_delay_msec,
+                                        _obj_flush_properties_changed_cb,
+                                        self);
+        }
     }
 }
 
@@ -1247,6 +1552,8 @@ _nm_dbus_manager_obj_emit_signal(NMDBusObject                      *obj,
         return;
     }
 
+    _obj_flush_all_properties_changed(self);
+
     g_dbus_connection_emit_signal(priv->main_dbus_connection,
                                   NULL,
                                   obj->internal.path,
@@ -1258,26 +1565,38 @@ _nm_dbus_manager_obj_emit_signal(NMDBusObject                      *obj,
 
 /*****************************************************************************/
 
-static GVariantBuilder *
-_obj_collect_properties_per_interface(NMDBusObject     *obj,
-                                      RegistrationData *reg_data,
-                                      GVariantBuilder  *builder)
+static GVariant *
+_obj_collect_properties_per_interface(RegistrationData *reg_data)
 {
-    const NMDBusInterfaceInfoExtended *interface_info = _reg_data_get_interface_info(reg_data);
+    const NMDBusInterfaceInfoExtended *interface_info;
+    NMDBusManagerPrivate              *priv;
+    GVariantBuilder                    builder;
     guint                              i;
 
-    g_variant_builder_init(builder, G_VARIANT_TYPE("a{sv}"));
+    /* Returns a (non-floating) reference that is owned by @reg_data. Repeated calls to
+     * GetManagedObjects() reuse the dictionaries of the unchanged interfaces. */
+    if (reg_data->properties_value)
+        return reg_data->properties_value;
+
+    interface_info = _reg_data_get_interface_info(reg_data);
+
+    priv = NM_DBUS_MANAGER_GET_PRIVATE(nm_dbus_object_get_manager(reg_data->obj));
+    priv->n_properties_values_built++;
+
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
     if (interface_info->parent.properties) {
         for (i = 0; interface_info->parent.properties[i]; i++) {
             const NMDBusPropertyInfoExtended *property_info =
                 (const NMDBusPropertyInfoExtended *) interface_info->parent.properties[i];
             gs_unref_variant GVariant *variant = NULL;
 
-            variant = _obj_get_property(reg_data, i, FALSE);
-            g_variant_builder_add(builder, "{sv}", property_info->parent.name, variant);
+            variant = _obj_get_property(reg_data, i);
+            g_variant_builder_add(&builder, "{sv}", property_info->parent.name, variant);
         }
     }
-    return builder;
+
+    reg_data->properties_value = g_variant_ref_sink(g_variant_builder_end(&builder));
+    return reg_data->properties_value;
 }
 
 static GVariantBuilder *
@@ -1288,13 +1607,10 @@ _obj_collect_properties_all(NMDBusObject *obj, GVariantBuilder *builder)
     g_variant_builder_init(builder, G_VARIANT_TYPE("a{sa{sv}}"));
 
     c_list_for_each_entry (reg_data, &obj->internal.registration_lst_head, registration_lst) {
-        GVariantBuilder properties_builder;
-
-        g_variant_builder_add(
-            builder,
-            "{sa{sv}}",
-            _reg_data_get_interface_info(reg_data)->parent.name,
-            _obj_collect_properties_per_interface(obj, reg_data, &properties_builder));
+        g_variant_builder_add(builder,
+                              "{s@a{sv}}",
+                              _reg_data_get_interface_info(reg_data)->parent.name,
+                              _obj_collect_properties_per_interface(reg_data));
     }
 
     return builder;
@@ -1502,6 +1818,18 @@ nm_dbus_manager_setup(NMDBusManager *self)
 
     priv->objmgr_registration_id = registration_id;
 
+    priv->name_owner_changed_id =
+        g_dbus_connection_signal_subscribe(priv->main_dbus_connection,
+                                           DBUS_SERVICE_DBUS,
+                                           DBUS_INTERFACE_DBUS,
+                                           "NameOwnerChanged",
+                                           DBUS_PATH_DBUS,
+                                           NULL,
+                                           G_DBUS_SIGNAL_FLAGS_NONE,
+                                           _name_owner_changed_cb,
+                                           self,
+                                           NULL);
+
     _LOGD("D-Bus connection created and ObjectManager object registered");
 
     return TRUE;
@@ -1514,6 +1842,13 @@ nm_dbus_manager_stop(NMDBusManager *self)
 
     priv->shutting_down = TRUE;
 
+    _LOGD("merged %" G_GUINT64_FORMAT " property notifications into %" G_GUINT64_FORMAT
+          " PropertiesChanged signals",
+          priv->n_properties_notified,
+          priv->n_properties_changed_emitted);
+    _LOGD("looked up the credentials of %" G_GUINT64_FORMAT " callers synchronously",
+          priv->n_blocking_caller_lookups);
+
     /* during shutdown we also clear the set-property-handler. It's no longer
      * possible to set a property, because doing so would require authorization,
      * which is async, which is just complicated to get right. No more property
@@ -1522,12 +1857,48 @@ nm_dbus_manager_stop(NMDBusManager *self)
     priv->set_property_handler_data = NULL;
 }
 
+/**
+ * nm_dbus_manager_set_properties_changed_delay:
+ * @self: the #NMDBusManager
+ * @delay_msec: the time in milliseconds to wait
+ *
+ * Property changes of exported objects are collected and sent together
+ * as PropertiesChanged signals. With a @delay_msec of zero, they are
+ * sent on the next main loop iteration. Otherwise, they are delayed by
+ * up to @delay_msec, which merges more changes into one signal.
+ */
+void
+nm_dbus_manager_set_properties_changed_delay(NMDBusManager *self, guint delay_msec)
+{
+    g_return_if_fail(NM_IS_DBUS_MANAGER(self));
+
+    NM_DBUS_MANAGER_GET_PRIVATE(self)->properties_changed_delay_msec = delay_msec;
+}
+
 gboolean
 nm_dbus_manager_is_stopping(NMDBusManager *self)
 {
     return NM_DBUS_MANAGER_GET_PRIVATE(self)->shutting_down;
 }
 
+void
+nm_dbus_manager_get_stats(NMDBusManager *self, NMDBusManagerStats *out_stats)
+{
+    NMDBusManagerPrivate *priv;
+
+    g_return_if_fail(NM_IS_DBUS_MANAGER(self));
+    g_return_if_fail(out_stats);
+
+    priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
+
+    *out_stats = (NMDBusManagerStats){
+        .n_blocking_caller_lookups    = priv->n_blocking_caller_lookups,
+        .n_properties_notified        = priv->n_properties_notified,
+        .n_properties_changed_emitted = priv->n_properties_changed_emitted,
+        .n_properties_values_built    = priv->n_properties_values_built,
+    };
+}
+
 /*****************************************************************************/
 
 static void
@@ -1537,11 +1908,13 @@ nm_dbus_manager_init(NMDBusManager *self)
 
     c_list_init(&priv->private_servers_lst_head);
     c_list_init(&priv->objects_lst_head);
+    c_list_init(&priv->dirty_objs_lst_head);
 
     priv->objects_by_path =
         g_hash_table_new((GHashFunc) _objects_by_path_hash, (GEqualFunc) _objects_by_path_equal);
 
-    c_list_init(&priv->caller_info_lst_head);
+    priv->caller_infos =
+        g_hash_table_new_full(nm_str_hash, g_str_equal, NULL, (GDestroyNotify) _caller_info_free);
 }
 
 static void
@@ -1551,11 +1924,15 @@ dispose(GObject *object)
     NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
     PrivateServer        *s, *s_safe;
     CallerInfo           *caller_info;
+    GHashTableIter        iter;
 
     /* All exported NMDBusObject instances keep the manager alive, so we don't
      * expect any remaining objects. */
     nm_assert(!priv->objects_by_path || g_hash_table_size(priv->objects_by_path) == 0);
     nm_assert(c_list_is_empty(&priv->objects_lst_head));
+    nm_assert(c_list_is_empty(&priv->dirty_objs_lst_head));
+
+    nm_clear_g_source_inst(&priv->properties_changed_source);
 
     nm_clear_pointer(&priv->objects_by_path, g_hash_table_destroy);
 
@@ -1567,13 +1944,32 @@ dispose(GObject *object)
                                             nm_steal_int(&priv->objmgr_registration_id));
     }
 
+    nm_clear_g_dbus_connection_signal(priv->main_dbus_connection, &priv->name_owner_changed_id);
+
+    if (priv->caller_infos) {
+        g_hash_table_iter_init(&iter, priv->caller_infos);
+        while (g_hash_table_iter_next(&iter, NULL, (gpointer *) &caller_info)) {
+            CallerInfoPendingCall *pending_call;
+
+            nm_clear_g_cancellable(&caller_info->cancellable);
+            while ((pending_call = c_list_first_entry(&caller_info->pending_lst_head,
+                                                      CallerInfoPendingCall,
+                                                      pending_lst))) {
+                c_list_unlink_stale(&pending_call->pending_lst);
+                g_dbus_method_invocation_return_error_literal(pending_call->invocation,
+                                                              G_DBUS_ERROR,
+                                                              G_DBUS_ERROR_FAILED,
+                                                              "NetworkManager is exiting");
+                g_object_unref(pending_call->obj);
+                nm_g_slice_free(pending_call);
+            }
+        }
+        nm_clear_pointer(&priv->caller_infos, g_hash_table_destroy);
+    }
+
     g_clear_object(&priv->main_dbus_connection);
 
     G_OBJECT_CLASS(nm_dbus_manager_parent_class)->dispose(object);
-
-    while ((caller_info =
-                c_list_first_entry(&priv->caller_info_lst_head, CallerInfo, caller_info_lst)))
-        _caller_info_free(caller_info);
 }
 
 static void
@@ -1606,6 +2002,19 @@ nm_dbus_manager_class_init(NMDBusManagerClass *klass)
                      G_TYPE_NONE,
                      1,
                      G_TYPE_POINTER);
+
+    /* Emitted with the unique name of a peer on the main D-Bus connection that
+     * disconnected from the bus. */
+    signals[SENDER_VANISHED] = g_signal_new(NM_DBUS_MANAGER_SENDER_VANISHED,
+                                            G_OBJECT_CLASS_TYPE(object_class),
+                                            G_SIGNAL_RUN_LAST,
+                                            0,
+                                            NULL,
+                                            NULL,
+                                            NULL,
+                                            G_TYPE_NONE,
+                                            1,
+                                            G_TYPE_STRING);
 }
 
 static NMAuthSubject *
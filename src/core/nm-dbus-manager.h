@@ -21,6 +21,7 @@
 
 #define NM_DBUS_MANAGER_PRIVATE_CONNECTION_NEW          "private-connection-new"
 #define NM_DBUS_MANAGER_PRIVATE_CONNECTION_DISCONNECTED "private-connection-disconnected"
+#define NM_DBUS_MANAGER_SENDER_VANISHED                 "sender-vanished"
 
 typedef struct _NMDBusManagerClass NMDBusManagerClass;
 
@@ -51,8 +52,27 @@ void nm_dbus_manager_start(NMDBusManager                  *self,
 
 void nm_dbus_manager_stop(NMDBusManager *self);
 
+void nm_dbus_manager_set_properties_changed_delay(NMDBusManager *self, guint delay_msec);
+
 gboolean nm_dbus_manager_is_stopping(NMDBusManager *self);
 
+typedef struct {
+    /* how often the caller's credentials were not yet known when a
+     * handler needed them, and had to be looked up synchronously. */
+    guint64 n_blocking_caller_lookups;
+
+    /* how many property notifications were merged into how many
+     * PropertiesChanged signals. */
+    guint64 n_properties_notified;
+    guint64 n_properties_changed_emitted;
+
+    /* how often the "a{sv}" dictionary of an interface was built for
+     * GetManagedObjects or InterfacesAdded, instead of being reused. */
+    guint64 n_properties_values_built;
+} NMDBusManagerStats;
+
+void nm_dbus_manager_get_stats(NMDBusManager *self, NMDBusManagerStats *out_stats);
+
 gpointer nm_dbus_manager_lookup_object(NMDBusManager *self, const char *path);
 
 gpointer
@@ -65,6 +65,15 @@ struct _NMDBusObjectInternal {
     CList          objects_lst;
     CList          registration_lst_head;
 
+    /* linked in the bus manager's list of objects with pending PropertiesChanged
+     * signals. */
+    CList dirty_lst;
+
+    /* statistics, how many property notifications were merged into how many
+     * PropertiesChanged signals. */
+    guint n_properties_notified;
+    guint n_properties_changed_emitted;
+
     /* we perform asynchronous operation on exported objects. For example, we receive
      * a Set property call, and asynchronously validate the operation. We must make
      * sure that when the authentication is complete, that we are still looking at
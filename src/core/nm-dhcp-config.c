@@ -79,19 +79,22 @@ nm_dhcp_config_get_addr_family(NMDhcpConfig *self)
 
 /*****************************************************************************/
 
+static GHashTable *
+_l3cd_get_lease_options(const NML3ConfigData *l3cd, int addr_family)
+{
+    if (!l3cd)
+        return NULL;
+    return nm_dhcp_lease_get_options(nm_l3_config_data_get_dhcp_lease(l3cd, addr_family));
+}
+
 static GVariant *
-_l3cd_to_options(const NML3ConfigData *l3cd, int addr_family)
+_lease_options_to_variant(GHashTable *lease_options)
 {
     GVariant *options;
 
     options = NULL;
-    if (l3cd) {
-        NMDhcpLease *lease;
-
-        lease = nm_l3_config_data_get_dhcp_lease(l3cd, addr_family);
-        if (lease)
-            options = nm_strdict_to_variant_asv(nm_dhcp_lease_get_options(lease));
-    }
+    if (lease_options)
+        options = nm_strdict_to_variant_asv(lease_options);
     if (!options)
         options = nm_g_variant_singleton_aLsvI();
     return g_variant_ref_sink(options);
@@ -103,6 +106,9 @@ nm_dhcp_config_set_lease(NMDhcpConfig *self, const NML3ConfigData *l3cd)
     nm_auto_unref_l3cd const NML3ConfigData *l3cd_old = NULL;
     gs_unref_variant GVariant               *options2 = NULL;
     NMDhcpConfigPrivate                     *priv;
+    GHashTable                              *lease_options_old;
+    GHashTable                              *lease_options;
+    int                                      addr_family;
 
     g_return_if_fail(NM_IS_DHCP_CONFIG(self));
 
@@ -111,11 +117,23 @@ nm_dhcp_config_set_lease(NMDhcpConfig *self, const NML3ConfigData *l3cd)
     if (priv->l3cd == l3cd)
         return;
 
+    addr_family = nm_dhcp_config_get_addr_family(self);
+
     l3cd_old = g_steal_pointer(&priv->l3cd);
     if (l3cd)
         priv->l3cd = nm_l3_config_data_ref_and_seal(l3cd);
 
-    options2 = _l3cd_to_options(priv->l3cd, nm_dhcp_config_get_addr_family(self));
+    lease_options_old = _l3cd_get_lease_options(l3cd_old, addr_family);
+    lease_options     = _l3cd_get_lease_options(priv->l3cd, addr_family);
+
+    /* The l3cd often changes while the lease options stay the same (for example,
+     * because a DHCPv6 lease got merged with the previous one). Compare the string
+     * dictionaries first, which is much cheaper than building the GVariant and
+     * comparing that. */
+    if (nm_utils_hashtable_equal(lease_options_old, lease_options, TRUE, g_str_equal))
+        return;
+
+    options2 = _lease_options_to_variant(lease_options);
 
     if (g_variant_equal(priv->options, options2))
         return;
@@ -203,7 +221,8 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
     case PROP_L3CD:
         /* construct-only */
         priv->l3cd    = nm_l3_config_data_ref_and_seal(g_value_get_pointer(value));
-        priv->options = _l3cd_to_options(priv->l3cd, nm_dhcp_config_get_addr_family(self));
+        priv->options = _lease_options_to_variant(
+            _l3cd_get_lease_options(priv->l3cd, nm_dhcp_config_get_addr_family(self)));
         break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
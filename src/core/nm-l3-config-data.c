@@ -101,6 +101,10 @@ struct _NML3ConfigData {
 
     int ref_count;
 
+    /* A hash over (part of) the content. It is computed lazily, and only
+     * for sealed instances. */
+    guint content_hash;
+
     union {
         struct {
             int dns_priority_6;
@@ -153,6 +157,8 @@ struct _NML3ConfigData {
 
     bool is_sealed : 1;
 
+    bool content_hash_valid : 1;
+
     bool has_routes_with_type_local_4_set : 1;
     bool has_routes_with_type_local_6_set : 1;
     bool has_routes_with_type_local_4_val : 1;
@@ -2455,11 +2461,70 @@ nm_l3_config_data_cmp_full(const NML3ConfigData *a,
      * - multi_idx
      * - ref_count
      * - is_sealed
+     * - content_hash
      */
 
     return 0;
 }
 
+static guint
+_content_hash_get(const NML3ConfigData *self)
+{
+    static const NMPObjectType obj_types[] = {
+        NMP_OBJECT_TYPE_IP4_ADDRESS,
+        NMP_OBJECT_TYPE_IP6_ADDRESS,
+        NMP_OBJECT_TYPE_IP4_ROUTE,
+        NMP_OBJECT_TYPE_IP6_ROUTE,
+    };
+    NMHashState h;
+    int         i;
+
+    nm_assert(self->is_sealed);
+
+    if (self->content_hash_valid)
+        return self->content_hash;
+
+    /* The hash only covers fields that nm_l3_config_data_cmp() compares
+     * in the same way. Instances that compare equal have the same hash. */
+    nm_hash_init(&h, 1517924059u);
+    nm_hash_update_vals(&h, self->ifindex, self->flags, self->mtu, self->ip6_mtu, self->source);
+    for (i = 0; i < (int) G_N_ELEMENTS(obj_types); i++) {
+        NMDedupMultiIter iter;
+        const NMPObject *obj;
+
+        nm_hash_update_val(&h, nm_l3_config_data_get_num_objs(self, obj_types[i]));
+        nm_l3_config_data_iter_obj_for_each (&iter, self, &obj, obj_types[i])
+            nmp_object_hash_update(obj, &h);
+    }
+
+    ((NML3ConfigData *) self)->content_hash       = nm_hash_complete(&h);
+    ((NML3ConfigData *) self)->content_hash_valid = TRUE;
+    return self->content_hash;
+}
+
+guint
+nm_l3_config_data_get_content_hash(const NML3ConfigData *self)
+{
+    g_return_val_if_fail(self, 0);
+    g_return_val_if_fail(self->is_sealed, 0);
+
+    return _content_hash_get(self);
+}
+
+gboolean
+nm_l3_config_data_equal(const NML3ConfigData *a, const NML3ConfigData *b)
+{
+    if (a == b)
+        return TRUE;
+
+    /* Sealed instances are immutable, so we can cache a content hash for them.
+     * If the hashes differ, the instances cannot be equal. */
+    if (a && b && a->is_sealed && b->is_sealed && _content_hash_get(a) != _content_hash_get(b))
+        return FALSE;
+
+    return nm_l3_config_data_cmp(a, b) == 0;
+}
+
 /*****************************************************************************/
 
 static const NMPObject *
@@ -217,11 +217,9 @@ nm_l3_config_data_cmp(const NML3ConfigData *a, const NML3ConfigData *b)
     return nm_l3_config_data_cmp_full(a, b, NM_L3_CONFIG_CMP_FLAGS_ALL);
 }
 
-static inline gboolean
-nm_l3_config_data_equal(const NML3ConfigData *a, const NML3ConfigData *b)
-{
-    return nm_l3_config_data_cmp(a, b) == 0;
-}
+gboolean nm_l3_config_data_equal(const NML3ConfigData *a, const NML3ConfigData *b);
+
+guint nm_l3_config_data_get_content_hash(const NML3ConfigData *self);
 
 /*****************************************************************************/
 
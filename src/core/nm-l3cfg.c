@@ -252,6 +252,19 @@ typedef struct _NML3CfgPrivate {
 
     const NML3ConfigData *combined_l3cd_commited;
 
+    /* The sorted L3ConfigData (each holding a reference on its l3cd) that were
+     * merged into combined_l3cd_merged, and the ACD state generation at that
+     * time. If neither changed, merging again gives the same result. */
+    GArray *combined_l3cd_merged_inputs;
+    guint64 combined_l3cd_merged_acd_generation;
+
+    /* How often the combined l3cd was merged, and how often that was skipped. */
+    guint64 combined_l3cd_n_merged;
+    guint64 combined_l3cd_n_skipped;
+
+    /* Bumped whenever something changes that _l3_hook_add_obj_cb() looks at. */
+    guint64 acd_generation;
+
     CList commit_type_lst_head;
 
     GHashTable *obj_state_hash;
@@ -2096,6 +2109,7 @@ _l3_acd_data_prune_one(NML3Cfg *self, AcdData *acd_data, gboolean all /* or only
     _LOGT_acd(acd_data, "removed");
     if (!g_hash_table_remove(self->priv.p->acd_lst_hash, acd_data))
         nm_assert_not_reached();
+    self->priv.p->acd_generation++;
     _acd_data_free(acd_data);
 }
 
@@ -2180,6 +2194,7 @@ _l3_acd_data_add(NML3Cfg              *self,
         c_list_link_tail(&self->priv.p->acd_lst_head, &acd_data->acd_lst);
         if (!g_hash_table_add(self->priv.p->acd_lst_hash, acd_data))
             nm_assert_not_reached();
+        self->priv.p->acd_generation++;
         acd_track = NULL;
     } else
         acd_track = _acd_data_find_track(acd_data, l3cd, obj, tag);
@@ -2424,6 +2439,7 @@ _nm_printf(5, 6) static void _l3_acd_data_state_set_full(NML3Cfg         *self,
 
     old_state            = acd_data->info.state;
     acd_data->info.state = state;
+    self->priv.p->acd_generation++;
     _nm_l3cfg_emit_signal_notify_acd_event_queue(self, acd_data);
 
     if (state == NM_L3_ACD_ADDR_STATE_EXTERNAL_REMOVED)
@@ -3476,6 +3492,33 @@ _l3_config_datas_get_sorted_cmp(gconstpointer p_a, gconstpointer p_b, gpointer u
     return nm_assert_unreachable_val(0);
 }
 
+static void
+_l3_config_datas_clear_func(gpointer data)
+{
+    L3ConfigData *l3_config_data = data;
+
+    nm_l3_config_data_unref(l3_config_data->l3cd);
+}
+
+static gboolean
+_l3_config_datas_merge_input_equal(const L3ConfigData *a, const L3ConfigData *b)
+{
+    /* Compare the fields that affect the merge result (the order is already
+     * covered by comparing the sorted arrays). */
+    return a->l3cd == b->l3cd && a->tag_confdata == b->tag_confdata
+           && a->config_flags == b->config_flags && a->merge_flags == b->merge_flags
+           && a->default_route_table_4 == b->default_route_table_4
+           && a->default_route_table_6 == b->default_route_table_6
+           && a->default_route_metric_4 == b->default_route_metric_4
+           && a->default_route_metric_6 == b->default_route_metric_6
+           && a->default_route_penalty_4 == b->default_route_penalty_4
+           && a->default_route_penalty_6 == b->default_route_penalty_6
+           && a->default_dns_priority_4 == b->default_dns_priority_4
+           && a->default_dns_priority_6 == b->default_dns_priority_6
+           && a->acd_defend_type_confdata == b->acd_defend_type_confdata
+           && a->acd_timeout_msec_confdata == b->acd_timeout_msec_confdata;
+}
+
 static void
 _l3_config_datas_remove_index_fast(GArray *arr, guint idx)
 {
@@ -3967,6 +4010,43 @@ _l3cfg_update_combined_config(NML3Cfg               *self,
         self->priv.p->changed_configs_acd_state = FALSE;
     }
 
+    if (self->priv.p->combined_l3cd_merged_inputs
+        && self->priv.p->combined_l3cd_merged_acd_generation == self->priv.p->acd_generation
+        && self->priv.p->combined_l3cd_merged_inputs->len == l3_config_datas_len) {
+        for (i = 0; i < l3_config_datas_len; i++) {
+            if (!_l3_config_datas_merge_input_equal(
+                    _l3_config_datas_at(self->priv.p->combined_l3cd_merged_inputs, i),
+                    l3_config_datas_arr[i]))
+                break;
+        }
+        if (i == l3_config_datas_len) {
+            /* The same configurations in the same order with the same ACD states
+             * were merged already. The result would be identical. */
+            _LOGT("IP configuration unchanged (skip merge of %u configurations)",
+                  l3_config_datas_len);
+            self->priv.p->combined_l3cd_n_skipped++;
+            goto out;
+        }
+    }
+
+    if (!self->priv.p->combined_l3cd_merged_inputs) {
+        self->priv.p->combined_l3cd_merged_inputs =
+            g_array_sized_new(FALSE, FALSE, sizeof(L3ConfigData), l3_config_datas_len);
+        g_array_set_clear_func(self->priv.p->combined_l3cd_merged_inputs,
+                               _l3_config_datas_clear_func);
+    } else
+        g_array_set_size(self->priv.p->combined_l3cd_merged_inputs, 0);
+    for (i = 0; i < l3_config_datas_len; i++) {
+        L3ConfigData *l3_config_data;
+
+        l3_config_data =
+            nm_g_array_append_new(self->priv.p->combined_l3cd_merged_inputs, L3ConfigData);
+        *l3_config_data      = *l3_config_datas_arr[i];
+        l3_config_data->l3cd = nm_l3_config_data_ref(l3_config_data->l3cd);
+    }
+    self->priv.p->combined_l3cd_merged_acd_generation = self->priv.p->acd_generation;
+    self->priv.p->combined_l3cd_n_merged++;
+
     if (l3_config_datas_len > 0) {
         L3ConfigMergeHookAddObjData hook_data = {
             .self      = self,
@@ -5378,6 +5458,15 @@ nm_l3cfg_get_combined_l3cd(NML3Cfg *self, gboolean get_commited)
     return self->priv.p->combined_l3cd_merged;
 }
 
+void
+nm_l3cfg_get_merge_stats(NML3Cfg *self, guint64 *out_n_merged, guint64 *out_n_skipped)
+{
+    nm_assert(NM_IS_L3CFG(self));
+
+    NM_SET_OUT(out_n_merged, self->priv.p->combined_l3cd_n_merged);
+    NM_SET_OUT(out_n_skipped, self->priv.p->combined_l3cd_n_skipped);
+}
+
 const NMPObject *
 nm_l3cfg_get_best_default_route(NML3Cfg *self, int addr_family, gboolean get_commited)
 {
@@ -5644,6 +5733,7 @@ finalize(GObject *object)
 
     nm_clear_l3cd(&self->priv.p->combined_l3cd_merged);
     nm_clear_l3cd(&self->priv.p->combined_l3cd_commited);
+    nm_clear_pointer(&self->priv.p->combined_l3cd_merged_inputs, g_array_unref);
 
     nm_clear_pointer(&self->priv.plobj, nmp_object_unref);
     nm_clear_pointer(&self->priv.plobj_next, nmp_object_unref);
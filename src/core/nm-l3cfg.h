@@ -438,6 +438,8 @@ void nm_l3cfg_commit_type_reset_update(NML3Cfg *self);
 
 const NML3ConfigData *nm_l3cfg_get_combined_l3cd(NML3Cfg *self, gboolean get_commited);
 
+void nm_l3cfg_get_merge_stats(NML3Cfg *self, guint64 *out_n_merged, guint64 *out_n_skipped);
+
 const NMPObject *
 nm_l3cfg_get_best_default_route(NML3Cfg *self, int addr_family, gboolean get_commited);
 
@@ -190,6 +190,9 @@ typedef struct {
 
     CList devices_lst_head;
 
+    /* Index of the devices in devices_lst_head by their ifindex. */
+    GHashTable *devices_by_ifindex;
+
     NMState            state;
     NMConfig          *config;
     NMConnectivity    *concheck_mgr;
@@ -1856,14 +1859,53 @@ nm_manager_get_device_by_ifindex(NMManager *self, int ifindex)
     NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
     NMDevice         *device;
 
-    if (ifindex > 0) {
-        c_list_for_each_entry (device, &priv->devices_lst_head, devices_lst) {
-            if (nm_device_get_ifindex(device) == ifindex)
-                return device;
+    if (ifindex <= 0)
+        return NULL;
+
+    device = g_hash_table_lookup(priv->devices_by_ifindex, GINT_TO_POINTER(ifindex));
+    nm_assert(!device || nm_device_get_ifindex(device) == ifindex);
+    return device;
+}
+
+static void
+_devices_by_ifindex_update(NMManager *self, NMDevice *device, gboolean removed)
+{
+    NMManagerPrivate *priv       = NM_MANAGER_GET_PRIVATE(self);
+    const int         ifindex    = removed ? 0 : nm_device_get_ifindex(device);
+    const int         ifindex_ix = device->devices_by_ifindex_key;
+    NMDevice         *candidate;
+
+    nm_assert(removed || !c_list_is_empty(&device->devices_lst));
+
+    if (ifindex_ix == ifindex)
+        return;
+
+    device->devices_by_ifindex_key = 0;
+
+    if (ifindex_ix > 0) {
+        nm_assert(g_hash_table_lookup(priv->devices_by_ifindex, GINT_TO_POINTER(ifindex_ix))
+                  == device);
+        g_hash_table_remove(priv->devices_by_ifindex, GINT_TO_POINTER(ifindex_ix));
+
+        /* Usually there is only one device per ifindex. If there is
+         * another one, it now takes the place in the index. */
+        c_list_for_each_entry (candidate, &priv->devices_lst_head, devices_lst) {
+            if (candidate != device && candidate->devices_by_ifindex_key == 0
+                && nm_device_get_ifindex(candidate) == ifindex_ix) {
+                candidate->devices_by_ifindex_key = ifindex_ix;
+                g_hash_table_insert(priv->devices_by_ifindex,
+                                    GINT_TO_POINTER(ifindex_ix),
+                                    candidate);
+                break;
+            }
         }
     }
 
-    return NULL;
+    if (ifindex > 0
+        && !g_hash_table_contains(priv->devices_by_ifindex, GINT_TO_POINTER(ifindex))) {
+        device->devices_by_ifindex_key = ifindex;
+        g_hash_table_insert(priv->devices_by_ifindex, GINT_TO_POINTER(ifindex), device);
+    }
 }
 
 static NMDevice *
@@ -2325,6 +2367,7 @@ remove_device(NMManager *self, NMDevice *device, gboolean quitting)
     _devcon_remove_device_all(self, device);
 
     c_list_unlink(&device->devices_lst);
+    _devices_by_ifindex_update(self, device, TRUE);
 
     _parent_notify_changed(self, device, TRUE);
 
@@ -4022,6 +4065,7 @@ add_device(NMManager *self, NMDevice *device, GError **error)
 
     nm_assert(c_list_is_empty(&device->devices_lst));
     c_list_link_tail(&priv->devices_lst_head, &device->devices_lst);
+    _devices_by_ifindex_update(self, device, FALSE);
 
     g_signal_connect(device,
                      NM_DEVICE_STATE_CHANGED,
@@ -4425,7 +4469,7 @@ platform_link_cb(NMPlatform     *platform,
     }
 }
 
-static void
+static guint
 platform_query_devices(NMManager *self)
 {
     NMManagerPrivate            *priv  = NM_MANAGER_GET_PRIVATE(self);
@@ -4437,7 +4481,7 @@ platform_query_devices(NMManager *self)
     guess_assume = nm_config_get_first_start(nm_config_get());
     links        = nm_platform_link_get_all(priv->platform);
     if (!links)
-        return;
+        return 0;
 
     for (i = 0; i < links->len; i++) {
         const NMPlatformLink          *elem = NMP_OBJECT_CAST_LINK(links->pdata[i]);
@@ -4464,6 +4508,8 @@ platform_query_devices(NMManager *self)
                             guess_assume && (!dev_state || !dev_state->connection_uuid),
                             dev_state);
     }
+
+    return links->len;
 }
 
 static void
@@ -6571,32 +6617,25 @@ fail:
     g_dbus_method_invocation_take_error(invocation, error);
 }
 
-static void
-impl_manager_activate_connection(NMDBusObject                      *obj,
-                                 const NMDBusInterfaceInfoExtended *interface_info,
-                                 const NMDBusMethodInfoExtended    *method_info,
-                                 GDBusConnection                   *dbus_connection,
-                                 const char                        *sender,
-                                 GDBusMethodInvocation             *invocation,
-                                 GVariant                          *parameters)
-{
-    NMManager                          *self      = NM_MANAGER(obj);
-    NMManagerPrivate                   *priv      = NM_MANAGER_GET_PRIVATE(self);
-    gs_unref_object NMActiveConnection *active    = NULL;
-    gs_unref_object NMAuthSubject      *subject   = NULL;
-    NMSettingsConnection               *sett_conn = NULL;
-    NMDevice                           *device    = NULL;
-    gboolean                            is_vpn    = FALSE;
-    GError                             *error     = NULL;
-    const char                         *connection_path;
-    const char                         *device_path;
-    const char                         *specific_object_path;
-
-    g_variant_get(parameters, "(&o&o&o)", &connection_path, &device_path, &specific_object_path);
-
-    connection_path      = nm_dbus_path_not_empty(connection_path);
-    specific_object_path = nm_dbus_path_not_empty(specific_object_path);
-    device_path          = nm_dbus_path_not_empty(device_path);
+static NMActiveConnection *
+_new_active_connection_for_user_request(NMManager             *self,
+                                        GDBusMethodInvocation *invocation,
+                                        const char            *connection_path,
+                                        const char            *device_path,
+                                        const char            *specific_object_path,
+                                        NMSettingsConnection **out_sett_conn,
+                                        NMAuthSubject        **out_subject,
+                                        GError               **error)
+{
+    NMManagerPrivate              *priv      = NM_MANAGER_GET_PRIVATE(self);
+    gs_unref_object NMAuthSubject *subject   = NULL;
+    NMSettingsConnection          *sett_conn = NULL;
+    NMDevice                      *device    = NULL;
+    NMActiveConnection            *active    = NULL;
+    gboolean                       is_vpn    = FALSE;
+
+    nm_assert(out_sett_conn && !*out_sett_conn);
+    nm_assert(out_subject && !*out_subject);
 
     /* If the connection path is given and valid, that connection is activated.
      * Otherwise, the "best" connection for the device is chosen and activated,
@@ -6606,32 +6645,34 @@ impl_manager_activate_connection(NMDBusObject                      *obj,
     if (connection_path) {
         sett_conn = nm_settings_get_connection_by_path(priv->settings, connection_path);
         if (!sett_conn) {
-            error = g_error_new_literal(NM_MANAGER_ERROR,
-                                        NM_MANAGER_ERROR_UNKNOWN_CONNECTION,
-                                        "Connection could not be found.");
-            goto error;
+            g_set_error_literal(error,
+                                NM_MANAGER_ERROR,
+                                NM_MANAGER_ERROR_UNKNOWN_CONNECTION,
+                                "Connection could not be found.");
+            goto out;
         }
     } else {
         /* If no connection is given, find a suitable connection for the given device path */
         if (!device_path) {
-            error = g_error_new_literal(
-                NM_MANAGER_ERROR,
-                NM_MANAGER_ERROR_UNKNOWN_DEVICE,
-                "Only devices may be activated without a specifying a connection");
-            goto error;
+            g_set_error_literal(error,
+                                NM_MANAGER_ERROR,
+                                NM_MANAGER_ERROR_UNKNOWN_DEVICE,
+                                "Only devices may be activated without a specifying a connection");
+            goto out;
         }
         device = nm_manager_get_device_by_path(self, device_path);
         if (!device) {
-            error = g_error_new(NM_MANAGER_ERROR,
-                                NM_MANAGER_ERROR_UNKNOWN_DEVICE,
-                                "Can not activate an unknown device '%s'",
-                                device_path);
-            goto error;
+            g_set_error(error,
+                        NM_MANAGER_ERROR,
+                        NM_MANAGER_ERROR_UNKNOWN_DEVICE,
+                        "Can not activate an unknown device '%s'",
+                        device_path);
+            goto out;
         }
 
-        sett_conn = nm_device_get_best_connection(device, specific_object_path, &error);
+        sett_conn = nm_device_get_best_connection(device, specific_object_path, error);
         if (!sett_conn)
-            goto error;
+            goto out;
     }
 
     subject = validate_activation_request(self,
@@ -6641,9 +6682,9 @@ impl_manager_activate_connection(NMDBusObject                      *obj,
                                           device_path,
                                           &device,
                                           &is_vpn,
-                                          &error);
+                                          error);
     if (!subject)
-        goto error;
+        goto out;
 
     active = _new_active_connection(self,
                                     is_vpn,
@@ -6656,7 +6697,42 @@ impl_manager_activate_connection(NMDBusObject                      *obj,
                                     NM_ACTIVATION_TYPE_MANAGED,
                                     NM_ACTIVATION_REASON_USER_REQUEST,
                                     _activation_bind_lifetime_to_profile_visibility(subject),
-                                    &error);
+                                    error);
+
+out:
+    *out_sett_conn = sett_conn;
+    *out_subject   = g_steal_pointer(&subject);
+    return active;
+}
+
+static void
+impl_manager_activate_connection(NMDBusObject                      *obj,
+                                 const NMDBusInterfaceInfoExtended *interface_info,
+                                 const NMDBusMethodInfoExtended    *method_info,
+                                 GDBusConnection                   *dbus_connection,
+                                 const char                        *sender,
+                                 GDBusMethodInvocation             *invocation,
+                                 GVariant                          *parameters)
+{
+    NMManager                          *self      = NM_MANAGER(obj);
+    gs_unref_object NMActiveConnection *active    = NULL;
+    gs_unref_object NMAuthSubject      *subject   = NULL;
+    NMSettingsConnection               *sett_conn = NULL;
+    GError                             *error     = NULL;
+    const char                         *connection_path;
+    const char                         *device_path;
+    const char                         *specific_object_path;
+
+    g_variant_get(parameters, "(&o&o&o)", &connection_path, &device_path, &specific_object_path);
+
+    active = _new_active_connection_for_user_request(self,
+                                                     invocation,
+                                                     nm_dbus_path_not_empty(connection_path),
+                                                     nm_dbus_path_not_empty(device_path),
+                                                     nm_dbus_path_not_empty(specific_object_path),
+                                                     &sett_conn,
+                                                     &subject,
+                                                     &error);
     if (!active)
         goto error;
 
@@ -6685,6 +6761,304 @@ error:
 
 /*****************************************************************************/
 
+/* Ports must be activated after their controller, otherwise activating the
+ * port would implicitly start another activation of the controller. The
+ * depth is the length of the controller chain (as far as it can be resolved
+ * by UUID), VPNs are sorted last as they may depend on any base device. */
+#define ACTIVATE_MANY_MAX_DEPTH 16u
+
+typedef struct {
+    NMActiveConnection   *active;
+    NMSettingsConnection *sett_conn;
+    char                 *error_msg;
+    guint                 idx;
+    guint                 depth;
+} ActivateManyItem;
+
+typedef struct {
+    ActivateManyItem *items;
+    guint             n_items;
+} ActivateManyData;
+
+static void
+_activate_many_data_free(ActivateManyData *data)
+{
+    guint i;
+
+    for (i = 0; i < data->n_items; i++) {
+        ActivateManyItem *item = &data->items[i];
+
+        g_clear_object(&item->active);
+        g_clear_object(&item->sett_conn);
+        g_free(item->error_msg);
+    }
+    g_free(data->items);
+    nm_g_slice_free(data);
+}
+
+static guint
+_activate_many_get_depth(NMManager *self, NMActiveConnection *active)
+{
+    NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
+    NMConnection     *connection;
+    guint             depth = 0;
+
+    connection = nm_active_connection_get_applied_connection(active);
+
+    if (_connection_is_vpn(connection))
+        return ACTIVATE_MANY_MAX_DEPTH + 1u;
+
+    while (depth < ACTIVATE_MANY_MAX_DEPTH) {
+        NMSettingConnection  *s_con = nm_connection_get_setting_connection(connection);
+        NMSettingsConnection *controller;
+        const char           *controller_str;
+
+        controller_str = s_con ? nm_setting_connection_get_controller(s_con) : NULL;
+        if (!controller_str)
+            break;
+
+        depth++;
+
+        controller = nm_settings_get_connection_by_uuid(priv->settings, controller_str);
+        if (!controller)
+            break;
+        connection = nm_settings_connection_get_connection(controller);
+    }
+
+    return depth;
+}
+
+static int
+_activate_many_item_cmp(gconstpointer pa, gconstpointer pb, gpointer user_data)
+{
+    const ActivateManyItem *a = *((const ActivateManyItem *const *) pa);
+    const ActivateManyItem *b = *((const ActivateManyItem *const *) pb);
+
+    NM_CMP_FIELD(a, b, depth);
+    NM_CMP_FIELD(a, b, idx);
+    return 0;
+}
+
+static void
+_activate_many_item_activate(NMManager        *self,
+                             NMAuthChain      *chain,
+                             gboolean          network_control_allowed,
+                             ActivateManyItem *item)
+{
+    gs_free_error GError *error = NULL;
+    NMAuthSubject        *subject;
+    const char           *wifi_permission;
+
+    subject = nm_active_connection_get_subject(item->active);
+
+    if (!network_control_allowed) {
+        error = g_error_new_literal(NM_MANAGER_ERROR,
+                                    NM_MANAGER_ERROR_PERMISSION_DENIED,
+                                    "Not authorized to control networking.");
+        goto fail;
+    }
+
+    wifi_permission = nm_utils_get_shared_wifi_permission(
+        nm_active_connection_get_applied_connection(item->active));
+    if (wifi_permission
+        && nm_auth_chain_get_result(chain, wifi_permission) != NM_AUTH_CALL_RESULT_YES) {
+        error = g_error_new_literal(NM_MANAGER_ERROR,
+                                    NM_MANAGER_ERROR_PERMISSION_DENIED,
+                                    "Not authorized to share connections via wifi.");
+        goto fail;
+    }
+
+    if (!_internal_activate_generic(self, item->active, &error))
+        goto fail;
+
+    nm_settings_connection_autoconnect_blocked_reason_set(
+        item->sett_conn,
+        NM_SETTINGS_AUTOCONNECT_BLOCKED_REASON_USER_REQUEST,
+        FALSE);
+    nm_audit_log_connection_op(NM_AUDIT_OP_CONN_ACTIVATE,
+                               item->sett_conn,
+                               TRUE,
+                               NULL,
+                               subject,
+                               NULL);
+    return;
+
+fail:
+    _delete_volatile_connection_do(self, item->sett_conn);
+
+    nm_audit_log_connection_op(NM_AUDIT_OP_CONN_ACTIVATE,
+                               item->sett_conn,
+                               FALSE,
+                               NULL,
+                               subject,
+                               error->message);
+    nm_active_connection_set_state_fail(item->active,
+                                        NM_ACTIVE_CONNECTION_STATE_REASON_UNKNOWN,
+                                        error->message);
+    item->error_msg = g_strdup(error->message);
+    g_clear_object(&item->active);
+}
+
+static void
+_activate_many_auth_cb(NMAuthChain *chain, GDBusMethodInvocation *invocation, gpointer user_data)
+{
+    NMManager                *self = NM_MANAGER(user_data);
+    ActivateManyData         *data;
+    gs_free ActivateManyItem **sorted = NULL;
+    GVariantBuilder           builder;
+    gboolean                  network_control_allowed;
+    guint                     n_sorted  = 0;
+    guint                     n_started = 0;
+    guint                     i;
+
+    nm_assert(G_IS_DBUS_METHOD_INVOCATION(invocation));
+
+    c_list_unlink(nm_auth_chain_parent_lst_list(chain));
+
+    data = nm_auth_chain_get_data(chain, "data");
+
+    network_control_allowed = (nm_auth_chain_get_result(chain, NM_AUTH_PERMISSION_NETWORK_CONTROL)
+                               == NM_AUTH_CALL_RESULT_YES);
+
+    sorted = g_new(ActivateManyItem *, data->n_items);
+    for (i = 0; i < data->n_items; i++) {
+        if (data->items[i].active)
+            sorted[n_sorted++] = &data->items[i];
+    }
+    g_qsort_with_data(sorted, n_sorted, sizeof(ActivateManyItem *), _activate_many_item_cmp, NULL);
+
+    for (i = 0; i < n_sorted; i++) {
+        _activate_many_item_activate(self, chain, network_control_allowed, sorted[i]);
+        if (sorted[i]->active)
+            n_started++;
+    }
+
+    _LOGD(LOGD_CORE,
+          "activate-connections: started %u of %u activations",
+          n_started,
+          data->n_items);
+
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("a(os)"));
+    for (i = 0; i < data->n_items; i++) {
+        const ActivateManyItem *item = &data->items[i];
+
+        g_variant_builder_add(&builder,
+                              "(os)",
+                              item->active ? nm_dbus_object_get_path(NM_DBUS_OBJECT(item->active))
+                                           : "/",
+                              item->error_msg ?: "");
+    }
+    g_dbus_method_invocation_return_value(invocation, g_variant_new("(a(os))", &builder));
+}
+
+static void
+impl_manager_activate_connections(NMDBusObject                      *obj,
+                                  const NMDBusInterfaceInfoExtended *interface_info,
+                                  const NMDBusMethodInfoExtended    *method_info,
+                                  GDBusConnection                   *dbus_connection,
+                                  const char                        *sender,
+                                  GDBusMethodInvocation             *invocation,
+                                  GVariant                          *parameters)
+{
+    NMManager                 *self                      = NM_MANAGER(obj);
+    NMManagerPrivate          *priv                      = NM_MANAGER_GET_PRIVATE(self);
+    gs_unref_variant GVariant *items                     = NULL;
+    gs_unref_variant GVariant *options                   = NULL;
+    gboolean                   need_wifi_share_open      = FALSE;
+    gboolean                   need_wifi_share_protected = FALSE;
+    ActivateManyData          *data;
+    NMAuthChain               *chain;
+    GVariantIter               iter;
+    const char                *connection_path;
+    const char                *device_path;
+    const char                *specific_object_path;
+    guint                      i;
+
+    g_variant_get(parameters, "(@a(ooo)@a{sv})", &items, &options);
+
+    if (g_variant_n_children(options) > 0) {
+        g_dbus_method_invocation_return_error_literal(invocation,
+                                                      NM_MANAGER_ERROR,
+                                                      NM_MANAGER_ERROR_INVALID_ARGUMENTS,
+                                                      "Unknown extra option passed");
+        return;
+    }
+
+    chain = nm_auth_chain_new_context(invocation, _activate_many_auth_cb, self);
+    if (!chain) {
+        g_dbus_method_invocation_return_error_literal(invocation,
+                                                      NM_MANAGER_ERROR,
+                                                      NM_MANAGER_ERROR_PERMISSION_DENIED,
+                                                      NM_UTILS_ERROR_MSG_REQ_UID_UKNOWN);
+        return;
+    }
+
+    data          = g_slice_new(ActivateManyData);
+    data->n_items = g_variant_n_children(items);
+    data->items   = g_new0(ActivateManyItem, data->n_items);
+
+    /* Create all active connections up front. Each item is validated like
+     * with ActivateConnection(), but the authorization is done only once per
+     * polkit action for the entire batch. */
+    i = 0;
+    g_variant_iter_init(&iter, items);
+    while (g_variant_iter_next(&iter,
+                               "(&o&o&o)",
+                               &connection_path,
+                               &device_path,
+                               &specific_object_path)) {
+        ActivateManyItem              *item      = &data->items[i];
+        gs_unref_object NMAuthSubject *subject   = NULL;
+        gs_free_error GError          *error     = NULL;
+        NMSettingsConnection          *sett_conn = NULL;
+        const char                    *wifi_permission;
+
+        item->idx    = i++;
+        item->active = _new_active_connection_for_user_request(
+            self,
+            invocation,
+            nm_dbus_path_not_empty(connection_path),
+            nm_dbus_path_not_empty(device_path),
+            nm_dbus_path_not_empty(specific_object_path),
+            &sett_conn,
+            &subject,
+            &error);
+        if (!item->active) {
+            if (sett_conn) {
+                nm_audit_log_connection_op(NM_AUDIT_OP_CONN_ACTIVATE,
+                                           sett_conn,
+                                           FALSE,
+                                           NULL,
+                                           subject,
+                                           error->message);
+            }
+            item->error_msg = g_strdup(error->message);
+            continue;
+        }
+
+        item->sett_conn = g_object_ref(sett_conn);
+        item->depth     = _activate_many_get_depth(self, item->active);
+
+        wifi_permission = nm_utils_get_shared_wifi_permission(
+            nm_active_connection_get_applied_connection(item->active));
+        if (nm_streq0(wifi_permission, NM_AUTH_PERMISSION_WIFI_SHARE_OPEN))
+            need_wifi_share_open = TRUE;
+        else if (nm_streq0(wifi_permission, NM_AUTH_PERMISSION_WIFI_SHARE_PROTECTED))
+            need_wifi_share_protected = TRUE;
+    }
+    nm_assert(i == data->n_items);
+
+    c_list_link_tail(&priv->auth_lst_head, nm_auth_chain_parent_lst_list(chain));
+    nm_auth_chain_set_data(chain, "data", data, (GDestroyNotify) _activate_many_data_free);
+    nm_auth_chain_add_call(chain, NM_AUTH_PERMISSION_NETWORK_CONTROL, TRUE);
+    if (need_wifi_share_open)
+        nm_auth_chain_add_call(chain, NM_AUTH_PERMISSION_WIFI_SHARE_OPEN, TRUE);
+    if (need_wifi_share_protected)
+        nm_auth_chain_add_call(chain, NM_AUTH_PERMISSION_WIFI_SHARE_PROTECTED, TRUE);
+}
+
+/*****************************************************************************/
+
 static void
 activation_add_done(NMSettings            *settings,
                     NMSettingsConnection  *new_connection,
@@ -8020,16 +8394,34 @@ devices_inited_cb(gpointer user_data)
     return G_SOURCE_REMOVE;
 }
 
+static gint64
+_startup_timeline_phase(NMManager *self, gint64 phase_start_nsec, const char *phase)
+{
+    const gint64 now_nsec = nm_utils_get_monotonic_timestamp_nsec();
+
+    _LOGD(LOGD_CORE,
+          "startup: %s took %.3f msec",
+          phase,
+          ((double) (now_nsec - phase_start_nsec)) / NM_UTILS_NSEC_PER_MSEC);
+    return now_nsec;
+}
+
 gboolean
 nm_manager_start(NMManager *self, GError **error)
 {
-    NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
+    NMManagerPrivate *priv       = NM_MANAGER_GET_PRIVATE(self);
+    const gint64      start_nsec = nm_utils_get_monotonic_timestamp_nsec();
+    gint64            phase_nsec = start_nsec;
+    char              sbuf[100];
+    guint             n_links;
     guint             i;
 
     nm_device_factory_manager_load_factories(_register_device_factory, self);
 
     nm_device_factory_manager_for_each_factory(start_factory, NULL);
 
+    phase_nsec = _startup_timeline_phase(self, phase_nsec, "loading device factories");
+
     /* Set initial radio enabled/disabled state */
     for (i = 0; i < NM_RFKILL_TYPE_MAX; i++) {
         const NMRfkillType rtype  = i;
@@ -8054,17 +8446,28 @@ nm_manager_start(NMManager *self, GError **error)
 
     _static_hostname_changed_cb(priv->hostname_manager, NULL, self);
 
+    phase_nsec = _startup_timeline_phase(self, phase_nsec, "initializing radio and host state");
+
     if (!nm_settings_start(priv->settings, error))
         return FALSE;
 
+    phase_nsec = _startup_timeline_phase(self, phase_nsec, "loading settings");
+
     nm_platform_process_events(priv->platform);
 
+    phase_nsec = _startup_timeline_phase(self, phase_nsec, "processing platform events");
+
     g_signal_connect(priv->platform,
                      NM_PLATFORM_SIGNAL_LINK_CHANGED,
                      G_CALLBACK(platform_link_cb),
                      self);
 
-    platform_query_devices(self);
+    n_links = platform_query_devices(self);
+
+    phase_nsec =
+        _startup_timeline_phase(self,
+                                phase_nsec,
+                                nm_sprintf_buf(sbuf, "realizing devices for %u links", n_links));
 
     /* Load VPN plugins */
     priv->vpn_manager = g_object_ref(nm_vpn_manager_get());
@@ -8083,6 +8486,9 @@ nm_manager_start(NMManager *self, GError **error)
      * that they could be autoconnected.  */
     connections_changed(self);
 
+    _startup_timeline_phase(self, phase_nsec, "creating virtual devices");
+    _startup_timeline_phase(self, start_nsec, "starting the manager");
+
     nm_clear_g_source(&priv->devices_inited_id);
     priv->devices_inited_id = g_idle_add_full(G_PRIORITY_LOW + 10, devices_inited_cb, self, NULL);
 
@@ -8769,6 +9175,16 @@ nm_manager_set_capability(NMManager *self, NMCapability cap)
     _notify(self, PROP_CAPABILITIES);
 }
 
+/* Must be called by NMDevice right after it changed its ifindex, so that
+ * nm_manager_get_device_by_ifindex() already finds the device for the new
+ * ifindex while the device still reconfigures itself. */
+void
+nm_manager_update_device_ifindex(NMManager *self, NMDevice *device)
+{
+    if (!c_list_is_empty(&device->devices_lst))
+        _devices_by_ifindex_update(self, device, FALSE);
+}
+
 void
 nm_manager_emit_device_ifindex_changed(NMManager *self, NMDevice *device)
 {
@@ -8920,6 +9336,7 @@ nm_manager_init(NMManager *self)
     c_list_init(&priv->auth_lst_head);
     c_list_init(&priv->link_cb_lst);
     c_list_init(&priv->devices_lst_head);
+    priv->devices_by_ifindex = g_hash_table_new(nm_direct_hash, NULL);
     c_list_init(&priv->active_connections_lst_head);
     c_list_init(&priv->async_op_lst_head);
     c_list_init(&priv->delete_volatile_connection_lst_head);
@@ -9281,6 +9698,7 @@ dispose(GObject *object)
     nm_clear_pointer(&priv->device_route_metrics, g_hash_table_destroy);
 
     nm_clear_pointer(&priv->devcon_data_dict, g_hash_table_destroy);
+    nm_clear_pointer(&priv->devices_by_ifindex, g_hash_table_destroy);
 
     G_OBJECT_CLASS(nm_manager_parent_class)->dispose(object);
 }
@@ -9350,6 +9768,15 @@ static const NMDBusInterfaceInfoExtended interface_info_manager = {
                     .out_args = NM_DEFINE_GDBUS_ARG_INFOS(
                         NM_DEFINE_GDBUS_ARG_INFO("active_connection", "o"), ), ),
                 .handle = impl_manager_activate_connection, ),
+            NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
+                NM_DEFINE_GDBUS_METHOD_INFO_INIT(
+                    "ActivateConnections",
+                    .in_args = NM_DEFINE_GDBUS_ARG_INFOS(
+                        NM_DEFINE_GDBUS_ARG_INFO("items", "a(ooo)"),
+                        NM_DEFINE_GDBUS_ARG_INFO("options", "a{sv}"), ),
+                    .out_args =
+                        NM_DEFINE_GDBUS_ARG_INFOS(NM_DEFINE_GDBUS_ARG_INFO("results", "a(os)"), ), ),
+                .handle = impl_manager_activate_connections, ),
             NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
                 NM_DEFINE_GDBUS_METHOD_INFO_INIT(
                     "AddAndActivateConnection",
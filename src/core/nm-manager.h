@@ -190,6 +190,7 @@ gboolean nm_manager_deactivate_connection(NMManager          *manager,
                                           GError            **error);
 
 void nm_manager_set_capability(NMManager *self, NMCapability cap);
+void nm_manager_update_device_ifindex(NMManager *self, NMDevice *device);
 void nm_manager_emit_device_ifindex_changed(NMManager *self, NMDevice *device);
 
 NMDevice *nm_manager_get_device(NMManager *self, const char *ifname, NMDeviceType device_type);
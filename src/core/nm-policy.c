@@ -69,6 +69,10 @@ typedef struct {
 
     GSource *device_recheck_auto_activate_all_idle_source;
 
+    /* Controller UUIDs and interface names of added or updated profiles, whose
+     * ports get unblocked on the next device_recheck_auto_activate_all_idle_source. */
+    GHashTable *pending_port_controllers;
+
     GSource *reset_connections_retries_idle_source;
 
     NMHostnameManager *hostname_manager;
@@ -2001,8 +2005,8 @@ unblock_autoconnect_for_ports(NMPolicy   *self,
 static void
 unblock_autoconnect_for_ports_for_sett_conn(NMPolicy *self, NMSettingsConnection *sett_conn)
 {
+    NMPolicyPrivate     *priv = NM_POLICY_GET_PRIVATE(self);
     const char          *controller_device;
-    const char          *controller_uuid_settings;
     NMSettingConnection *s_con;
 
     nm_assert(NM_IS_POLICY(self));
@@ -2012,10 +2016,57 @@ unblock_autoconnect_for_ports_for_sett_conn(NMPolicy *self, NMSettingsConnection
 
     nm_assert(NM_IS_SETTING_CONNECTION(s_con));
 
-    controller_uuid_settings = nm_setting_connection_get_uuid(s_con);
-    controller_device        = nm_setting_connection_get_interface_name(s_con);
+    /* Scanning all profiles for ports is O(n). When many profiles get added
+     * or updated at once, that would be O(n^2). Instead, remember the controller
+     * and handle all of them together in _device_recheck_auto_activate_all_cb(). */
+    if (!priv->pending_port_controllers)
+        priv->pending_port_controllers =
+            g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, NULL);
+
+    g_hash_table_add(priv->pending_port_controllers,
+                     g_strdup(nm_setting_connection_get_uuid(s_con)));
+    controller_device = nm_setting_connection_get_interface_name(s_con);
+    if (controller_device)
+        g_hash_table_add(priv->pending_port_controllers, g_strdup(controller_device));
 
-    unblock_autoconnect_for_ports(self, controller_device, controller_uuid_settings, NULL, TRUE);
+    nm_policy_device_recheck_auto_activate_all_schedule(self);
+}
+
+static void
+unblock_autoconnect_for_ports_pending(NMPolicy *self)
+{
+    NMPolicyPrivate               *priv        = NM_POLICY_GET_PRIVATE(self);
+    gs_unref_hashtable GHashTable *controllers = NULL;
+    NMSettingsConnection *const   *connections;
+    guint                          i;
+
+    controllers = g_steal_pointer(&priv->pending_port_controllers);
+    if (!controllers)
+        return;
+
+    _LOGT(LOGD_CORE,
+          "block-autoconnect: unblocking port profiles for %u pending controllers",
+          g_hash_table_size(controllers));
+
+    connections = nm_settings_get_connections(priv->settings, NULL);
+    for (i = 0; connections[i]; i++) {
+        NMSettingsConnection *sett_conn = connections[i];
+        NMSettingConnection  *s_port_con;
+        const char           *port_controller;
+
+        s_port_con = nm_settings_connection_get_setting(sett_conn, NM_META_SETTING_TYPE_CONNECTION);
+        port_controller = nm_setting_connection_get_controller(s_port_con);
+        if (!port_controller || !g_hash_table_contains(controllers, port_controller))
+            continue;
+
+        nm_manager_devcon_autoconnect_retries_reset(priv->manager, NULL, sett_conn);
+        nm_manager_devcon_autoconnect_blocked_reason_set(
+            priv->manager,
+            NULL,
+            sett_conn,
+            NM_SETTINGS_AUTOCONNECT_BLOCKED_REASON_FAILED,
+            FALSE);
+    }
 }
 
 static void
@@ -2748,6 +2799,10 @@ _device_recheck_auto_activate_all_cb(gpointer user_data)
 
     nm_clear_g_source_inst(&priv->device_recheck_auto_activate_all_idle_source);
 
+    /* We are about to recheck all devices anyway, so there is no need to
+     * track whether unblocking the ports changed anything. */
+    unblock_autoconnect_for_ports_pending(self);
+
     nm_manager_for_each_device (priv->manager, device, tmp_lst)
         nm_policy_device_recheck_auto_activate_schedule(self, device);
 
@@ -3151,6 +3206,7 @@ dispose(GObject *object)
 
     nm_clear_g_source_inst(&priv->reset_connections_retries_idle_source);
     nm_clear_g_source_inst(&priv->device_recheck_auto_activate_all_idle_source);
+    nm_clear_pointer(&priv->pending_port_controllers, g_hash_table_unref);
     nm_clear_g_source_inst(&priv->hostname_retry.source);
 
     nm_clear_g_free(&priv->orig_hostname);
@@ -136,6 +136,8 @@ sysctl_set(NMPlatform *platform, const char *pathid, int dirfd, const char *path
 
     ASSERT_SYSCTL_ARGS(pathid, dirfd, path);
 
+    nm_platform_sysctl_account(platform, 0, 1);
+
     g_hash_table_insert(priv->options, g_strdup(path), g_strdup(value));
 
     return TRUE;
@@ -149,6 +151,8 @@ sysctl_get(NMPlatform *platform, const char *pathid, int dirfd, const char *path
 
     ASSERT_SYSCTL_ARGS(pathid, dirfd, path);
 
+    nm_platform_sysctl_account(platform, 1, 0);
+
     v = g_hash_table_lookup(priv->options, path);
     if (!v) {
         errno = ENOENT;
@@ -201,6 +201,135 @@ test_qdisc_tbf(void)
     g_assert_cmpint(qdisc->handle, ==, TC_H_MAKE(0x8005 << 16, 0));
 }
 
+static guint64
+tc_n_requests(void)
+{
+    guint64 n_requests;
+
+    nm_platform_tc_get_stats(NM_PLATFORM_GET, &n_requests);
+    return n_requests;
+}
+
+static void
+test_qdisc_sync_unchanged(void)
+{
+    int                          ifindex;
+    gs_unref_ptrarray GPtrArray *known = NULL;
+    gs_unref_ptrarray GPtrArray *plat1 = NULL;
+    gs_unref_ptrarray GPtrArray *plat2 = NULL;
+    gs_unref_ptrarray GPtrArray *plat3 = NULL;
+    gs_unref_ptrarray GPtrArray *plat4 = NULL;
+    gs_unref_ptrarray GPtrArray *plat5 = NULL;
+    gs_unref_ptrarray GPtrArray *plat6 = NULL;
+    NMPObject                   *obj;
+    NMPlatformQdisc             *qdisc;
+    guint64                      n_requests;
+
+    ifindex = nm_platform_link_get_ifindex(NM_PLATFORM_GET, DEVICE_NAME);
+    g_assert_cmpint(ifindex, >, 0);
+
+    nmtstp_run_command("tc qdisc del dev %s root", DEVICE_NAME);
+
+    nmtstp_wait_for_signal(NM_PLATFORM_GET, 0);
+
+    known                = g_ptr_array_new_with_free_func((GDestroyNotify) nmp_object_unref);
+    obj                  = qdisc_new(ifindex, "tbf", TC_H_ROOT);
+    obj->qdisc.handle    = TC_H_MAKE(0x8143 << 16, 0);
+    obj->qdisc.tbf.rate  = 1000000;
+    obj->qdisc.tbf.burst = 2000;
+    obj->qdisc.tbf.limit = 3000;
+    g_ptr_array_add(known, obj);
+
+    obj               = qdisc_new(ifindex, "sfq", TC_H_MAKE(0x8143 << 16, 0));
+    obj->qdisc.handle = TC_H_MAKE(0x8005 << 16, 0);
+    g_ptr_array_add(known, obj);
+
+    /* The kernel's default root qdisc is replaced, and the child added. */
+    n_requests = tc_n_requests();
+    g_assert(nm_platform_tc_sync(NM_PLATFORM_GET, ifindex, known, NULL));
+    g_assert_cmpint(tc_n_requests() - n_requests, ==, 2);
+    plat1 = qdiscs_lookup(ifindex);
+    g_assert(plat1);
+    g_assert_cmpint(plat1->len, ==, 2);
+
+    /* Syncing the same configuration again sends no requests. */
+    n_requests = tc_n_requests();
+    g_assert(nm_platform_tc_sync(NM_PLATFORM_GET, ifindex, known, NULL));
+    g_assert_cmpint(tc_n_requests() - n_requests, ==, 0);
+    nmtstp_wait_for_signal(NM_PLATFORM_GET, 50);
+    plat2 = qdiscs_lookup(ifindex);
+    g_assert(plat2);
+    g_assert_cmpint(plat2->len, ==, 2);
+    g_assert(plat1->pdata[0] == plat2->pdata[0]);
+    g_assert(plat1->pdata[1] == plat2->pdata[1]);
+
+    /* A changed qdisc is replaced in place, without touching its child. */
+    obj                 = known->pdata[0];
+    obj->qdisc.tbf.rate = 2000000;
+    n_requests          = tc_n_requests();
+    g_assert(nm_platform_tc_sync(NM_PLATFORM_GET, ifindex, known, NULL));
+    g_assert_cmpint(tc_n_requests() - n_requests, ==, 1);
+    plat3 = qdiscs_lookup(ifindex);
+    g_assert(plat3);
+    g_assert_cmpint(plat3->len, ==, 2);
+    qdisc = NMP_OBJECT_CAST_QDISC(plat3->pdata[0]);
+    g_assert_cmpstr(qdisc->kind, ==, "tbf");
+    g_assert_cmpint(qdisc->handle, ==, TC_H_MAKE(0x8143 << 16, 0));
+    g_assert_cmpint(qdisc->tbf.rate, ==, 2000000);
+    qdisc = NMP_OBJECT_CAST_QDISC(plat3->pdata[1]);
+    g_assert_cmpstr(qdisc->kind, ==, "sfq");
+    g_assert_cmpint(qdisc->handle, ==, TC_H_MAKE(0x8005 << 16, 0));
+
+    /* An external change of the parameters is reverted. */
+    nmtstp_run_command_check("tc qdisc change dev %s root handle 8143: tbf rate 4mbit burst 2000 "
+                             "limit 3000",
+                             DEVICE_NAME);
+    nmtstp_wait_for_signal(NM_PLATFORM_GET, 50);
+    n_requests = tc_n_requests();
+    g_assert(nm_platform_tc_sync(NM_PLATFORM_GET, ifindex, known, NULL));
+    g_assert_cmpint(tc_n_requests() - n_requests, ==, 1);
+    plat4 = qdiscs_lookup(ifindex);
+    g_assert(plat4);
+    g_assert_cmpint(plat4->len, ==, 2);
+    qdisc = NMP_OBJECT_CAST_QDISC(plat4->pdata[0]);
+    g_assert_cmpstr(qdisc->kind, ==, "tbf");
+    g_assert_cmpint(qdisc->tbf.rate, ==, 2000000);
+
+    /* After an external removal, the configuration is restored. */
+    nmtstp_run_command_check("tc qdisc del dev %s root", DEVICE_NAME);
+    nmtstp_wait_for_signal(NM_PLATFORM_GET, 50);
+    n_requests = tc_n_requests();
+    g_assert(nm_platform_tc_sync(NM_PLATFORM_GET, ifindex, known, NULL));
+    g_assert_cmpint(tc_n_requests() - n_requests, ==, 2);
+    plat5 = qdiscs_lookup(ifindex);
+    g_assert(plat5);
+    g_assert_cmpint(plat5->len, ==, 2);
+    qdisc = NMP_OBJECT_CAST_QDISC(plat5->pdata[0]);
+    g_assert_cmpstr(qdisc->kind, ==, "tbf");
+    g_assert_cmpint(qdisc->handle, ==, TC_H_MAKE(0x8143 << 16, 0));
+    qdisc = NMP_OBJECT_CAST_QDISC(plat5->pdata[1]);
+    g_assert_cmpstr(qdisc->kind, ==, "sfq");
+    g_assert_cmpint(qdisc->handle, ==, TC_H_MAKE(0x8005 << 16, 0));
+
+    /* Once the result is in the cache again, a sync is a no-op. */
+    n_requests = tc_n_requests();
+    g_assert(nm_platform_tc_sync(NM_PLATFORM_GET, ifindex, known, NULL));
+    g_assert_cmpint(tc_n_requests() - n_requests, ==, 0);
+
+    /* A qdisc that is no longer configured is deleted, its parent is kept. */
+    g_ptr_array_remove_index(known, 1);
+    n_requests = tc_n_requests();
+    g_assert(nm_platform_tc_sync(NM_PLATFORM_GET, ifindex, known, NULL));
+    g_assert_cmpint(tc_n_requests() - n_requests, ==, 1);
+    nmtstp_wait_for_signal(NM_PLATFORM_GET, 50);
+    plat6 = qdiscs_lookup(ifindex);
+    g_assert(plat6);
+    g_assert_cmpint(plat6->len, ==, 1);
+    qdisc = NMP_OBJECT_CAST_QDISC(plat6->pdata[0]);
+    g_assert_cmpstr(qdisc->kind, ==, "tbf");
+    g_assert_cmpint(qdisc->handle, ==, TC_H_MAKE(0x8143 << 16, 0));
+}
+
 /*****************************************************************************/
 
 NMTstpSetupFunc const _nmtstp_setup_platform_func = nm_linux_platform_setup_with_tc_cache;
@@ -218,4 +347,5 @@ _nmtstp_setup_tests(void)
     nmtstp_env1_add_test_func("/link/qdisc/fq_codel", test_qdisc_fq_codel, 1, TRUE);
     nmtstp_env1_add_test_func("/link/qdisc/sfq", test_qdisc_sfq, 1, TRUE);
     nmtstp_env1_add_test_func("/link/qdisc/tbf", test_qdisc_tbf, 1, TRUE);
+    nmtstp_env1_add_test_func("/link/qdisc/sync-unchanged", test_qdisc_sync_unchanged, 1, TRUE);
 }
@@ -437,7 +437,7 @@ _nm_settings_connection_set_connection(NMSettingsConnection            *self,
         nm_assert_connection_unchanging(priv->connection);
 
         _getsettings_cached_clear(priv);
-        _nm_settings_notify_sorted_by_autoconnect_priority_maybe_changed(priv->settings);
+        _nm_settings_notify_autoconnect_priority_changed(priv->settings, self);
 
         /* note that we only return @connection_old if the new connection actually differs from
          * before.
@@ -1397,21 +1397,12 @@ auth_start(NMSettingsConnection  *self,
 
 /**** DBus method handlers ************************************/
 
-static void
-get_settings_auth_cb(NMSettingsConnection  *self,
-                     GDBusMethodInvocation *context,
-                     NMAuthSubject         *subject,
-                     GError                *error,
-                     gpointer               data)
+static GVariant *
+_getsettings_get(NMSettingsConnection *self)
 {
     const char                      *seen_bssids_strv[SEEN_BSSIDS_MAX + 1];
     NMConnectionSerializationOptions options = {};
 
-    if (error) {
-        g_dbus_method_invocation_return_gerror(context, error);
-        return;
-    }
-
     /* Timestamp is not updated in connection's 'timestamp' property,
      * because it would force updating the connection and in turn
      * writing to /etc periodically, which we want to avoid. Rather real
@@ -1433,7 +1424,38 @@ get_settings_auth_cb(NMSettingsConnection  *self,
      * protected against leakage of secrets to unprivileged callers.
      */
 
-    g_dbus_method_invocation_return_value(context, _getsettings_cached_get(self, &options));
+    return _getsettings_cached_get(self, &options);
+}
+
+/**
+ * nm_settings_connection_get_settings_dbus:
+ * @self: the #NMSettingsConnection
+ *
+ * Returns: (transfer full): the settings as returned by the GetSettings()
+ *   D-Bus method, of type "a{sa{sv}}". The caller must check first
+ *   that the requester may see the connection.
+ */
+GVariant *
+nm_settings_connection_get_settings_dbus(NMSettingsConnection *self)
+{
+    g_return_val_if_fail(NM_IS_SETTINGS_CONNECTION(self), NULL);
+
+    return g_variant_get_child_value(_getsettings_get(self), 0);
+}
+
+static void
+get_settings_auth_cb(NMSettingsConnection  *self,
+                     GDBusMethodInvocation *context,
+                     NMAuthSubject         *subject,
+                     GError                *error,
+                     gpointer               data)
+{
+    if (error) {
+        g_dbus_method_invocation_return_gerror(context, error);
+        return;
+    }
+
+    g_dbus_method_invocation_return_value(context, _getsettings_get(self));
 }
 
 static void
@@ -1498,6 +1520,57 @@ update_complete(NMSettingsConnection *self, UpdateInfo *info, GError *error)
     nm_g_slice_free(info);
 }
 
+/**
+ * nm_settings_connection_merge_secrets_for_update:
+ * @self: the #NMSettingsConnection
+ * @new_connection: the new settings that are about to replace the profile
+ *
+ * If @new_connection carries no secrets, the existing secrets of @self are
+ * merged into it, so that an update without secrets does not clear them.
+ * Otherwise the new secrets are cached as agent secrets and a
+ * "no-secrets" autoconnect blocking is lifted.
+ */
+void
+nm_settings_connection_merge_secrets_for_update(NMSettingsConnection *self,
+                                                NMConnection         *new_connection)
+{
+    NMSettingsConnectionPrivate *priv = NM_SETTINGS_CONNECTION_GET_PRIVATE(self);
+
+    if (!_nm_connection_aggregate(new_connection, NM_CONNECTION_AGGREGATE_ANY_SECRETS, NULL)) {
+        gs_unref_variant GVariant *secrets = NULL;
+
+        /* If the new connection has no secrets, we do not want to remove all
+         * secrets, rather we keep all the existing ones. Do that by merging
+         * them in to the new connection.
+         */
+        secrets = nm_g_variant_ref_sink(
+            nm_connection_to_dbus(nm_settings_connection_get_connection(self),
+                                  NM_CONNECTION_SERIALIZE_WITH_SECRETS));
+
+        if (secrets)
+            nm_connection_update_secrets(new_connection, NULL, secrets, NULL);
+
+        if (priv->agent_secrets)
+            nm_connection_update_secrets(new_connection, NULL, priv->agent_secrets, NULL);
+    } else {
+        /* Cache the new secrets from the agent, as stuff like inotify-triggered
+         * changes to connection's backing config files will blow them away if
+         * they're in the main connection.
+         */
+        update_agent_secrets_cache(self, new_connection);
+
+        /* New secrets, allow autoconnection again */
+        if (nm_settings_connection_autoconnect_blocked_reason_set(
+                self,
+                NM_SETTINGS_AUTOCONNECT_BLOCKED_REASON_NO_SECRETS,
+                FALSE)
+            && !nm_settings_connection_autoconnect_blocked_reason_get(self))
+            nm_manager_devcon_autoconnect_retries_reset(nm_settings_connection_get_manager(self),
+                                                        NULL,
+                                                        self);
+    }
+}
+
 static void
 update_auth_cb(NMSettingsConnection  *self,
                GDBusMethodInvocation *context,
@@ -1526,44 +1599,8 @@ update_auth_cb(NMSettingsConnection  *self,
         goto out;
     }
 
-    if (info->new_settings) {
-        if (!_nm_connection_aggregate(info->new_settings,
-                                      NM_CONNECTION_AGGREGATE_ANY_SECRETS,
-                                      NULL)) {
-            gs_unref_variant GVariant *secrets = NULL;
-
-            /* If the new connection has no secrets, we do not want to remove all
-             * secrets, rather we keep all the existing ones. Do that by merging
-             * them in to the new connection.
-             */
-            secrets = nm_g_variant_ref_sink(
-                nm_connection_to_dbus(nm_settings_connection_get_connection(self),
-                                      NM_CONNECTION_SERIALIZE_WITH_SECRETS));
-
-            if (secrets)
-                nm_connection_update_secrets(info->new_settings, NULL, secrets, NULL);
-
-            if (priv->agent_secrets)
-                nm_connection_update_secrets(info->new_settings, NULL, priv->agent_secrets, NULL);
-        } else {
-            /* Cache the new secrets from the agent, as stuff like inotify-triggered
-             * changes to connection's backing config files will blow them away if
-             * they're in the main connection.
-             */
-            update_agent_secrets_cache(self, info->new_settings);
-
-            /* New secrets, allow autoconnection again */
-            if (nm_settings_connection_autoconnect_blocked_reason_set(
-                    self,
-                    NM_SETTINGS_AUTOCONNECT_BLOCKED_REASON_NO_SECRETS,
-                    FALSE)
-                && !nm_settings_connection_autoconnect_blocked_reason_get(self))
-                nm_manager_devcon_autoconnect_retries_reset(
-                    nm_settings_connection_get_manager(self),
-                    NULL,
-                    self);
-        }
-    }
+    if (info->new_settings)
+        nm_settings_connection_merge_secrets_for_update(self, info->new_settings);
 
     if (info->new_settings) {
         if (nm_audit_manager_audit_enabled(nm_audit_manager_get())) {
@@ -2364,7 +2401,7 @@ nm_settings_connection_update_timestamp(NMSettingsConnection *self, guint64 time
 
     _LOGT("timestamp: set timestamp %" G_GUINT64_FORMAT, timestamp);
 
-    _nm_settings_notify_sorted_by_autoconnect_priority_maybe_changed(priv->settings);
+    _nm_settings_notify_autoconnect_priority_changed(priv->settings, self);
 
     if (!priv->kf_db_timestamps)
         return;
@@ -2768,6 +2805,7 @@ nm_settings_connection_init(NMSettingsConnection *self)
     self->_priv = priv;
 
     c_list_init(&self->_connections_lst);
+    c_rbnode_init(&self->_autoconnect_priority_node);
     c_list_init(&self->devcon_con_lst_head);
     c_list_init(&priv->seen_bssids_lst_head);
     c_list_init(&priv->call_ids_lst_head);
@@ -2797,6 +2835,7 @@ dispose(GObject *object)
     nm_assert(!priv->default_wired_device);
 
     nm_assert(c_list_is_empty(&self->_connections_lst));
+    nm_assert(!c_rbnode_is_linked(&self->_autoconnect_priority_node));
     nm_assert(c_list_is_empty(&self->devcon_con_lst_head));
     nm_assert(c_list_is_empty(&priv->auth_lst_head));
 
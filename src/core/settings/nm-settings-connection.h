@@ -9,6 +9,7 @@
 
 #include "libnm-core-intern/nm-meta-setting-base.h"
 
+#include "c-rbtree/src/c-rbtree.h"
 #include "nm-dbus-object.h"
 #include "nm-connection.h"
 #include "NetworkManagerUtils.h"
@@ -201,6 +202,7 @@ struct _NMSettingsConnectionPrivate;
 struct _NMSettingsConnection {
     NMDBusObject                         parent;
     CList                                _connections_lst;
+    CRBNode                              _autoconnect_priority_node;
     CList                                devcon_con_lst_head;
     struct _NMSettingsConnectionPrivate *_priv;
 };
@@ -217,6 +219,8 @@ NMConnection *nm_settings_connection_get_connection(NMSettingsConnection *self);
 gpointer      nm_settings_connection_get_setting(NMSettingsConnection *self,
                                                  NMMetaSettingType     meta_type);
 
+GVariant *nm_settings_connection_get_settings_dbus(NMSettingsConnection *self);
+
 void _nm_settings_connection_set_connection(NMSettingsConnection            *self,
                                             NMConnection                    *new_connection,
                                             NMConnection                   **out_old_connection,
@@ -250,6 +254,9 @@ gboolean nm_settings_connection_update(NMSettingsConnection            *self,
                                        const char                      *log_context_name,
                                        GError                         **error);
 
+void nm_settings_connection_merge_secrets_for_update(NMSettingsConnection *self,
+                                                     NMConnection         *new_connection);
+
 void nm_settings_connection_delete(NMSettingsConnection *self,
                                    gboolean              allow_add_to_no_auto_default);
 
@@ -382,6 +382,11 @@ typedef struct {
 
     CList connections_lst_head;
 
+    /* All connections, ordered by nm_settings_connection_cmp_autoconnect_priority().
+     * Connections are re-positioned as their priority or timestamp changes, so
+     * the order is always up to date without sorting the whole list. */
+    CRBTree connections_autoconnect_priority_tree;
+
     NMSettingsConnection **connections_cached_list;
     NMSettingsConnection **connections_cached_list_sorted_by_autoconnect_priority;
 
@@ -400,16 +405,18 @@ typedef struct {
 
     guint connections_generation;
 
+    /* Bumped whenever a connection is added, removed or updated. Exposed
+     * by GetConnectionsSettings(). */
+    guint64 connections_serial;
+
     bool kf_db_pruned_timestamps;
     bool kf_db_pruned_seen_bssid;
 
     bool started : 1;
 
-    /* Whether NMSettingsConnections changed in a way that affects the comparison
-     * with nm_settings_connection_cmp_autoconnect_priority_with_data(). In that case,
-     * we may need to re-sort the connections_cached_list_sorted_by_autoconnect_priority
-     * list. */
-    bool sorted_by_autoconnect_priority_maybe_changed : 1;
+    /* Whether a connection moved in connections_autoconnect_priority_tree, and
+     * connections_cached_list_sorted_by_autoconnect_priority needs to be refilled. */
+    bool sorted_by_autoconnect_priority_changed : 1;
 
 } NMSettingsPrivate;
 
@@ -447,6 +454,9 @@ static void default_wired_clear_tag(NMSettings           *self,
 
 static void _clear_connections_cached_list(NMSettingsPrivate *priv);
 
+static void _autoconnect_priority_tree_add(NMSettingsPrivate    *priv,
+                                           NMSettingsConnection *sett_conn);
+
 static void _startup_complete_check(NMSettings *self, gint64 now_msec);
 
 /*****************************************************************************/
@@ -1101,6 +1111,7 @@ _connection_changed_update(NMSettings                      *self,
     _nm_settings_connection_set_storage(sett_conn, storage);
 
     _nm_settings_connection_set_connection(sett_conn, connection, &connection_old, update_reason);
+    priv->connections_serial++;
 
     if (is_new) {
         _nm_settings_connection_register_kf_dbs(sett_conn,
@@ -1109,6 +1120,7 @@ _connection_changed_update(NMSettings                      *self,
 
         _clear_connections_cached_list(priv);
         c_list_link_tail(&priv->connections_lst_head, &sett_conn->_connections_lst);
+        _autoconnect_priority_tree_add(priv, sett_conn);
         priv->connections_len++;
         priv->connections_generation++;
 
@@ -1224,8 +1236,10 @@ _connection_changed_delete(NMSettings           *self,
 
     _clear_connections_cached_list(priv);
     c_list_unlink(&sett_conn->_connections_lst);
+    c_rbnode_unlink(&sett_conn->_autoconnect_priority_node);
     priv->connections_len--;
     priv->connections_generation++;
+    priv->connections_serial++;
 
     /* Tell agents to remove secrets for this connection */
     connection_for_agents =
@@ -2913,6 +2927,440 @@ impl_settings_add_connection2(NMDBusObject                      *obj,
 
 /*****************************************************************************/
 
+typedef enum {
+    APPLY_OP_ADD,
+    APPLY_OP_UPDATE,
+    APPLY_OP_DELETE,
+} ApplyOpType;
+
+typedef struct {
+    NMConnection *connection;
+    char         *path;
+    char         *result_path;
+    char         *error_msg;
+    ApplyOpType   op_type;
+} ApplyOp;
+
+typedef struct {
+    ApplyOp                      *ops;
+    NMAuthSubject                *subject;
+    guint                         n_ops;
+    NMSettingsAddConnection2Flags flags;
+} ApplyData;
+
+static void
+_apply_data_free(gpointer user_data)
+{
+    ApplyData *data = user_data;
+    guint      i;
+
+    for (i = 0; i < data->n_ops; i++) {
+        ApplyOp *op = &data->ops[i];
+
+        g_clear_object(&op->connection);
+        g_free(op->path);
+        g_free(op->result_path);
+        g_free(op->error_msg);
+    }
+    g_free(data->ops);
+    g_clear_object(&data->subject);
+    nm_g_slice_free(data);
+}
+
+static gboolean
+_apply_op_add(NMSettings *self, ApplyData *data, ApplyOp *op, GError **error)
+{
+    NMSettingsConnection *sett_conn;
+
+    if (!nm_settings_add_connection(
+            self,
+            NULL,
+            op->connection,
+            NM_FLAGS_HAS(data->flags, NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK)
+                ? NM_SETTINGS_CONNECTION_PERSIST_MODE_TO_DISK
+                : NM_SETTINGS_CONNECTION_PERSIST_MODE_IN_MEMORY_ONLY,
+            NM_FLAGS_HAS(data->flags, NM_SETTINGS_ADD_CONNECTION2_FLAG_BLOCK_AUTOCONNECT)
+                ? NM_SETTINGS_CONNECTION_ADD_REASON_BLOCK_AUTOCONNECT
+                : NM_SETTINGS_CONNECTION_ADD_REASON_NONE,
+            NM_SETTINGS_CONNECTION_INT_FLAGS_NONE,
+            &sett_conn,
+            error)) {
+        nm_audit_log_connection_op(NM_AUDIT_OP_CONN_ADD,
+                                   NULL,
+                                   FALSE,
+                                   NULL,
+                                   data->subject,
+                                   (*error)->message);
+        return FALSE;
+    }
+
+    op->result_path = g_strdup(nm_dbus_object_get_path(NM_DBUS_OBJECT(sett_conn)));
+    nm_audit_log_connection_op(NM_AUDIT_OP_CONN_ADD, sett_conn, TRUE, NULL, data->subject, NULL);
+    send_agent_owned_secrets(self, sett_conn, data->subject);
+    return TRUE;
+}
+
+static gboolean
+_apply_op_update(NMSettings           *self,
+                 ApplyData            *data,
+                 ApplyOp              *op,
+                 NMSettingsConnection *sett_conn,
+                 GError              **error)
+{
+    NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE(self);
+
+    nm_settings_connection_merge_secrets_for_update(sett_conn, op->connection);
+
+    if (!nm_settings_connection_update(
+            sett_conn,
+            NULL,
+            op->connection,
+            NM_FLAGS_HAS(data->flags, NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK)
+                ? NM_SETTINGS_CONNECTION_PERSIST_MODE_TO_DISK
+                : NM_SETTINGS_CONNECTION_PERSIST_MODE_IN_MEMORY,
+            NM_SETTINGS_CONNECTION_INT_FLAGS_NONE,
+            NM_SETTINGS_CONNECTION_INT_FLAGS_NM_GENERATED
+                | NM_SETTINGS_CONNECTION_INT_FLAGS_VOLATILE
+                | NM_SETTINGS_CONNECTION_INT_FLAGS_EXTERNAL,
+            NM_SETTINGS_CONNECTION_UPDATE_REASON_REAPPLY_PARTIAL
+                | NM_SETTINGS_CONNECTION_UPDATE_REASON_RESET_SYSTEM_SECRETS
+                | NM_SETTINGS_CONNECTION_UPDATE_REASON_RESET_AGENT_SECRETS
+                | NM_SETTINGS_CONNECTION_UPDATE_REASON_UPDATE_NON_SECRET
+                | (NM_FLAGS_HAS(data->flags, NM_SETTINGS_ADD_CONNECTION2_FLAG_BLOCK_AUTOCONNECT)
+                       ? NM_SETTINGS_CONNECTION_UPDATE_REASON_BLOCK_AUTOCONNECT
+                       : NM_SETTINGS_CONNECTION_UPDATE_REASON_NONE),
+            "apply-connections",
+            error)) {
+        nm_audit_log_connection_op(NM_AUDIT_OP_CONN_UPDATE,
+                                   sett_conn,
+                                   FALSE,
+                                   NULL,
+                                   data->subject,
+                                   (*error)->message);
+        return FALSE;
+    }
+
+    op->result_path = g_strdup(op->path);
+    nm_audit_log_connection_op(NM_AUDIT_OP_CONN_UPDATE, sett_conn, TRUE, NULL, data->subject, NULL);
+    send_agent_owned_secrets(self, sett_conn, data->subject);
+
+    /* Reset auto retries back to default since connection was updated */
+    nm_manager_devcon_autoconnect_retries_reset(priv->manager, NULL, sett_conn);
+    return TRUE;
+}
+
+static void
+_apply_auth_cb(NMAuthChain *chain, GDBusMethodInvocation *context, gpointer user_data)
+{
+    NMSettings        *self = NM_SETTINGS(user_data);
+    NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE(self);
+    ApplyData         *data;
+    GVariantBuilder    builder;
+    gint64             start_nsec;
+    guint              n_failed = 0;
+    guint              i;
+
+    c_list_unlink(nm_auth_chain_parent_lst_list(chain));
+
+    data = nm_auth_chain_get_data(chain, "data");
+
+    if (nm_auth_chain_get_result(chain, NM_AUTH_PERMISSION_SETTINGS_MODIFY_SYSTEM)
+        != NM_AUTH_CALL_RESULT_YES) {
+        g_dbus_method_invocation_return_error_literal(context,
+                                                      NM_SETTINGS_ERROR,
+                                                      NM_SETTINGS_ERROR_PERMISSION_DENIED,
+                                                      NM_UTILS_ERROR_MSG_INSUFF_PRIV);
+        return;
+    }
+
+    start_nsec = nm_utils_get_monotonic_timestamp_nsec();
+
+    /* Operations are applied one by one and not rolled back. If one fails
+     * here (for example, because writing the file failed), the operations
+     * before it stay applied, and the failure is reported in its result. */
+    for (i = 0; i < data->n_ops; i++) {
+        ApplyOp                              *op        = &data->ops[i];
+        gs_free_error GError                 *error     = NULL;
+        gs_unref_object NMSettingsConnection *sett_conn = NULL;
+
+        if (op->op_type != APPLY_OP_ADD) {
+            /* The profile may have gone away while we were waiting for
+             * authorization. */
+            sett_conn = nm_g_object_ref(nm_settings_get_connection_by_path(self, op->path));
+            if (!sett_conn) {
+                op->error_msg = g_strdup("connection does not exist anymore");
+                n_failed++;
+                continue;
+            }
+        }
+
+        switch (op->op_type) {
+        case APPLY_OP_ADD:
+            _apply_op_add(self, data, op, &error);
+            break;
+        case APPLY_OP_UPDATE:
+            _apply_op_update(self, data, op, sett_conn, &error);
+            break;
+        case APPLY_OP_DELETE:
+            nm_settings_connection_delete(sett_conn, TRUE);
+            nm_audit_log_connection_op(NM_AUDIT_OP_CONN_DELETE,
+                                       sett_conn,
+                                       TRUE,
+                                       NULL,
+                                       data->subject,
+                                       NULL);
+            break;
+        }
+
+        if (error) {
+            op->error_msg = g_strdup(error->message);
+            n_failed++;
+        }
+    }
+
+    _LOGD("apply-connections: %u operations (%u failed) in %" G_GINT64_FORMAT " msec",
+          data->n_ops,
+          n_failed,
+          (nm_utils_get_monotonic_timestamp_nsec() - start_nsec) / NM_UTILS_NSEC_PER_MSEC);
+
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("a(os)"));
+    for (i = 0; i < data->n_ops; i++) {
+        const ApplyOp *op = &data->ops[i];
+
+        g_variant_builder_add(&builder, "(os)", op->result_path ?: "/", op->error_msg ?: "");
+    }
+    g_dbus_method_invocation_return_value(context, g_variant_new("(a(os))", &builder));
+}
+
+static gboolean
+_apply_parse_op(NMSettings    *self,
+                NMAuthSubject *subject,
+                const char    *kind,
+                const char    *path,
+                GVariant      *settings,
+                GHashTable    *uuids,
+                ApplyOp       *op,
+                GError       **error)
+{
+    NMSettingsConnection *sett_conn = NULL;
+    const char           *uuid;
+
+    if (nm_streq(kind, "add"))
+        op->op_type = APPLY_OP_ADD;
+    else if (nm_streq(kind, "update"))
+        op->op_type = APPLY_OP_UPDATE;
+    else if (nm_streq(kind, "delete"))
+        op->op_type = APPLY_OP_DELETE;
+    else {
+        g_set_error(error,
+                    NM_SETTINGS_ERROR,
+                    NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
+                    "unknown operation '%s'",
+                    kind);
+        return FALSE;
+    }
+
+    if (op->op_type == APPLY_OP_ADD) {
+        if (!nm_streq(path, "/")) {
+            g_set_error_literal(error,
+                                NM_SETTINGS_ERROR,
+                                NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
+                                "add requires \"/\" as connection path");
+            return FALSE;
+        }
+    } else {
+        sett_conn = nm_settings_get_connection_by_path(self, path);
+        if (!sett_conn) {
+            g_set_error(error,
+                        NM_SETTINGS_ERROR,
+                        NM_SETTINGS_ERROR_INVALID_CONNECTION,
+                        "connection '%s' does not exist",
+                        path);
+            return FALSE;
+        }
+        op->path = g_strdup(path);
+
+        if (!nm_auth_is_subject_in_acl_set_error(nm_settings_connection_get_connection(sett_conn),
+                                                 subject,
+                                                 NM_SETTINGS_ERROR,
+                                                 NM_SETTINGS_ERROR_PERMISSION_DENIED,
+                                                 error))
+            return FALSE;
+    }
+
+    if (op->op_type == APPLY_OP_DELETE) {
+        if (g_variant_n_children(settings) > 0) {
+            g_set_error_literal(error,
+                                NM_SETTINGS_ERROR,
+                                NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
+                                "delete does not accept settings");
+            return FALSE;
+        }
+        uuid = nm_settings_connection_get_uuid(sett_conn);
+    } else {
+        op->connection = _nm_simple_connection_new_from_dbus(settings,
+                                                             NM_SETTING_PARSE_FLAGS_STRICT
+                                                                 | NM_SETTING_PARSE_FLAGS_NORMALIZE,
+                                                             error);
+        if (!op->connection || !nm_connection_verify_secrets(op->connection, error))
+            return FALSE;
+
+        /* You can't make a connection invisible to yourself. */
+        if (!nm_auth_is_subject_in_acl_set_error(op->connection,
+                                                 subject,
+                                                 NM_SETTINGS_ERROR,
+                                                 NM_SETTINGS_ERROR_PERMISSION_DENIED,
+                                                 error))
+            return FALSE;
+
+        uuid = nm_connection_get_uuid(op->connection);
+
+        if (op->op_type == APPLY_OP_ADD) {
+            if (nm_settings_get_connection_by_uuid(self, uuid)) {
+                g_set_error(error,
+                            NM_SETTINGS_ERROR,
+                            NM_SETTINGS_ERROR_UUID_EXISTS,
+                            "a connection with UUID '%s' already exists",
+                            uuid);
+                return FALSE;
+            }
+        } else if (!nm_streq(uuid, nm_settings_connection_get_uuid(sett_conn))) {
+            g_set_error_literal(error,
+                                NM_SETTINGS_ERROR,
+                                NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
+                                "update cannot change the connection UUID");
+            return FALSE;
+        }
+    }
+
+    /* Each profile can only be touched once per transaction, otherwise the
+     * outcome would depend on the order of the operations. */
+    if (!g_hash_table_add(uuids, (gpointer) uuid)) {
+        g_set_error(error,
+                    NM_SETTINGS_ERROR,
+                    NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
+                    "connection '%s' is referenced more than once",
+                    uuid);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+static void
+impl_settings_apply_connections(NMDBusObject                      *obj,
+                                const NMDBusInterfaceInfoExtended *interface_info,
+                                const NMDBusMethodInfoExtended    *method_info,
+                                GDBusConnection                   *dbus_connection,
+                                const char                        *sender,
+                                GDBusMethodInvocation             *invocation,
+                                GVariant                          *parameters)
+{
+    NMSettings                    *self       = NM_SETTINGS(obj);
+    NMSettingsPrivate             *priv       = NM_SETTINGS_GET_PRIVATE(self);
+    gs_unref_variant GVariant     *operations = NULL;
+    gs_unref_variant GVariant     *args       = NULL;
+    gs_unref_hashtable GHashTable *uuids      = NULL;
+    gs_unref_object NMAuthSubject *subject    = NULL;
+    ApplyData                     *data;
+    NMAuthChain                   *chain;
+    GVariantIter                   iter;
+    const char                    *args_name;
+    guint32                        flags_u;
+    guint                          i;
+
+    g_variant_get(parameters, "(@a(soa{sa{sv}})u@a{sv})", &operations, &flags_u, &args);
+
+    if (NM_FLAGS_ANY(flags_u,
+                     ~((guint32) (NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK
+                                  | NM_SETTINGS_ADD_CONNECTION2_FLAG_IN_MEMORY
+                                  | NM_SETTINGS_ADD_CONNECTION2_FLAG_BLOCK_AUTOCONNECT)))) {
+        g_dbus_method_invocation_return_error_literal(invocation,
+                                                      NM_SETTINGS_ERROR,
+                                                      NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
+                                                      "Unknown flags");
+        return;
+    }
+
+    if (!NM_FLAGS_ANY(flags_u,
+                      NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK
+                          | NM_SETTINGS_ADD_CONNECTION2_FLAG_IN_MEMORY)
+        || NM_FLAGS_ALL(flags_u,
+                        NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK
+                            | NM_SETTINGS_ADD_CONNECTION2_FLAG_IN_MEMORY)) {
+        g_dbus_method_invocation_return_error_literal(
+            invocation,
+            NM_SETTINGS_ERROR,
+            NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
+            "Requires exactly one of to-disk (0x1) or in-memory (0x2) flags");
+        return;
+    }
+
+    g_variant_iter_init(&iter, args);
+    if (g_variant_iter_next(&iter, "{&sv}", &args_name, NULL)) {
+        g_dbus_method_invocation_return_error(invocation,
+                                              NM_SETTINGS_ERROR,
+                                              NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
+                                              "Unsupported argument '%s'",
+                                              args_name);
+        return;
+    }
+
+    subject = nm_dbus_manager_new_auth_subject_from_context(invocation);
+    if (!subject) {
+        g_dbus_method_invocation_return_error_literal(invocation,
+                                                      NM_SETTINGS_ERROR,
+                                                      NM_SETTINGS_ERROR_PERMISSION_DENIED,
+                                                      NM_UTILS_ERROR_MSG_REQ_UID_UKNOWN);
+        return;
+    }
+
+    data  = g_slice_new(ApplyData);
+    *data = (ApplyData){
+        .n_ops   = g_variant_n_children(operations),
+        .flags   = flags_u,
+        .subject = g_steal_pointer(&subject),
+    };
+    data->ops = g_new0(ApplyOp, data->n_ops);
+
+    /* Validate the whole transaction upfront. If any operation is invalid,
+     * nothing gets changed. */
+    uuids = g_hash_table_new(nm_str_hash, g_str_equal);
+    for (i = 0; i < data->n_ops; i++) {
+        gs_unref_variant GVariant *settings = NULL;
+        gs_free_error GError      *error    = NULL;
+        const char                *kind;
+        const char                *path;
+
+        g_variant_get_child(operations, i, "(&s&o@a{sa{sv}})", &kind, &path, &settings);
+
+        if (!_apply_parse_op(self,
+                             data->subject,
+                             kind,
+                             path,
+                             settings,
+                             uuids,
+                             &data->ops[i],
+                             &error)) {
+            g_dbus_method_invocation_return_error(invocation,
+                                                  error->domain,
+                                                  error->code,
+                                                  "operation %u: %s",
+                                                  i,
+                                                  error->message);
+            _apply_data_free(data);
+            return;
+        }
+    }
+
+    chain = nm_auth_chain_new_subject(data->subject, invocation, _apply_auth_cb, self);
+    c_list_link_tail(&priv->auth_lst_head, nm_auth_chain_parent_lst_list(chain));
+    nm_auth_chain_set_data(chain, "data", data, _apply_data_free);
+    nm_auth_chain_add_call(chain, NM_AUTH_PERMISSION_SETTINGS_MODIFY_SYSTEM, TRUE);
+}
+
+/*****************************************************************************/
+
 static void
 impl_settings_load_connections(NMDBusObject                      *obj,
                                const NMDBusInterfaceInfoExtended *interface_info,
@@ -3042,12 +3490,66 @@ impl_settings_reload_connections(NMDBusObject                      *obj,
 
 /*****************************************************************************/
 
+static int
+_autoconnect_priority_tree_cmp(CRBTree *tree, void *key, CRBNode *node)
+{
+    return nm_settings_connection_cmp_autoconnect_priority(
+        key,
+        c_rbnode_entry(node, NMSettingsConnection, _autoconnect_priority_node));
+}
+
+static void
+_autoconnect_priority_tree_add(NMSettingsPrivate *priv, NMSettingsConnection *sett_conn)
+{
+    CRBNode **slot;
+    CRBNode  *parent;
+
+    nm_assert(!c_rbnode_is_linked(&sett_conn->_autoconnect_priority_node));
+
+    /* The comparison falls back to the UUID and the pointer value, so there
+     * are never two connections that compare equal. */
+    slot = c_rbtree_find_slot(&priv->connections_autoconnect_priority_tree,
+                              _autoconnect_priority_tree_cmp,
+                              sett_conn,
+                              &parent);
+    nm_assert(slot);
+
+    c_rbtree_add(&priv->connections_autoconnect_priority_tree,
+                 parent,
+                 slot,
+                 &sett_conn->_autoconnect_priority_node);
+}
+
 void
-_nm_settings_notify_sorted_by_autoconnect_priority_maybe_changed(NMSettings *self)
+_nm_settings_notify_autoconnect_priority_changed(NMSettings *self, NMSettingsConnection *sett_conn)
 {
-    NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE(self);
+    NMSettingsPrivate    *priv = NM_SETTINGS_GET_PRIVATE(self);
+    CRBNode              *node = &sett_conn->_autoconnect_priority_node;
+    NMSettingsConnection *prev;
+    NMSettingsConnection *next;
+
+    if (!c_rbnode_is_linked(node)) {
+        /* The connection is not yet added. It gets sorted into the tree
+         * once it is. */
+        return;
+    }
+
+    prev = c_rbnode_entry(c_rbnode_prev(node), NMSettingsConnection, _autoconnect_priority_node);
+    next = c_rbnode_entry(c_rbnode_next(node), NMSettingsConnection, _autoconnect_priority_node);
 
-    priv->sorted_by_autoconnect_priority_maybe_changed = TRUE;
+    if ((!prev || nm_settings_connection_cmp_autoconnect_priority(prev, sett_conn) < 0)
+        && (!next || nm_settings_connection_cmp_autoconnect_priority(sett_conn, next) < 0)) {
+        /* Still at the right position. This is the common case, for example
+         * when the timestamp of the most recently used profile is bumped. */
+        return;
+    }
+
+    c_rbnode_unlink(node);
+    _autoconnect_priority_tree_add(priv, sett_conn);
+
+    /* The number of connections is unchanged, so we refill the cached list in
+     * place. Callers that hold on to it keep seeing a valid list. */
+    priv->sorted_by_autoconnect_priority_changed = TRUE;
 }
 
 static void
@@ -3129,6 +3631,69 @@ nm_settings_get_dbus_path_for_uuid(NMSettings *self, const char *uuid)
     return nm_dbus_object_get_path(NM_DBUS_OBJECT(sett_conn));
 }
 
+static void
+impl_settings_get_connections_settings(NMDBusObject                      *obj,
+                                       const NMDBusInterfaceInfoExtended *interface_info,
+                                       const NMDBusMethodInfoExtended    *method_info,
+                                       GDBusConnection                   *dbus_connection,
+                                       const char                        *sender,
+                                       GDBusMethodInvocation             *invocation,
+                                       GVariant                          *parameters)
+{
+    NMSettings                    *self    = NM_SETTINGS(obj);
+    NMSettingsPrivate             *priv    = NM_SETTINGS_GET_PRIVATE(self);
+    gs_unref_object NMAuthSubject *subject = NULL;
+    NMSettingsConnection *const   *list;
+    GVariantBuilder                builder;
+    guint32                        offset;
+    guint32                        limit;
+    guint                          len;
+    guint                          end;
+    guint                          i;
+
+    g_variant_get(parameters, "(uu)", &offset, &limit);
+
+    subject = nm_dbus_manager_new_auth_subject_from_context(invocation);
+    if (!subject) {
+        g_dbus_method_invocation_return_error_literal(invocation,
+                                                      NM_SETTINGS_ERROR,
+                                                      NM_SETTINGS_ERROR_PERMISSION_DENIED,
+                                                      NM_UTILS_ERROR_MSG_REQ_UID_UKNOWN);
+        return;
+    }
+
+    list = nm_settings_get_connections(self, &len);
+
+    offset = NM_MIN(offset, len);
+    if (limit == 0 || limit > len - offset)
+        end = len;
+    else
+        end = offset + limit;
+
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{oa{sa{sv}}}"));
+    for (i = offset; i < end; i++) {
+        NMSettingsConnection      *sett_conn = list[i];
+        gs_unref_variant GVariant *settings  = NULL;
+
+        if (!nm_auth_is_subject_in_acl(nm_settings_connection_get_connection(sett_conn),
+                                       subject,
+                                       NULL))
+            continue;
+
+        settings = nm_settings_connection_get_settings_dbus(sett_conn);
+        g_variant_builder_add(&builder,
+                              "{o@a{sa{sv}}}",
+                              nm_dbus_object_get_path(NM_DBUS_OBJECT(sett_conn)),
+                              settings);
+    }
+
+    g_dbus_method_invocation_return_value(invocation,
+                                          g_variant_new("(a{oa{sa{sv}}}ut)",
+                                                        &builder,
+                                                        (guint32) (len - end),
+                                                        priv->connections_serial));
+}
+
 static void
 impl_settings_get_connection_by_uuid(NMDBusObject                      *obj,
                                      const NMDBusInterfaceInfoExtended *interface_info,
@@ -3225,8 +3790,10 @@ nm_settings_get_connections(NMSettings *self, guint *out_len)
 NMSettingsConnection *const *
 nm_settings_get_connections_sorted_by_autoconnect_priority(NMSettings *self, guint *out_len)
 {
-    NMSettingsPrivate *priv;
-    gboolean           needs_sort = FALSE;
+    NMSettingsPrivate     *priv;
+    NMSettingsConnection **v;
+    NMSettingsConnection  *con;
+    guint                  i;
 
     g_return_val_if_fail(NM_IS_SETTINGS(self), NULL);
 
@@ -3238,45 +3805,34 @@ nm_settings_get_connections_sorted_by_autoconnect_priority(NMSettings *self, gui
         || (priv->connections_len
             == NM_PTRARRAY_LEN(priv->connections_cached_list_sorted_by_autoconnect_priority)));
 
-    if (!priv->connections_cached_list_sorted_by_autoconnect_priority) {
-        NMSettingsConnection *const *list_cached;
-        guint                        len;
+    if (G_UNLIKELY(!priv->connections_cached_list_sorted_by_autoconnect_priority
+                   || priv->sorted_by_autoconnect_priority_changed)) {
+        /* The tree is always in order, we only need to flatten it. */
+        v = priv->connections_cached_list_sorted_by_autoconnect_priority;
+        if (!v)
+            v = g_new(NMSettingsConnection *, priv->connections_len + 1);
 
-        list_cached = nm_settings_get_connections(self, &len);
-        priv->connections_cached_list_sorted_by_autoconnect_priority =
-            nm_memdup(list_cached, sizeof(NMSettingsConnection *) * (len + 1));
-        needs_sort = (len > 1);
-    } else if (priv->sorted_by_autoconnect_priority_maybe_changed) {
-        if (!nm_utils_ptrarray_is_sorted(
-                (gconstpointer *) priv->connections_cached_list_sorted_by_autoconnect_priority,
-                priv->connections_len,
-                FALSE,
-                nm_settings_connection_cmp_autoconnect_priority_with_data,
-                NULL)) {
-            /* We cache the sorted list, but we don't monitor all entries whether they
-             * get modified to invalidate the sort order. So every time we have to check
-             * whether the sort order is still correct. The vast majority of the time it
-             * is, and this check is faster than sorting anew. */
-            needs_sort = TRUE;
+        i = 0;
+        c_rbtree_for_each_entry (con,
+                                 &priv->connections_autoconnect_priority_tree,
+                                 _autoconnect_priority_node) {
+            nm_assert(i < priv->connections_len);
+            v[i++] = con;
         }
-    } else {
-        nm_assert(nm_utils_ptrarray_is_sorted(
-            (gconstpointer *) priv->connections_cached_list_sorted_by_autoconnect_priority,
-            priv->connections_len,
-            TRUE,
-            nm_settings_connection_cmp_autoconnect_priority_with_data,
-            NULL));
-    }
+        nm_assert(i == priv->connections_len);
+        v[i] = NULL;
 
-    priv->sorted_by_autoconnect_priority_maybe_changed = FALSE;
-    if (needs_sort) {
-        g_qsort_with_data(priv->connections_cached_list_sorted_by_autoconnect_priority,
-                          priv->connections_len,
-                          sizeof(NMSettingsConnection *),
-                          nm_settings_connection_cmp_autoconnect_priority_p_with_data,
-                          NULL);
+        priv->connections_cached_list_sorted_by_autoconnect_priority = v;
+        priv->sorted_by_autoconnect_priority_changed                 = FALSE;
     }
 
+    nm_assert(nm_utils_ptrarray_is_sorted(
+        (gconstpointer *) priv->connections_cached_list_sorted_by_autoconnect_priority,
+        priv->connections_len,
+        TRUE,
+        nm_settings_connection_cmp_autoconnect_priority_with_data,
+        NULL));
+
     NM_SET_OUT(out_len, priv->connections_len);
     return priv->connections_cached_list_sorted_by_autoconnect_priority;
 }
@@ -4198,6 +4754,7 @@ nm_settings_init(NMSettings *self)
 
     c_list_init(&priv->auth_lst_head);
     c_list_init(&priv->connections_lst_head);
+    c_rbtree_init(&priv->connections_autoconnect_priority_tree);
     c_list_init(&priv->startup_complete_scd_lst_head);
 
     c_list_init(&priv->sce_dirty_lst_head);
@@ -4277,6 +4834,7 @@ finalize(GObject *object)
     _clear_connections_cached_list(priv);
 
     nm_assert(c_list_is_empty(&priv->connections_lst_head));
+    nm_assert(c_rbtree_is_empty(&priv->connections_autoconnect_priority_tree));
 
     nm_assert(c_list_is_empty(&priv->sce_dirty_lst_head));
     nm_assert(g_hash_table_size(priv->sce_idx) == 0);
@@ -4341,6 +4899,17 @@ static const NMDBusInterfaceInfoExtended interface_info_settings = {
                     .out_args =
                         NM_DEFINE_GDBUS_ARG_INFOS(NM_DEFINE_GDBUS_ARG_INFO("connection", "o"), ), ),
                 .handle = impl_settings_get_connection_by_uuid, ),
+            NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
+                NM_DEFINE_GDBUS_METHOD_INFO_INIT(
+                    "GetConnectionsSettings",
+                    .in_args = NM_DEFINE_GDBUS_ARG_INFOS(NM_DEFINE_GDBUS_ARG_INFO("offset", "u"),
+                                                         NM_DEFINE_GDBUS_ARG_INFO("limit", "u"), ),
+                    .out_args =
+                        NM_DEFINE_GDBUS_ARG_INFOS(NM_DEFINE_GDBUS_ARG_INFO("settings",
+                                                                           "a{oa{sa{sv}}}"),
+                                                  NM_DEFINE_GDBUS_ARG_INFO("remaining", "u"),
+                                                  NM_DEFINE_GDBUS_ARG_INFO("serial", "t"), ), ),
+                .handle = impl_settings_get_connections_settings, ),
             NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
                 NM_DEFINE_GDBUS_METHOD_INFO_INIT(
                     "AddConnection",
@@ -4368,6 +4937,16 @@ static const NMDBusInterfaceInfoExtended interface_info_settings = {
                         NM_DEFINE_GDBUS_ARG_INFOS(NM_DEFINE_GDBUS_ARG_INFO("path", "o"),
                                                   NM_DEFINE_GDBUS_ARG_INFO("result", "a{sv}"), ), ),
                 .handle = impl_settings_add_connection2, ),
+            NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
+                NM_DEFINE_GDBUS_METHOD_INFO_INIT(
+                    "ApplyConnections",
+                    .in_args = NM_DEFINE_GDBUS_ARG_INFOS(
+                        NM_DEFINE_GDBUS_ARG_INFO("operations", "a(soa{sa{sv}})"),
+                        NM_DEFINE_GDBUS_ARG_INFO("flags", "u"),
+                        NM_DEFINE_GDBUS_ARG_INFO("args", "a{sv}"), ),
+                    .out_args = NM_DEFINE_GDBUS_ARG_INFOS(
+                        NM_DEFINE_GDBUS_ARG_INFO("results", "a(os)"), ), ),
+                .handle = impl_settings_apply_connections, ),
             NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
                 NM_DEFINE_GDBUS_METHOD_INFO_INIT(
                     "LoadConnections",
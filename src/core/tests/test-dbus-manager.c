@@ -0,0 +1,673 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "src/core/nm-default-daemon.h"
+
+#include "libnm-std-aux/nm-dbus-compat.h"
+#include "nm-dbus-interface.h"
+#include "nm-dbus-manager.h"
+#include "nm-dbus-object.h"
+
+#include "nm-test-utils-core.h"
+
+/*****************************************************************************/
+
+#define TEST_DBUS_INTERFACE NM_DBUS_INTERFACE ".Test"
+#define TEST_DBUS_PATH      NM_DBUS_PATH "/Test"
+
+#define _NMLOG(level, ...) __NMLOG_DEFAULT(level, LOGD_CORE, "test", __VA_ARGS__)
+
+#define NM_TYPE_TEST_DBUS_OBJECT (nm_test_dbus_object_get_type())
+
+typedef struct {
+    NMDBusObject parent;
+    guint32      value;
+} NMTestDBusObject;
+
+NM_GOBJECT_PROPERTIES_DEFINE(NMTestDBusObject, PROP_VALUE, );
+
+typedef struct {
+    NMDBusObjectClass parent;
+} NMTestDBusObjectClass;
+
+GType nm_test_dbus_object_get_type(void);
+
+G_DEFINE_TYPE(NMTestDBusObject, nm_test_dbus_object, NM_TYPE_DBUS_OBJECT)
+
+static void
+_test_dbus_object_set_value(NMTestDBusObject *self, guint32 value)
+{
+    self->value = value;
+    _notify(self, PROP_VALUE);
+}
+
+typedef struct {
+    NMTestDBusObject      *self;
+    GDBusMethodInvocation *invocation;
+    guint32                value;
+} SetValueData;
+
+static gboolean
+_set_value_delayed_cb(gpointer user_data)
+{
+    SetValueData *data = user_data;
+
+    _test_dbus_object_set_value(data->self, data->value);
+    g_dbus_method_invocation_return_value(data->invocation, NULL);
+
+    g_object_unref(data->self);
+    nm_g_slice_free(data);
+    return G_SOURCE_REMOVE;
+}
+
+static void
+impl_test_set_value(NMDBusObject                      *obj,
+                    const NMDBusInterfaceInfoExtended *interface_info,
+                    const NMDBusMethodInfoExtended    *method_info,
+                    GDBusConnection                   *connection,
+                    const char                        *sender,
+                    GDBusMethodInvocation             *invocation,
+                    GVariant                          *parameters)
+{
+    NMTestDBusObject *self = (NMTestDBusObject *) obj;
+    SetValueData     *data;
+    guint32           value;
+    gboolean          delayed;
+
+    g_variant_get(parameters, "(ub)", &value, &delayed);
+
+    if (!delayed) {
+        _test_dbus_object_set_value(self, value);
+        g_dbus_method_invocation_return_value(invocation, NULL);
+        return;
+    }
+
+    /* Reply later, like handlers that first authorize the request. */
+    data  = g_slice_new(SetValueData);
+    *data = (SetValueData){
+        .self       = g_object_ref(self),
+        .invocation = invocation,
+        .value      = value,
+    };
+    g_idle_add(_set_value_delayed_cb, data);
+}
+
+static void
+impl_test_get_caller(NMDBusObject                      *obj,
+                     const NMDBusInterfaceInfoExtended *interface_info,
+                     const NMDBusMethodInfoExtended    *method_info,
+                     GDBusConnection                   *connection,
+                     const char                        *sender,
+                     GDBusMethodInvocation             *invocation,
+                     GVariant                          *parameters)
+{
+    gulong  uid = G_MAXULONG;
+    gulong  pid = G_MAXULONG;
+    guint32 seq;
+
+    g_variant_get(parameters, "(u)", &seq);
+
+    if (!nm_dbus_manager_get_caller_info(nm_dbus_object_get_manager(obj),
+                                         invocation,
+                                         NULL,
+                                         &uid,
+                                         &pid)) {
+        g_dbus_method_invocation_return_error_literal(invocation,
+                                                      NM_MANAGER_ERROR,
+                                                      NM_MANAGER_ERROR_PERMISSION_DENIED,
+                                                      "Unable to determine UID");
+        return;
+    }
+
+    g_dbus_method_invocation_return_value(invocation,
+                                          g_variant_new("(uuu)",
+                                                        seq,
+                                                        (guint32) uid,
+                                                        (guint32) pid));
+}
+
+static void
+get_property(GObject *object, guint prop_id, GValue *value, GParamSpec *pspec)
+{
+    NMTestDBusObject *self = (NMTestDBusObject *) object;
+
+    switch (prop_id) {
+    case PROP_VALUE:
+        g_value_set_uint(value, self->value);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+}
+
+static const NMDBusInterfaceInfoExtended interface_info_test = {
+    .parent = NM_DEFINE_GDBUS_INTERFACE_INFO_INIT(
+        TEST_DBUS_INTERFACE,
+        .methods = NM_DEFINE_GDBUS_METHOD_INFOS(
+            NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
+                NM_DEFINE_GDBUS_METHOD_INFO_INIT(
+                    "GetCaller",
+                    .in_args  = NM_DEFINE_GDBUS_ARG_INFOS(NM_DEFINE_GDBUS_ARG_INFO("seq", "u"), ),
+                    .out_args = NM_DEFINE_GDBUS_ARG_INFOS(
+                        NM_DEFINE_GDBUS_ARG_INFO("seq", "u"),
+                        NM_DEFINE_GDBUS_ARG_INFO("uid", "u"),
+                        NM_DEFINE_GDBUS_ARG_INFO("pid", "u"), ), ),
+                .handle = impl_test_get_caller, ),
+            NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
+                NM_DEFINE_GDBUS_METHOD_INFO_INIT(
+                    "SetValue",
+                    .in_args = NM_DEFINE_GDBUS_ARG_INFOS(
+                        NM_DEFINE_GDBUS_ARG_INFO("value", "u"),
+                        NM_DEFINE_GDBUS_ARG_INFO("delayed", "b"), ), ),
+                .handle = impl_test_set_value, ), ),
+        .properties = NM_DEFINE_GDBUS_PROPERTY_INFOS(
+            NM_DEFINE_DBUS_PROPERTY_INFO_EXTENDED_READABLE("Value", "u", "value"), ), ),
+};
+
+static void
+nm_test_dbus_object_init(NMTestDBusObject *self)
+{}
+
+static void
+nm_test_dbus_object_class_init(NMTestDBusObjectClass *klass)
+{
+    GObjectClass      *object_class      = G_OBJECT_CLASS(klass);
+    NMDBusObjectClass *dbus_object_class = NM_DBUS_OBJECT_CLASS(klass);
+
+    dbus_object_class->export_path     = NM_DBUS_EXPORT_PATH_NUMBERED(TEST_DBUS_PATH);
+    dbus_object_class->interface_infos = NM_DBUS_INTERFACE_INFOS(&interface_info_test);
+
+    object_class->get_property = get_property;
+
+    obj_properties[PROP_VALUE] = g_param_spec_uint("value",
+                                                   "",
+                                                   "",
+                                                   0,
+                                                   G_MAXUINT32,
+                                                   0,
+                                                   G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+
+    g_object_class_install_properties(object_class, _PROPERTY_ENUMS_LAST, obj_properties);
+}
+
+/*****************************************************************************/
+
+static struct {
+    GTestDBus        *test_dbus;
+    NMDBusManager    *dbus_mgr;
+    NMTestDBusObject *obj;
+    const char       *obj_path;
+    char             *owner;
+} gl;
+
+static gboolean
+_dbus_setup(void)
+{
+    gs_free char *dbus_daemon = NULL;
+
+    if (gl.dbus_mgr)
+        return TRUE;
+
+    dbus_daemon = g_find_program_in_path("dbus-daemon");
+    if (!dbus_daemon)
+        return FALSE;
+
+    gl.test_dbus = g_test_dbus_new(G_TEST_DBUS_NONE);
+    g_test_dbus_up(gl.test_dbus);
+
+    /* The D-Bus manager always connects to the system bus. */
+    g_setenv("DBUS_SYSTEM_BUS_ADDRESS", g_test_dbus_get_bus_address(gl.test_dbus), TRUE);
+
+    gl.dbus_mgr = g_object_ref(nm_dbus_manager_get());
+    g_assert(nm_dbus_manager_setup(gl.dbus_mgr));
+    nm_dbus_manager_start(gl.dbus_mgr, NULL, NULL);
+
+    gl.obj = g_object_new(NM_TYPE_TEST_DBUS_OBJECT, NULL);
+    gl.obj_path = nm_dbus_object_export(gl.obj);
+
+    gl.owner = g_strdup(
+        g_dbus_connection_get_unique_name(nm_dbus_manager_get_dbus_connection(gl.dbus_mgr)));
+    return TRUE;
+}
+
+static void
+_dbus_cleanup(void)
+{
+    if (!gl.dbus_mgr)
+        return;
+
+    nm_dbus_object_unexport(gl.obj);
+    g_clear_object(&gl.obj);
+    gl.obj_path = NULL;
+    nm_dbus_manager_stop(gl.dbus_mgr);
+    g_clear_object(&gl.dbus_mgr);
+    nm_clear_g_free(&gl.owner);
+    g_test_dbus_down(gl.test_dbus);
+    g_clear_object(&gl.test_dbus);
+}
+
+static GDBusConnection *
+_client_new(void)
+{
+    GDBusConnection      *client;
+    gs_free_error GError *error = NULL;
+
+    client = g_dbus_connection_new_for_address_sync(
+        g_test_dbus_get_bus_address(gl.test_dbus),
+        G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT
+            | G_DBUS_CONNECTION_FLAGS_MESSAGE_BUS_CONNECTION,
+        NULL,
+        NULL,
+        &error);
+    nmtst_assert_success(client, error);
+    return client;
+}
+
+/*****************************************************************************/
+
+#define N_CONCURRENT_CLIENTS 20
+#define N_CONCURRENT_CALLS   25
+
+typedef struct {
+    guint32 n_replies[N_CONCURRENT_CLIENTS];
+    guint   n_pending;
+} ConcurrentCallsData;
+
+static void
+_concurrent_call_cb(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+    ConcurrentCallsData       *data  = user_data;
+    gs_unref_variant GVariant *ret   = NULL;
+    gs_free_error GError      *error = NULL;
+    guint32                    seq;
+    guint32                    uid;
+    guint32                    pid;
+    guint                      client_idx;
+
+    ret = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), result, &error);
+    nmtst_assert_success(ret, error);
+
+    g_variant_get(ret, "(uuu)", &seq, &uid, &pid);
+    g_assert_cmpint(uid, ==, getuid());
+    g_assert_cmpint(pid, ==, getpid());
+
+    /* The calls of one sender are served in the order they were sent, even
+     * if they had to wait for the sender's credentials. */
+    client_idx = seq / N_CONCURRENT_CALLS;
+    g_assert_cmpint(client_idx, <, N_CONCURRENT_CLIENTS);
+    g_assert_cmpint(seq % N_CONCURRENT_CALLS, ==, data->n_replies[client_idx]);
+    data->n_replies[client_idx]++;
+
+    g_assert_cmpint(data->n_pending, >, 0);
+    data->n_pending--;
+}
+
+static void
+test_caller_info_concurrent(void)
+{
+    GDBusConnection    *clients[N_CONCURRENT_CLIENTS];
+    ConcurrentCallsData data = {};
+    NMDBusManagerStats  stats_before;
+    NMDBusManagerStats  stats;
+    guint               i;
+    guint               j;
+
+    if (!_dbus_setup()) {
+        g_test_skip("dbus-daemon not found");
+        return;
+    }
+
+    nm_dbus_manager_get_stats(gl.dbus_mgr, &stats_before);
+
+    /* Each client is a new sender with unknown credentials. Send all calls at
+     * once, so that they queue up while the lookups are in flight. */
+    for (i = 0; i < N_CONCURRENT_CLIENTS; i++) {
+        clients[i] = _client_new();
+        for (j = 0; j < N_CONCURRENT_CALLS; j++) {
+            g_dbus_connection_call(clients[i],
+                                   gl.owner,
+                                   gl.obj_path,
+                                   TEST_DBUS_INTERFACE,
+                                   "GetCaller",
+                                   g_variant_new("(u)", (guint32) (i * N_CONCURRENT_CALLS + j)),
+                                   G_VARIANT_TYPE("(uuu)"),
+                                   G_DBUS_CALL_FLAGS_NONE,
+                                   -1,
+                                   NULL,
+                                   _concurrent_call_cb,
+                                   &data);
+            data.n_pending++;
+        }
+    }
+
+    nmtst_main_context_iterate_until_assert(NULL, 10000, data.n_pending == 0);
+
+    for (i = 0; i < N_CONCURRENT_CLIENTS; i++)
+        g_assert_cmpint(data.n_replies[i], ==, N_CONCURRENT_CALLS);
+
+    /* All credentials were fetched asynchronously, before dispatching the calls.
+     * No handler had to block the main loop. */
+    nm_dbus_manager_get_stats(gl.dbus_mgr, &stats);
+    g_assert_cmpint(stats.n_blocking_caller_lookups, ==, stats_before.n_blocking_caller_lookups);
+
+    for (i = 0; i < N_CONCURRENT_CLIENTS; i++) {
+        g_dbus_connection_close_sync(clients[i], NULL, NULL);
+        g_object_unref(clients[i]);
+    }
+}
+
+/*****************************************************************************/
+
+typedef enum {
+    EVENT_PROPERTIES_CHANGED,
+    EVENT_REPLY,
+} EventType;
+
+typedef struct {
+    EventType type;
+    guint32   value;
+} Event;
+
+static void
+_properties_changed_cb(GDBusConnection *connection,
+                       const char      *sender_name,
+                       const char      *object_path,
+                       const char      *interface_name,
+                       const char      *signal_name,
+                       GVariant        *parameters,
+                       gpointer         user_data)
+{
+    GArray                    *events  = user_data;
+    gs_unref_variant GVariant *changed = NULL;
+    const char                *iface;
+    Event                      event = {.type = EVENT_PROPERTIES_CHANGED};
+
+    g_variant_get(parameters, "(&s@a{sv}as)", &iface, &changed, NULL);
+    g_assert_cmpstr(iface, ==, TEST_DBUS_INTERFACE);
+    g_assert(g_variant_lookup(changed, "Value", "u", &event.value));
+    g_array_append_val(events, event);
+}
+
+static guint
+_subscribe_properties_changed(GDBusConnection *client, GArray *events)
+{
+    gs_unref_variant GVariant *ret   = NULL;
+    gs_free_error GError      *error = NULL;
+    guint                      subscription_id;
+
+    subscription_id = g_dbus_connection_signal_subscribe(client,
+                                                         gl.owner,
+                                                         DBUS_INTERFACE_PROPERTIES,
+                                                         "PropertiesChanged",
+                                                         gl.obj_path,
+                                                         NULL,
+                                                         G_DBUS_SIGNAL_FLAGS_NONE,
+                                                         _properties_changed_cb,
+                                                         events,
+                                                         NULL);
+
+    /* A roundtrip to the bus, so that the match rule is in place. */
+    ret = g_dbus_connection_call_sync(client,
+                                      DBUS_SERVICE_DBUS,
+                                      DBUS_PATH_DBUS,
+                                      DBUS_INTERFACE_DBUS,
+                                      "GetId",
+                                      NULL,
+                                      G_VARIANT_TYPE("(s)"),
+                                      G_DBUS_CALL_FLAGS_NONE,
+                                      -1,
+                                      NULL,
+                                      &error);
+    nmtst_assert_success(ret, error);
+
+    return subscription_id;
+}
+
+static void
+_set_value_cb(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+    GArray                    *events = user_data;
+    gs_unref_variant GVariant *ret    = NULL;
+    gs_free_error GError      *error  = NULL;
+    Event                      event  = {.type = EVENT_REPLY};
+
+    ret = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), result, &error);
+    nmtst_assert_success(ret, error);
+    g_array_append_val(events, event);
+}
+
+static void
+test_properties_changed_before_reply(gconstpointer test_data)
+{
+    const gboolean                   delayed = GPOINTER_TO_INT(test_data);
+    gs_unref_object GDBusConnection *client  = NULL;
+    gs_unref_array GArray           *events  = NULL;
+    NMDBusManagerStats               stats_before;
+    NMDBusManagerStats               stats;
+    guint                            subscription_id;
+    guint32                          value;
+    const Event                     *event;
+
+    if (!_dbus_setup()) {
+        g_test_skip("dbus-daemon not found");
+        return;
+    }
+
+    /* Coalesced changes are usually held back a while. They must still be
+     * sent before the reply of the call that made them. */
+    nm_dbus_manager_set_properties_changed_delay(gl.dbus_mgr, 1000);
+
+    client          = _client_new();
+    events          = g_array_new(FALSE, FALSE, sizeof(Event));
+    subscription_id = _subscribe_properties_changed(client, events);
+
+    nm_dbus_manager_get_stats(gl.dbus_mgr, &stats_before);
+
+    value = gl.obj->value + 1;
+    g_dbus_connection_call(client,
+                           gl.owner,
+                           gl.obj_path,
+                           TEST_DBUS_INTERFACE,
+                           "SetValue",
+                           g_variant_new("(ub)", value, delayed),
+                           G_VARIANT_TYPE("()"),
+                           G_DBUS_CALL_FLAGS_NONE,
+                           -1,
+                           NULL,
+                           _set_value_cb,
+                           events);
+
+    nmtst_main_context_iterate_until_assert(
+        NULL,
+        5000,
+        events->len > 0 && nm_g_array_last(events, Event).type == EVENT_REPLY);
+
+    g_assert_cmpint(events->len, ==, 2);
+    event = &nm_g_array_index(events, Event, 0);
+    g_assert_cmpint(event->type, ==, EVENT_PROPERTIES_CHANGED);
+    g_assert_cmpint(event->value, ==, value);
+
+    nm_dbus_manager_get_stats(gl.dbus_mgr, &stats);
+    g_assert_cmpint(stats.n_properties_notified - stats_before.n_properties_notified, ==, 1);
+    g_assert_cmpint(stats.n_properties_changed_emitted - stats_before.n_properties_changed_emitted,
+                    ==,
+                    1);
+
+    g_dbus_connection_signal_unsubscribe(client, subscription_id);
+    nm_dbus_manager_set_properties_changed_delay(gl.dbus_mgr, 0);
+}
+
+static void
+test_properties_changed_coalesce(void)
+{
+    gs_unref_object GDBusConnection *client = NULL;
+    gs_unref_array GArray           *events = NULL;
+    NMDBusManagerStats               stats_before;
+    NMDBusManagerStats               stats;
+    guint                            obj_n_notified;
+    guint                            obj_n_emitted;
+    guint                            subscription_id;
+    guint32                          value;
+    guint                            i;
+
+    if (!_dbus_setup()) {
+        g_test_skip("dbus-daemon not found");
+        return;
+    }
+
+    client          = _client_new();
+    events          = g_array_new(FALSE, FALSE, sizeof(Event));
+    subscription_id = _subscribe_properties_changed(client, events);
+
+    nm_dbus_manager_get_stats(gl.dbus_mgr, &stats_before);
+    obj_n_notified = gl.obj->parent.internal.n_properties_notified;
+    obj_n_emitted  = gl.obj->parent.internal.n_properties_changed_emitted;
+
+    /* Without a pending method call, a burst of changes results in one
+     * signal that carries the last value. */
+    value = gl.obj->value;
+    for (i = 0; i < 5; i++)
+        _test_dbus_object_set_value(gl.obj, ++value);
+
+    nmtst_main_context_iterate_until_assert(NULL, 5000, events->len > 0);
+    nmtst_main_context_iterate_until(NULL, 100, FALSE);
+
+    g_assert_cmpint(events->len, ==, 1);
+    g_assert_cmpint(nm_g_array_index(events, Event, 0).value, ==, value);
+
+    nm_dbus_manager_get_stats(gl.dbus_mgr, &stats);
+    g_assert_cmpint(stats.n_properties_notified - stats_before.n_properties_notified, ==, 5);
+    g_assert_cmpint(stats.n_properties_changed_emitted - stats_before.n_properties_changed_emitted,
+                    ==,
+                    1);
+    g_assert_cmpint(gl.obj->parent.internal.n_properties_notified - obj_n_notified, ==, 5);
+    g_assert_cmpint(gl.obj->parent.internal.n_properties_changed_emitted - obj_n_emitted, ==, 1);
+
+    g_dbus_connection_signal_unsubscribe(client, subscription_id);
+}
+
+/*****************************************************************************/
+
+static void
+_get_managed_objects_cb(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+    GVariant            **p_ret = user_data;
+    gs_free_error GError *error = NULL;
+
+    *p_ret = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), result, &error);
+    nmtst_assert_success(*p_ret, error);
+}
+
+static gint64
+_get_managed_objects(GDBusConnection *client, guint n_expected)
+{
+    gs_unref_variant GVariant *ret     = NULL;
+    gs_unref_variant GVariant *objects = NULL;
+    gint64                     duration;
+
+    duration = nm_utils_get_monotonic_timestamp_nsec();
+    g_dbus_connection_call(client,
+                           gl.owner,
+                           "/org/freedesktop",
+                           DBUS_INTERFACE_OBJECT_MANAGER,
+                           "GetManagedObjects",
+                           NULL,
+                           G_VARIANT_TYPE("(a{oa{sa{sv}}})"),
+                           G_DBUS_CALL_FLAGS_NONE,
+                           -1,
+                           NULL,
+                           _get_managed_objects_cb,
+                           &ret);
+    nmtst_main_context_iterate_until_assert(NULL, 20000, ret);
+    duration = nm_utils_get_monotonic_timestamp_nsec() - duration;
+
+    objects = g_variant_get_child_value(ret, 0);
+    g_assert_cmpint(g_variant_n_children(objects), >=, n_expected);
+    return duration;
+}
+
+static void
+test_get_managed_objects_bench(void)
+{
+    const guint                      N_OBJECTS = nmtst_test_quick() ? 1000u : 10000u;
+    const guint                      N_CALLS   = 10;
+    gs_unref_object GDBusConnection *client    = NULL;
+    gs_unref_ptrarray GPtrArray     *objs      = NULL;
+    NMDBusManagerStats               stats_before;
+    NMDBusManagerStats               stats;
+    gint64                           time_rebuilt;
+    gint64                           time_cached = 0;
+    guint                            i;
+
+    if (!_dbus_setup()) {
+        g_test_skip("dbus-daemon not found");
+        return;
+    }
+
+    client = _client_new();
+
+    objs = g_ptr_array_new_with_free_func(g_object_unref);
+    for (i = 0; i < N_OBJECTS; i++) {
+        NMTestDBusObject *obj;
+
+        obj        = g_object_new(NM_TYPE_TEST_DBUS_OBJECT, NULL);
+        obj->value = i;
+        nm_dbus_object_export(obj);
+        g_ptr_array_add(objs, obj);
+    }
+
+    /* Changing a property drops the cached dictionary of the interface. The
+     * next call has to build all of them again. */
+    for (i = 0; i < N_OBJECTS; i++)
+        _test_dbus_object_set_value(objs->pdata[i], i + 1);
+
+    nm_dbus_manager_get_stats(gl.dbus_mgr, &stats_before);
+    time_rebuilt = _get_managed_objects(client, N_OBJECTS);
+    nm_dbus_manager_get_stats(gl.dbus_mgr, &stats);
+    g_assert_cmpint(stats.n_properties_values_built - stats_before.n_properties_values_built,
+                    >=,
+                    N_OBJECTS);
+
+    /* Without changes, the calls only reuse the cached dictionaries. */
+    nm_dbus_manager_get_stats(gl.dbus_mgr, &stats_before);
+    for (i = 0; i < N_CALLS; i++)
+        time_cached += _get_managed_objects(client, N_OBJECTS);
+    nm_dbus_manager_get_stats(gl.dbus_mgr, &stats);
+    g_assert_cmpint(stats.n_properties_values_built, ==, stats_before.n_properties_values_built);
+
+    _LOGI(">>> GetManagedObjects() with %u objects: %" G_GINT64_FORMAT
+          " usec after a change of all objects, %" G_GINT64_FORMAT " usec on average when cached",
+          N_OBJECTS,
+          time_rebuilt / 1000,
+          time_cached / N_CALLS / 1000);
+
+    for (i = 0; i < N_OBJECTS; i++)
+        nm_dbus_object_unexport(objs->pdata[i]);
+}
+
+/*****************************************************************************/
+
+NMTST_DEFINE();
+
+int
+main(int argc, char **argv)
+{
+    int ret;
+
+    nmtst_init_with_logging(&argc, &argv, NULL, "ALL");
+
+    g_test_add_func("/dbus-manager/caller-info-concurrent", test_caller_info_concurrent);
+    g_test_add_data_func("/dbus-manager/properties-changed-before-reply/1",
+                         GINT_TO_POINTER(FALSE),
+                         test_properties_changed_before_reply);
+    g_test_add_data_func("/dbus-manager/properties-changed-before-reply/2",
+                         GINT_TO_POINTER(TRUE),
+                         test_properties_changed_before_reply);
+    g_test_add_func("/dbus-manager/properties-changed-coalesce", test_properties_changed_coalesce);
+    g_test_add_func("/dbus-manager/get-managed-objects-bench", test_get_managed_objects_bench);
+
+    ret = g_test_run();
+
+    _dbus_cleanup();
+    return ret;
+}
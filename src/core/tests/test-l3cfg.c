@@ -1072,6 +1072,191 @@ test_l3_ipv6ll(gconstpointer test_data)
 
 /*****************************************************************************/
 
+static void
+_test_l3cfg_merge_add_config(NML3Cfg *l3cfg, char tag, const NML3ConfigData *l3cd, int priority)
+{
+    nm_l3cfg_add_config(l3cfg,
+                        GINT_TO_POINTER(tag),
+                        TRUE,
+                        l3cd,
+                        priority,
+                        0,
+                        0,
+                        NM_PLATFORM_ROUTE_METRIC_DEFAULT_IP4,
+                        NM_PLATFORM_ROUTE_METRIC_DEFAULT_IP6,
+                        0,
+                        0,
+                        NM_DNS_PRIORITY_DEFAULT_NORMAL,
+                        NM_DNS_PRIORITY_DEFAULT_NORMAL,
+                        NM_L3_ACD_DEFEND_TYPE_NEVER,
+                        0,
+                        NM_L3CFG_CONFIG_FLAGS_NONE,
+                        NM_L3_CONFIG_MERGE_FLAGS_NONE);
+}
+
+static void
+test_l3cfg_merge_bench(void)
+{
+    const guint                                    N_ROUTES     = nmtst_test_quick() ? 1000u : 20000u;
+    const guint                                    N_RENEWS     = 20;
+    nm_auto(_test_fixture_1_teardown) TestFixture1 test_fixture = {};
+    const TestFixture1                            *f;
+    gs_unref_object NML3Cfg                       *l3cfg0       = NULL;
+    nm_auto_unref_l3cd const NML3ConfigData       *l3cd_static  = NULL;
+    nm_auto_unref_l3cd const NML3ConfigData       *l3cd_dhcp[2] = {};
+    const NML3ConfigData                          *combined;
+    gint64                                         time_changed;
+    gint64                                         time_unchanged;
+    guint64                                        n_merged;
+    guint64                                        n_merged_before;
+    guint64                                        n_skipped;
+    guint64                                        n_skipped_before;
+    guint                                          i;
+
+    f      = _test_fixture_1_setup(&test_fixture, 1);
+    l3cfg0 = _netns_access_l3cfg(f->netns, f->ifindex0);
+
+    {
+        nm_auto_unref_l3cd_init NML3ConfigData *l3cd = NULL;
+
+        l3cd = nm_l3_config_data_new(f->multiidx, f->ifindex0, NM_IP_CONFIG_SOURCE_USER);
+        for (i = 0; i < N_ROUTES; i++) {
+            nm_l3_config_data_add_route_4(
+                l3cd,
+                NM_PLATFORM_IP4_ROUTE_INIT(.ifindex   = f->ifindex0,
+                                           .rt_source = NM_IP_CONFIG_SOURCE_USER,
+                                           .network   = htonl(0x0a000000u | (i << 8)),
+                                           .plen      = 24,
+                                           .metric    = 100, ));
+        }
+        l3cd_static = nm_l3_config_data_seal(g_steal_pointer(&l3cd));
+    }
+
+    for (i = 0; i < G_N_ELEMENTS(l3cd_dhcp); i++) {
+        nm_auto_unref_l3cd_init NML3ConfigData *l3cd = NULL;
+
+        l3cd = nm_l3_config_data_new(f->multiidx, f->ifindex0, NM_IP_CONFIG_SOURCE_DHCP);
+        nm_l3_config_data_add_route_4(
+            l3cd,
+            NM_PLATFORM_IP4_ROUTE_INIT(.ifindex   = f->ifindex0,
+                                       .rt_source = NM_IP_CONFIG_SOURCE_DHCP,
+                                       .network   = htonl(0xc0a8c800u | (i << 8)),
+                                       .plen      = 24,
+                                       .metric    = 100, ));
+        l3cd_dhcp[i] = nm_l3_config_data_seal(g_steal_pointer(&l3cd));
+    }
+
+    _test_l3cfg_merge_add_config(l3cfg0, 's', l3cd_static, 10);
+    _test_l3cfg_merge_add_config(l3cfg0, 'd', l3cd_dhcp[0], 5);
+
+    combined = nm_l3cfg_get_combined_l3cd(l3cfg0, FALSE);
+    g_assert(combined);
+    g_assert_cmpint(nm_l3_config_data_get_num_routes(combined, AF_INET), >=, N_ROUTES);
+
+    /* A renew with a different lease requires a new merge. */
+    nm_l3cfg_get_merge_stats(l3cfg0, &n_merged_before, &n_skipped_before);
+    time_changed = nm_utils_get_monotonic_timestamp_nsec();
+    for (i = 0; i < N_RENEWS; i++) {
+        const NML3ConfigData *combined2;
+
+        _test_l3cfg_merge_add_config(l3cfg0, 'd', l3cd_dhcp[(i + 1) % 2], 5);
+        combined2 = nm_l3cfg_get_combined_l3cd(l3cfg0, FALSE);
+        g_assert(combined2 != combined);
+        combined = combined2;
+    }
+    time_changed = nm_utils_get_monotonic_timestamp_nsec() - time_changed;
+    nm_l3cfg_get_merge_stats(l3cfg0, &n_merged, &n_skipped);
+    g_assert_cmpint(n_merged - n_merged_before, ==, N_RENEWS);
+    g_assert_cmpint(n_skipped - n_skipped_before, ==, 0);
+
+    /* Changing the priority without changing the order of the configurations
+     * marks the configuration as dirty, but the merge result stays the same.
+     * The merge must be skipped. */
+    nm_l3cfg_get_merge_stats(l3cfg0, &n_merged_before, &n_skipped_before);
+    time_unchanged = nm_utils_get_monotonic_timestamp_nsec();
+    for (i = 0; i < N_RENEWS; i++) {
+        _test_l3cfg_merge_add_config(l3cfg0, 'd', l3cd_dhcp[N_RENEWS % 2], 6 - (i % 2));
+        g_assert(nm_l3cfg_get_combined_l3cd(l3cfg0, FALSE) == combined);
+    }
+    time_unchanged = nm_utils_get_monotonic_timestamp_nsec() - time_unchanged;
+    nm_l3cfg_get_merge_stats(l3cfg0, &n_merged, &n_skipped);
+    g_assert_cmpint(n_merged - n_merged_before, ==, 0);
+    g_assert_cmpint(n_skipped - n_skipped_before, ==, N_RENEWS);
+
+    _LOGI(">>> merge of %u routes: %u changed merges in %" G_GINT64_FORMAT
+          " usec, %u unchanged merges in %" G_GINT64_FORMAT " usec",
+          N_ROUTES,
+          N_RENEWS,
+          time_changed / 1000,
+          N_RENEWS,
+          time_unchanged / 1000);
+
+    nm_l3cfg_remove_config_all(l3cfg0, GINT_TO_POINTER('s'));
+    nm_l3cfg_remove_config_all(l3cfg0, GINT_TO_POINTER('d'));
+    g_assert(!nm_l3cfg_get_combined_l3cd(l3cfg0, FALSE));
+}
+
+/*****************************************************************************/
+
+static const NML3ConfigData *
+_l3cd_new_from_connection(NMDedupMultiIndex *multi_idx, NMConnection *connection)
+{
+    return nm_l3_config_data_seal(nm_l3_config_data_new_from_connection(multi_idx, 1, connection));
+}
+
+static void
+test_l3cd_content_hash(void)
+{
+    nm_auto_unref_dedup_multi_index NMDedupMultiIndex *multi_idx = nm_dedup_multi_index_new();
+    gs_unref_object NMConnection                      *con1      = NULL;
+    gs_unref_object NMConnection                      *con2      = NULL;
+    gs_unref_object NMConnection                      *con3      = NULL;
+    nm_auto_unref_l3cd const NML3ConfigData           *l3cd1     = NULL;
+    nm_auto_unref_l3cd const NML3ConfigData           *l3cd2     = NULL;
+    nm_auto_unref_l3cd const NML3ConfigData           *l3cd3     = NULL;
+    NMSettingIPConfig                                 *s_ip4;
+
+    con1  = nmtst_create_minimal_connection("l3cd-hash", NULL, NM_SETTING_WIRED_SETTING_NAME, NULL);
+    s_ip4 = NM_SETTING_IP_CONFIG(nm_setting_ip4_config_new());
+    g_object_set(s_ip4,
+                 NM_SETTING_IP_CONFIG_METHOD,
+                 NM_SETTING_IP4_CONFIG_METHOD_MANUAL,
+                 NM_SETTING_IP_CONFIG_GATEWAY,
+                 "192.168.5.1",
+                 NULL);
+    nmtst_setting_ip_config_add_address(s_ip4, "192.168.5.10", 24);
+    nmtst_setting_ip_config_add_route(s_ip4, "10.20.0.0", 16, "192.168.5.2", 100);
+    nm_connection_add_setting(con1, NM_SETTING(s_ip4));
+
+    /* Profiles that compare equal give l3cds with the same hash. */
+    con2 = nmtst_clone_connection(con1);
+    g_assert(nm_connection_compare(con1, con2, NM_SETTING_COMPARE_FLAG_EXACT));
+
+    l3cd1 = _l3cd_new_from_connection(multi_idx, con1);
+    l3cd2 = _l3cd_new_from_connection(multi_idx, con2);
+    g_assert(l3cd1 != l3cd2);
+    g_assert_cmpuint(nm_l3_config_data_get_content_hash(l3cd1),
+                     ==,
+                     nm_l3_config_data_get_content_hash(l3cd2));
+    g_assert(nm_l3_config_data_equal(l3cd1, l3cd2));
+    g_assert_cmpint(nm_l3_config_data_cmp(l3cd1, l3cd2), ==, 0);
+
+    /* A profile that differs gives a different hash. */
+    con3  = nmtst_clone_connection(con1);
+    s_ip4 = nm_connection_get_setting_ip4_config(con3);
+    nmtst_setting_ip_config_add_route(s_ip4, "10.30.0.0", 16, "192.168.5.2", 100);
+    g_assert(!nm_connection_compare(con1, con3, NM_SETTING_COMPARE_FLAG_EXACT));
+
+    l3cd3 = _l3cd_new_from_connection(multi_idx, con3);
+    g_assert_cmpuint(nm_l3_config_data_get_content_hash(l3cd1),
+                     !=,
+                     nm_l3_config_data_get_content_hash(l3cd3));
+    g_assert(!nm_l3_config_data_equal(l3cd1, l3cd3));
+    g_assert_cmpint(nm_l3_config_data_cmp(l3cd1, l3cd3), !=, 0);
+}
+
+/*****************************************************************************/
+
 NMTstpSetupFunc const _nmtstp_setup_platform_func = nm_linux_platform_setup;
 
 void
@@ -1093,4 +1278,6 @@ _nmtstp_setup_tests(void)
     g_test_add_data_func("/l3-ipv6ll/2", GINT_TO_POINTER(2), test_l3_ipv6ll);
     g_test_add_data_func("/l3-ipv6ll/3", GINT_TO_POINTER(3), test_l3_ipv6ll);
     g_test_add_data_func("/l3-ipv6ll/4", GINT_TO_POINTER(4), test_l3_ipv6ll);
+    g_test_add_func("/l3cfg/merge-bench", test_l3cfg_merge_bench);
+    g_test_add_func("/l3cfg/l3cd-content-hash", test_l3cd_content_hash);
 }
@@ -252,6 +252,14 @@ enum {
     _PROPERTY_AO_IDX_NM_NUM,
 };
 
+typedef struct {
+    /* The array that the index was built from. We keep a reference, so that
+     * a different array returned by nml_dbus_property_ao_get_objs_as_ptrarray()
+     * reliably indicates that the index is out of date. */
+    GPtrArray  *arr;
+    GHashTable *idx;
+} LookupIndex;
+
 typedef struct {
     struct udev     *udev;
     GMainContext    *main_context;
@@ -264,6 +272,20 @@ typedef struct {
     GCancellable    *name_owner_get_cancellable;
     GCancellable    *get_managed_objects_cancellable;
 
+    /* During the initial fetch, the settings of all connections are requested
+     * with GetConnectionsSettings() instead of one GetSettings() call per
+     * connection. This hash maps the D-Bus path to a GetSettingsBulkData. */
+    GHashTable   *get_settings_bulk_hash;
+    GCancellable *get_settings_bulk_cancellable;
+    guint64       get_settings_bulk_serial;
+    guint32       get_settings_bulk_offset;
+
+    /* Lazily built indexes for nm_client_get_connection_by_uuid(),
+     * nm_client_get_connection_by_id() and nm_client_get_device_by_iface(). */
+    LookupIndex lookup_connections_by_uuid;
+    LookupIndex lookup_connections_by_id;
+    LookupIndex lookup_devices_by_iface;
+
     CList queue_notify_lst_head;
     CList notify_event_lst_head;
 
@@ -290,7 +312,7 @@ typedef struct {
     guint dbsid_nm_vpn_connection_state_changed;
     guint dbsid_nm_check_permissions;
 
-    NMClientInstanceFlags instance_flags : 5;
+    NMClientInstanceFlags instance_flags : 6;
 
     NMTernary permissions_state : 3;
 
@@ -300,6 +322,8 @@ typedef struct {
     bool notify_event_lst_changed : 1;
     bool check_dbobj_visible_all : 1;
     bool nm_running : 1;
+    bool get_settings_bulk_collect : 1;
+    bool get_settings_bulk_unsupported : 1;
 
     struct {
         NMLDBusPropertyO  property_o[_PROPERTY_O_IDX_NM_NUM];
@@ -1489,6 +1513,75 @@ _nm_client_notify_object_changed(NMClient *self, NMLDBusObject *dbobj)
 
 /*****************************************************************************/
 
+static void
+_lookup_index_clear(LookupIndex *lookup)
+{
+    nm_clear_pointer(&lookup->arr, g_ptr_array_unref);
+    nm_clear_pointer(&lookup->idx, g_hash_table_unref);
+}
+
+static gpointer
+_lookup_index_find(LookupIndex     *lookup,
+                   const GPtrArray *arr,
+                   const char *(*get_key)(gpointer obj),
+                   const char *key)
+{
+    if (lookup->arr != arr) {
+        guint i;
+
+        _lookup_index_clear(lookup);
+
+        /* The keys point into the objects. The index gets invalidated (and the
+         * keys are no longer accessed) before they change. */
+        lookup->arr = g_ptr_array_ref((GPtrArray *) arr);
+        lookup->idx = g_hash_table_new(nm_str_hash, g_str_equal);
+        for (i = 0; i < arr->len; i++) {
+            const char *k = get_key(arr->pdata[i]);
+
+            /* The first match wins, like the linear search did. */
+            if (k && !g_hash_table_contains(lookup->idx, k))
+                g_hash_table_insert(lookup->idx, (gpointer) k, arr->pdata[i]);
+        }
+    }
+
+    return g_hash_table_lookup(lookup->idx, key);
+}
+
+static const char *
+_lookup_key_connection_uuid(gpointer obj)
+{
+    return nm_connection_get_uuid(obj);
+}
+
+static const char *
+_lookup_key_connection_id(gpointer obj)
+{
+    return nm_connection_get_id(obj);
+}
+
+static const char *
+_lookup_key_device_iface(gpointer obj)
+{
+    return nm_device_get_iface(obj);
+}
+
+void
+_nm_client_lookup_invalidate_connections(NMClient *self)
+{
+    NMClientPrivate *priv = NM_CLIENT_GET_PRIVATE(self);
+
+    _lookup_index_clear(&priv->lookup_connections_by_uuid);
+    _lookup_index_clear(&priv->lookup_connections_by_id);
+}
+
+void
+_nm_client_lookup_invalidate_devices(NMClient *self)
+{
+    _lookup_index_clear(&NM_CLIENT_GET_PRIVATE(self)->lookup_devices_by_iface);
+}
+
+/*****************************************************************************/
+
 static NMLDBusObject *
 _dbobjs_dbobj_get_r(NMClient *self, NMRefString *dbus_path_r)
 {
@@ -1646,6 +1739,65 @@ _dbobjs_obj_watcher_unregister(NMClient *self, gpointer obj_watcher_base)
 
 /*****************************************************************************/
 
+static gboolean
+_instance_flags_ignore_meta_iface(NMClientInstanceFlags instance_flags,
+                                  const NMLDBusMetaIface *meta_iface)
+{
+    if (!NM_FLAGS_ANY(instance_flags, NM_CLIENT_INSTANCE_FLAGS_IGNORE_ALL) || !meta_iface)
+        return FALSE;
+
+    if (NM_FLAGS_HAS(instance_flags, NM_CLIENT_INSTANCE_FLAGS_IGNORE_ACCESS_POINTS)
+        && NM_IN_SET(meta_iface,
+                     &_nml_dbus_meta_iface_nm_accesspoint,
+                     &_nml_dbus_meta_iface_nm_wifip2ppeer))
+        return TRUE;
+
+    if (NM_FLAGS_HAS(instance_flags, NM_CLIENT_INSTANCE_FLAGS_IGNORE_IP_CONFIGS)
+        && NM_IN_SET(meta_iface,
+                     &_nml_dbus_meta_iface_nm_ip4config,
+                     &_nml_dbus_meta_iface_nm_ip6config,
+                     &_nml_dbus_meta_iface_nm_dhcp4config,
+                     &_nml_dbus_meta_iface_nm_dhcp6config))
+        return TRUE;
+
+    if (NM_FLAGS_HAS(instance_flags, NM_CLIENT_INSTANCE_FLAGS_IGNORE_CHECKPOINTS)
+        && meta_iface == &_nml_dbus_meta_iface_nm_checkpoint)
+        return TRUE;
+
+    return FALSE;
+}
+
+static gboolean
+_instance_flags_ignore_o_type(NMClientInstanceFlags instance_flags, GType (*get_o_type_fcn)(void))
+{
+    GType gtype;
+
+    if (!NM_FLAGS_ANY(instance_flags, NM_CLIENT_INSTANCE_FLAGS_IGNORE_ALL))
+        return FALSE;
+
+    gtype = get_o_type_fcn();
+
+    if (NM_FLAGS_HAS(instance_flags, NM_CLIENT_INSTANCE_FLAGS_IGNORE_ACCESS_POINTS)
+        && NM_IN_SET(gtype, NM_TYPE_ACCESS_POINT, NM_TYPE_WIFI_P2P_PEER))
+        return TRUE;
+
+    if (NM_FLAGS_HAS(instance_flags, NM_CLIENT_INSTANCE_FLAGS_IGNORE_IP_CONFIGS)
+        && NM_IN_SET(gtype,
+                     NM_TYPE_IP4_CONFIG,
+                     NM_TYPE_IP6_CONFIG,
+                     NM_TYPE_DHCP4_CONFIG,
+                     NM_TYPE_DHCP6_CONFIG))
+        return TRUE;
+
+    if (NM_FLAGS_HAS(instance_flags, NM_CLIENT_INSTANCE_FLAGS_IGNORE_CHECKPOINTS)
+        && gtype == NM_TYPE_CHECKPOINT)
+        return TRUE;
+
+    return FALSE;
+}
+
+/*****************************************************************************/
+
 typedef struct {
     NMLDBusObjWatcher parent;
     NMLDBusPropertyO *pr_o;
@@ -1814,7 +1966,10 @@ nml_dbus_property_o_notify(NMClient               *self,
         nm_assert(pr_o->dbus_property_idx == dbus_property_idx);
     }
 
-    if (value)
+    if (value
+        && !_instance_flags_ignore_o_type(
+            NM_CLIENT_GET_PRIVATE(self)->instance_flags,
+            meta_iface->dbus_properties[dbus_property_idx].extra.property_vtable_o->get_o_type_fcn))
         dbus_path = nm_dbus_path_not_empty(g_variant_get_string(value, NULL));
 
     if (pr_o->obj_watcher
@@ -2177,6 +2332,14 @@ nml_dbus_property_ao_notify(NMClient               *self,
 
     c_list_splice(&stale_lst_head, &pr_ao->data_lst_head);
 
+    if (value
+        && _instance_flags_ignore_o_type(
+            NM_CLIENT_GET_PRIVATE(self)->instance_flags,
+            meta_iface->dbus_properties[dbus_property_idx].extra.property_vtable_ao->get_o_type_fcn)) {
+        /* The referenced objects are not tracked. Pretend the list is empty. */
+        value = NULL;
+    }
+
     if (value) {
         GVariantIter iter;
         const char  *path;
@@ -2970,6 +3133,13 @@ _dbus_handle_properties_changed(NMClient       *self,
     nm_assert(!changed_properties
               || g_variant_is_of_type(changed_properties, G_VARIANT_TYPE("a{sv}")));
 
+    if (_instance_flags_ignore_meta_iface(NM_CLIENT_GET_PRIVATE(self)->instance_flags,
+                                          nml_dbus_meta_iface_get(interface_name))) {
+        /* The user is not interested in this object type. Don't even create
+         * the NMLDBusObject. */
+        return FALSE;
+    }
+
     {
         gs_free char *ss = NULL;
 
@@ -3123,6 +3293,18 @@ _dbus_handle_interface_removed(NMClient          *self,
     } else {
         dbobj = _dbobjs_dbobj_get_s(self, object_path);
         if (!dbobj) {
+            NMClientInstanceFlags instance_flags = NM_CLIENT_GET_PRIVATE(self)->instance_flags;
+
+            for (i = 0; removed_interfaces[i]; i++) {
+                if (!_instance_flags_ignore_meta_iface(
+                        instance_flags,
+                        nml_dbus_meta_iface_get(removed_interfaces[i])))
+                    break;
+            }
+            if (i > 0 && !removed_interfaces[i]) {
+                /* All interfaces are ignored, so we never tracked the object. */
+                return FALSE;
+            }
             NML_NMCLIENT_LOG_E(self,
                                "%s: [%s]: receive interface removed event for non existing object",
                                log_context,
@@ -3267,6 +3449,8 @@ _dbus_properties_changed_cb(GDBusConnection *connection,
         _dbus_handle_changes(self, log_context, TRUE);
 }
 
+static void _nm_client_get_settings_bulk_start(NMClient *self);
+
 static void
 _dbus_get_managed_objects_cb(GObject *source, GAsyncResult *result, gpointer user_data)
 {
@@ -3276,6 +3460,7 @@ _dbus_get_managed_objects_cb(GObject *source, GAsyncResult *result, gpointer use
     gs_unref_variant GVariant *managed_objects      = NULL;
     gs_free_error GError      *error                = NULL;
     gs_unref_object GObject   *context_busy_watcher = NULL;
+    gs_unref_object NMClient  *self_keep_alive      = NULL;
 
     nm_utils_user_data_unpack(user_data, &self, &context_busy_watcher);
 
@@ -3315,13 +3500,193 @@ _dbus_get_managed_objects_cb(GObject *source, GAsyncResult *result, gpointer use
         }
     }
 
+    self_keep_alive = g_object_ref(self);
+
+    /* Registering the connection objects requests their settings. Collect them
+     * and fetch the settings in bulk afterwards. */
+    priv->get_settings_bulk_collect = (managed_objects && !priv->get_settings_bulk_unsupported);
+
     /* always call _dbus_handle_changes(), even if nothing changed. We need this to complete
      * initialization. */
     _dbus_handle_changes(self, "get-managed-objects", TRUE);
+
+    priv->get_settings_bulk_collect = FALSE;
+    if (priv->get_settings_bulk_hash && !priv->get_settings_bulk_cancellable)
+        _nm_client_get_settings_bulk_start(self);
 }
 
 /*****************************************************************************/
 
+#define GET_SETTINGS_BULK_PAGE_SIZE 1000u
+
+static guint32 _get_settings_bulk_page_size = GET_SETTINGS_BULK_PAGE_SIZE;
+
+/* For unit tests, to exercise paging without creating thousands of profiles.
+ * Setting zero restores the default. */
+void
+_nm_client_set_get_settings_bulk_page_size(guint32 page_size)
+{
+    _get_settings_bulk_page_size = page_size ?: GET_SETTINGS_BULK_PAGE_SIZE;
+}
+
+typedef struct {
+    NMLDBusObject *dbobj;
+    GCancellable  *cancellable;
+} GetSettingsBulkData;
+
+static void
+_get_settings_bulk_data_free(gpointer data)
+{
+    GetSettingsBulkData *bulk_data = data;
+
+    nml_dbus_object_unref(bulk_data->dbobj);
+    g_object_unref(bulk_data->cancellable);
+    nm_g_slice_free(bulk_data);
+}
+
+static void
+_get_settings_bulk_data_commit(GetSettingsBulkData *bulk_data, GVariant *settings)
+{
+    /* If the connection was unregistered or a newer GetSettings() call was
+     * started in the meantime, the cancellable got cancelled. */
+    if (!g_cancellable_is_cancelled(bulk_data->cancellable)
+        && NM_IS_REMOTE_CONNECTION(bulk_data->dbobj->nmobj)) {
+        _nm_remote_settings_get_settings_commit(NM_REMOTE_CONNECTION(bulk_data->dbobj->nmobj),
+                                                settings);
+    }
+    _get_settings_bulk_data_free(bulk_data);
+}
+
+static void _nm_client_get_settings_bulk_call_cb(GObject      *source,
+                                                 GAsyncResult *result,
+                                                 gpointer      user_data);
+
+static void
+_nm_client_get_settings_bulk_call(NMClient *self)
+{
+    NMClientPrivate *priv = NM_CLIENT_GET_PRIVATE(self);
+
+    _nm_client_dbus_call_simple(self,
+                                priv->get_settings_bulk_cancellable,
+                                NM_DBUS_PATH_SETTINGS,
+                                NM_DBUS_INTERFACE_SETTINGS,
+                                "GetConnectionsSettings",
+                                g_variant_new("(uu)",
+                                              priv->get_settings_bulk_offset,
+                                              _get_settings_bulk_page_size),
+                                G_VARIANT_TYPE("(a{oa{sa{sv}}}ut)"),
+                                G_DBUS_CALL_FLAGS_NONE,
+                                NM_DBUS_DEFAULT_TIMEOUT_MSEC,
+                                _nm_client_get_settings_bulk_call_cb,
+                                self);
+}
+
+static void
+_nm_client_get_settings_bulk_start(NMClient *self)
+{
+    NMClientPrivate *priv = NM_CLIENT_GET_PRIVATE(self);
+
+    nm_assert(priv->get_settings_bulk_hash);
+    nm_assert(!priv->get_settings_bulk_cancellable);
+
+    NML_NMCLIENT_LOG_T(self,
+                       "GetConnectionsSettings() for %u connections",
+                       g_hash_table_size(priv->get_settings_bulk_hash));
+
+    priv->get_settings_bulk_cancellable = g_cancellable_new();
+    priv->get_settings_bulk_offset      = 0;
+    priv->get_settings_bulk_serial      = 0;
+    _nm_client_get_settings_bulk_call(self);
+}
+
+static void
+_nm_client_get_settings_bulk_call_cb(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+    NMClient                      *self;
+    NMClientPrivate               *priv;
+    gs_unref_variant GVariant     *ret      = NULL;
+    gs_unref_variant GVariant     *settings = NULL;
+    gs_free_error GError          *error    = NULL;
+    gs_unref_hashtable GHashTable *hash     = NULL;
+    GHashTableIter                 h_iter;
+    GetSettingsBulkData           *bulk_data;
+    GVariantIter                   iter;
+    const char                    *object_path;
+    GVariant                      *settings_tmp;
+    guint32                        remaining;
+    guint64                        serial;
+
+    ret = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), result, &error);
+    if (!ret && nm_utils_error_is_cancelled(error))
+        return;
+
+    self = user_data;
+    priv = NM_CLIENT_GET_PRIVATE(self);
+
+    if (!ret) {
+        NML_NMCLIENT_LOG_D(self,
+                           "GetConnectionsSettings() failed: %s. Fall back to GetSettings()",
+                           error->message);
+        if (g_error_matches(error, G_DBUS_ERROR, G_DBUS_ERROR_UNKNOWN_METHOD))
+            priv->get_settings_bulk_unsupported = TRUE;
+
+        g_clear_object(&priv->get_settings_bulk_cancellable);
+        hash = g_steal_pointer(&priv->get_settings_bulk_hash);
+        g_hash_table_iter_init(&h_iter, hash);
+        while (g_hash_table_iter_next(&h_iter, NULL, (gpointer *) &bulk_data)) {
+            if (!g_cancellable_is_cancelled(bulk_data->cancellable)
+                && NM_IS_REMOTE_CONNECTION(bulk_data->dbobj->nmobj))
+                _nm_client_get_settings_call(self, bulk_data->dbobj);
+        }
+        return;
+    }
+
+    g_variant_get(ret, "(@a{oa{sa{sv}}}ut)", &settings, &remaining, &serial);
+
+    g_variant_iter_init(&iter, settings);
+    while (g_variant_iter_next(&iter, "{&o@a{sa{sv}}}", &object_path, &settings_tmp)) {
+        gs_unref_variant GVariant *connection_settings = settings_tmp;
+
+        bulk_data = g_hash_table_lookup(priv->get_settings_bulk_hash, object_path);
+        if (!bulk_data)
+            continue;
+        g_hash_table_steal(priv->get_settings_bulk_hash, object_path);
+        _get_settings_bulk_data_commit(bulk_data, connection_settings);
+    }
+
+    if (g_hash_table_size(priv->get_settings_bulk_hash) > 0) {
+        if (priv->get_settings_bulk_offset > 0 && serial != priv->get_settings_bulk_serial) {
+            /* The list of connections changed between two pages. Connections
+             * might have moved to a page that we already fetched. Start over. */
+            priv->get_settings_bulk_serial = serial;
+            priv->get_settings_bulk_offset = 0;
+            _nm_client_get_settings_bulk_call(self);
+            goto out;
+        }
+        if (remaining > 0) {
+            priv->get_settings_bulk_serial = serial;
+            priv->get_settings_bulk_offset += _get_settings_bulk_page_size;
+            _nm_client_get_settings_bulk_call(self);
+            goto out;
+        }
+    }
+
+    NML_NMCLIENT_LOG_T(self, "GetConnectionsSettings() completed");
+
+    /* The remaining connections are not visible to us. That is the same as
+     * GetSettings() failing. */
+    g_clear_object(&priv->get_settings_bulk_cancellable);
+    hash = g_steal_pointer(&priv->get_settings_bulk_hash);
+    g_hash_table_iter_init(&h_iter, hash);
+    while (g_hash_table_iter_next(&h_iter, NULL, (gpointer *) &bulk_data)) {
+        g_hash_table_iter_steal(&h_iter);
+        _get_settings_bulk_data_commit(bulk_data, NULL);
+    }
+
+out:
+    _dbus_handle_changes_commit(self, TRUE);
+}
+
 static void
 _nm_client_get_settings_call_cb(GObject *source, GAsyncResult *result, gpointer user_data)
 {
@@ -3364,10 +3729,31 @@ _nm_client_get_settings_call_cb(GObject *source, GAsyncResult *result, gpointer
 void
 _nm_client_get_settings_call(NMClient *self, NMLDBusObject *dbobj)
 {
-    GCancellable *cancellable;
+    NMClientPrivate *priv = NM_CLIENT_GET_PRIVATE(self);
+    GCancellable    *cancellable;
 
     cancellable = _nm_remote_settings_get_settings_prepare(NM_REMOTE_CONNECTION(dbobj->nmobj));
 
+    if (priv->get_settings_bulk_collect) {
+        GetSettingsBulkData *bulk_data;
+
+        bulk_data  = g_slice_new(GetSettingsBulkData);
+        *bulk_data = (GetSettingsBulkData){
+            .dbobj       = nml_dbus_object_ref(dbobj),
+            .cancellable = g_object_ref(cancellable),
+        };
+        if (!priv->get_settings_bulk_hash) {
+            priv->get_settings_bulk_hash = g_hash_table_new_full(nm_str_hash,
+                                                                 g_str_equal,
+                                                                 NULL,
+                                                                 _get_settings_bulk_data_free);
+        }
+        g_hash_table_replace(priv->get_settings_bulk_hash,
+                             (gpointer) dbobj->dbus_path->str,
+                             bulk_data);
+        return;
+    }
+
     _nm_client_dbus_call_simple(self,
                                 cancellable,
                                 dbobj->dbus_path->str,
@@ -4909,21 +5295,13 @@ nm_client_get_device_by_path(NMClient *client, const char *object_path)
 NMDevice *
 nm_client_get_device_by_iface(NMClient *client, const char *iface)
 {
-    const GPtrArray *devices;
-    guint            i;
-
     g_return_val_if_fail(NM_IS_CLIENT(client), NULL);
     g_return_val_if_fail(iface, NULL);
 
-    devices = nm_client_get_devices(client);
-    for (i = 0; i < devices->len; i++) {
-        NMDevice *candidate = g_ptr_array_index(devices, i);
-
-        if (nm_streq0(nm_device_get_iface(candidate), iface))
-            return candidate;
-    }
-
-    return NULL;
+    return _lookup_index_find(&NM_CLIENT_GET_PRIVATE(client)->lookup_devices_by_iface,
+                              nm_client_get_devices(client),
+                              _lookup_key_device_iface,
+                              iface);
 }
 
 /*****************************************************************************/
@@ -5125,6 +5503,154 @@ nm_client_activate_connection_finish(NMClient *client, GAsyncResult *result, GEr
         _request_wait_finish(client, result, nm_client_activate_connection_async, NULL, error));
 }
 
+/**
+ * nm_client_activate_connections_async:
+ * @client: a #NMClient
+ * @connections: (array length=n_items) (nullable): the connections to activate.
+ *   Like for nm_client_activate_connection_async(), an entry may be %NULL
+ *   if the corresponding device is given.
+ * @devices: (array length=n_items) (nullable): the devices to activate the
+ *   connections on, or %NULL. Entries may be %NULL.
+ * @specific_objects: (array length=n_items) (nullable): the object paths of
+ *   connection-type-specific objects, or %NULL. Entries may be %NULL.
+ * @n_items: the number of items to activate.
+ * @cancellable: a #GCancellable, or %NULL
+ * @callback: (scope async): callback to be called when the request completes
+ * @user_data: (closure): caller-specific data passed to @callback
+ *
+ * Asynchronously starts the activation of several connections in a single
+ * request. Each item has the same meaning as the arguments of
+ * nm_client_activate_connection_async(). NetworkManager authorizes the
+ * request once and starts the activations of controllers before their ports.
+ *
+ * Unlike nm_client_activate_connection_async(), this does not wait for the
+ * active connections to appear in the client's cache.
+ *
+ * Since: 1.52
+ **/
+void
+nm_client_activate_connections_async(NMClient           *client,
+                                     NMConnection *const *connections,
+                                     NMDevice *const     *devices,
+                                     const char *const   *specific_objects,
+                                     guint               n_items,
+                                     GCancellable       *cancellable,
+                                     GAsyncReadyCallback callback,
+                                     gpointer            user_data)
+{
+    GVariantBuilder builder;
+    guint           i;
+
+    g_return_if_fail(NM_IS_CLIENT(client));
+
+    for (i = 0; i < n_items; i++) {
+        g_return_if_fail(!connections || !connections[i]
+                         || (NM_IS_CONNECTION(connections[i])
+                             && nm_connection_get_path(connections[i])));
+        g_return_if_fail(!devices || !devices[i]
+                         || (NM_IS_DEVICE(devices[i]) && nm_object_get_path(NM_OBJECT(devices[i]))));
+    }
+
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("a(ooo)"));
+    for (i = 0; i < n_items; i++) {
+        g_variant_builder_add(
+            &builder,
+            "(ooo)",
+            (connections && connections[i]) ? nm_connection_get_path(connections[i]) : "/",
+            (devices && devices[i]) ? nm_object_get_path(NM_OBJECT(devices[i])) : "/",
+            (specific_objects ? specific_objects[i] : NULL) ?: "/");
+    }
+
+    NML_NMCLIENT_LOG_T(client, "ActivateConnections() for %u items", n_items);
+
+    _nm_client_dbus_call(client,
+                         client,
+                         nm_client_activate_connections_async,
+                         cancellable,
+                         callback,
+                         user_data,
+                         NM_DBUS_PATH,
+                         NM_DBUS_INTERFACE,
+                         "ActivateConnections",
+                         g_variant_new("(a(ooo)@a{sv})", &builder, nm_g_variant_singleton_aLsvI()),
+                         G_VARIANT_TYPE("(a(os))"),
+                         G_DBUS_CALL_FLAGS_NONE,
+                         NM_DBUS_DEFAULT_TIMEOUT_MSEC,
+                         nm_dbus_connection_call_finish_variant_strip_dbus_error_cb);
+}
+
+/**
+ * nm_client_activate_connections_finish:
+ * @client: an #NMClient
+ * @result: the result passed to the #GAsyncReadyCallback
+ * @out_active_paths: (out) (optional) (transfer full): on success, the D-Bus
+ *   paths of the new active connections, one for each requested item.
+ *   The path is "/" for items that could not be activated.
+ * @out_errors: (out) (optional) (transfer full): on success, an error message
+ *   for each requested item. The message is empty for items whose activation
+ *   was started.
+ * @error: location for a #GError, or %NULL
+ *
+ * Gets the result of a call to nm_client_activate_connections_async().
+ * Note that the request as a whole succeeds even if some items failed to
+ * activate.
+ *
+ * Returns: %TRUE on success, %FALSE on failure, in which case @error will be set.
+ *
+ * Since: 1.52
+ **/
+gboolean
+nm_client_activate_connections_finish(NMClient     *client,
+                                      GAsyncResult *result,
+                                      char       ***out_active_paths,
+                                      char       ***out_errors,
+                                      GError      **error)
+{
+    gs_unref_variant GVariant *ret      = NULL;
+    gs_unref_variant GVariant *v_result = NULL;
+    GVariantIter               iter;
+    const char                *path;
+    const char                *msg;
+    char                     **active_paths;
+    char                     **errors;
+    gsize                      n;
+    gsize                      i;
+
+    g_return_val_if_fail(NM_IS_CLIENT(client), FALSE);
+    g_return_val_if_fail(nm_g_task_is_valid(result, client, nm_client_activate_connections_async),
+                         FALSE);
+
+    ret = g_task_propagate_pointer(G_TASK(result), error);
+    if (!ret)
+        return FALSE;
+
+    g_variant_get(ret, "(@a(os))", &v_result);
+
+    n            = g_variant_n_children(v_result);
+    active_paths = g_new(char *, n + 1);
+    errors       = g_new(char *, n + 1);
+
+    i = 0;
+    g_variant_iter_init(&iter, v_result);
+    while (g_variant_iter_next(&iter, "(&o&s)", &path, &msg)) {
+        active_paths[i] = g_strdup(path);
+        errors[i]       = g_strdup(msg);
+        i++;
+    }
+    active_paths[i] = NULL;
+    errors[i]       = NULL;
+
+    if (out_active_paths)
+        *out_active_paths = active_paths;
+    else
+        g_strfreev(active_paths);
+    if (out_errors)
+        *out_errors = errors;
+    else
+        g_strfreev(errors);
+    return TRUE;
+}
+
 /*****************************************************************************/
 
 static void
@@ -5572,20 +6098,13 @@ nm_client_get_connections(NMClient *client)
 NMRemoteConnection *
 nm_client_get_connection_by_id(NMClient *client, const char *id)
 {
-    const GPtrArray *arr;
-    guint            i;
-
     g_return_val_if_fail(NM_IS_CLIENT(client), NULL);
     g_return_val_if_fail(id, NULL);
 
-    arr = nm_client_get_connections(client);
-    for (i = 0; i < arr->len; i++) {
-        NMRemoteConnection *c = NM_REMOTE_CONNECTION(arr->pdata[i]);
-
-        if (nm_streq0(id, nm_connection_get_id(NM_CONNECTION(c))))
-            return c;
-    }
-    return NULL;
+    return _lookup_index_find(&NM_CLIENT_GET_PRIVATE(client)->lookup_connections_by_id,
+                              nm_client_get_connections(client),
+                              _lookup_key_connection_id,
+                              id);
 }
 
 /**
@@ -5626,20 +6145,13 @@ nm_client_get_connection_by_path(NMClient *client, const char *path)
 NMRemoteConnection *
 nm_client_get_connection_by_uuid(NMClient *client, const char *uuid)
 {
-    const GPtrArray *arr;
-    guint            i;
-
     g_return_val_if_fail(NM_IS_CLIENT(client), NULL);
     g_return_val_if_fail(uuid, NULL);
 
-    arr = nm_client_get_connections(client);
-    for (i = 0; i < arr->len; i++) {
-        NMRemoteConnection *c = NM_REMOTE_CONNECTION(arr->pdata[i]);
-
-        if (nm_streq0(uuid, nm_connection_get_uuid(NM_CONNECTION(c))))
-            return c;
-    }
-    return NULL;
+    return _lookup_index_find(&NM_CLIENT_GET_PRIVATE(client)->lookup_connections_by_uuid,
+                              nm_client_get_connections(client),
+                              _lookup_key_connection_uuid,
+                              uuid);
 }
 
 /*****************************************************************************/
@@ -7048,6 +7560,13 @@ _init_release_all(NMClient *self)
 
     nm_clear_g_cancellable(&priv->permissions_cancellable);
     nm_clear_g_cancellable(&priv->get_managed_objects_cancellable);
+    nm_clear_g_cancellable(&priv->get_settings_bulk_cancellable);
+    nm_clear_pointer(&priv->get_settings_bulk_hash, g_hash_table_destroy);
+    priv->get_settings_bulk_collect     = FALSE;
+    priv->get_settings_bulk_unsupported = FALSE;
+
+    _nm_client_lookup_invalidate_connections(self);
+    _nm_client_lookup_invalidate_devices(self);
 
     nm_clear_g_dbus_connection_signal(priv->dbus_connection, &priv->dbsid_nm_object_manager);
     nm_clear_g_dbus_connection_signal(priv->dbus_connection,
@@ -8270,6 +8789,10 @@ nm_client_class_init(NMClientClass *client_class)
      * The flags %NM_CLIENT_INSTANCE_FLAGS_INITIALIZED_GOOD and %NM_CLIENT_INSTANCE_FLAGS_INITIALIZED_BAD
      * cannot be set, however they will be returned by the getter after initialization completes.
      *
+     * The flags %NM_CLIENT_INSTANCE_FLAGS_IGNORE_ACCESS_POINTS, %NM_CLIENT_INSTANCE_FLAGS_IGNORE_IP_CONFIGS
+     * and %NM_CLIENT_INSTANCE_FLAGS_IGNORE_CHECKPOINTS limit the cache to the object types the
+     * user is interested in. They can only be set during construction.
+     *
      * Since: 1.24
      */
     obj_properties[PROP_INSTANCE_FLAGS] = g_param_spec_uint(
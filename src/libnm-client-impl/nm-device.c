@@ -185,6 +185,25 @@ _notify_event_state_changed(NMClient *client, NMClientNotifyEventWithPtr *notify
                   (guint) priv->state_reason);
 }
 
+static NMLDBusNotifyUpdatePropFlags
+_notify_update_prop_interface(NMClient               *client,
+                              NMLDBusObject          *dbobj,
+                              const NMLDBusMetaIface *meta_iface,
+                              guint                   dbus_property_idx,
+                              GVariant               *value)
+{
+    NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE(dbobj->nmobj);
+
+    /* The interface name is a key in NMClient's index for nm_client_get_device_by_iface(). */
+    _nm_client_lookup_invalidate_devices(client);
+
+    nm_clear_g_free(&priv->interface);
+    if (value)
+        priv->interface = g_variant_dup_string(value, NULL);
+
+    return NML_DBUS_NOTIFY_UPDATE_PROP_FLAGS_NOTIFY;
+}
+
 static NMLDBusNotifyUpdatePropFlags
 _notify_update_prop_state_reason(NMClient               *client,
                                  NMLDBusObject          *dbobj,
@@ -557,7 +576,10 @@ const NMLDBusMetaIface _nml_dbus_meta_iface_nm_device = NML_DBUS_META_IFACE_INIT
                                         0,
                                         "s",
                                         _nm_device_notify_update_prop_hw_address),
-        NML_DBUS_META_PROPERTY_INIT_S("Interface", PROP_INTERFACE, NMDevicePrivate, interface),
+        NML_DBUS_META_PROPERTY_INIT_FCN("Interface",
+                                        PROP_INTERFACE,
+                                        "s",
+                                        _notify_update_prop_interface),
         NML_DBUS_META_PROPERTY_INIT_U("InterfaceFlags",
                                       PROP_INTERFACE_FLAGS,
                                       NMDevicePrivate,
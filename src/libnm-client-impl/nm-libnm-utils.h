@@ -235,10 +235,16 @@ typedef enum {
 
 /*****************************************************************************/
 
+#define NM_CLIENT_INSTANCE_FLAGS_IGNORE_ALL                                  \
+    ((NMClientInstanceFlags) (NM_CLIENT_INSTANCE_FLAGS_IGNORE_ACCESS_POINTS \
+                              | NM_CLIENT_INSTANCE_FLAGS_IGNORE_IP_CONFIGS  \
+                              | NM_CLIENT_INSTANCE_FLAGS_IGNORE_CHECKPOINTS))
+
 #define NM_CLIENT_INSTANCE_FLAGS_ALL                                             \
     ((NMClientInstanceFlags) (NM_CLIENT_INSTANCE_FLAGS_NO_AUTO_FETCH_PERMISSIONS \
                               | NM_CLIENT_INSTANCE_FLAGS_INITIALIZED_GOOD        \
-                              | NM_CLIENT_INSTANCE_FLAGS_INITIALIZED_BAD))
+                              | NM_CLIENT_INSTANCE_FLAGS_INITIALIZED_BAD         \
+                              | NM_CLIENT_INSTANCE_FLAGS_IGNORE_ALL))
 
 #define NM_CLIENT_INSTANCE_FLAGS_ALL_WRITABLE                                                       \
     ((NMClientInstanceFlags) (NM_CLIENT_INSTANCE_FLAGS_ALL                                          \
@@ -928,6 +934,11 @@ void _nm_client_queue_notify_object(NMClient *client, gpointer nmobj, const GPar
 
 void _nm_client_notify_object_changed(NMClient *self, NMLDBusObject *dbobj);
 
+void _nm_client_lookup_invalidate_connections(NMClient *self);
+void _nm_client_lookup_invalidate_devices(NMClient *self);
+
+void _nm_client_set_get_settings_bulk_page_size(guint32 page_size);
+
 struct udev *_nm_client_get_udev(NMClient *self);
 
 /*****************************************************************************/
@@ -880,6 +880,18 @@ nm_remote_connection_class_init(NMRemoteConnectionClass *klass)
                                               &_nml_dbus_meta_iface_nm_settings_connection);
 }
 
+static void
+changed(NMConnection *connection)
+{
+    NMClient *client = _nm_object_get_client(connection);
+
+    /* The UUID and ID are keys in NMClient's lookup indexes. */
+    if (client)
+        _nm_client_lookup_invalidate_connections(client);
+}
+
 static void
 nm_remote_connection_connection_iface_init(NMConnectionInterface *iface)
-{}
+{
+    iface->changed = changed;
+}
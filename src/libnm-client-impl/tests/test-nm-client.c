@@ -361,6 +361,48 @@ test_wifi_ap_added_removed(void)
     g_free(info.ap_path);
 }
 
+static void
+test_wifi_ap_ignored(void)
+{
+    nmtstc_auto_service_cleanup NMTstcServiceInfo *sinfo  = NULL;
+    gs_unref_object NMClient                      *client = NULL;
+    NMDeviceWifi                                  *wifi;
+    GVariant                                      *ret;
+    GError                                        *error = NULL;
+
+    sinfo = nmtstc_service_init();
+    if (!nmtstc_service_available(sinfo))
+        return;
+
+    client = nmtstc_context_object_new(NM_TYPE_CLIENT,
+                                       TRUE,
+                                       NM_CLIENT_INSTANCE_FLAGS,
+                                       (guint) NM_CLIENT_INSTANCE_FLAGS_IGNORE_ACCESS_POINTS,
+                                       NULL);
+    g_assert(NM_FLAGS_HAS(nm_client_get_instance_flags(client),
+                          NM_CLIENT_INSTANCE_FLAGS_IGNORE_ACCESS_POINTS));
+
+    wifi = (NMDeviceWifi *) nmtstc_service_add_device(sinfo, client, "AddWifiDevice", "wlan0");
+    g_assert(NM_IS_DEVICE_WIFI(wifi));
+
+    ret = g_dbus_proxy_call_sync(sinfo->proxy,
+                                 "AddWifiAp",
+                                 g_variant_new("(sss)", "wlan0", "test-ap", expected_bssid),
+                                 G_DBUS_CALL_FLAGS_NO_AUTO_START,
+                                 3000,
+                                 NULL,
+                                 &error);
+    g_assert_no_error(error);
+    nm_clear_pointer(&ret, g_variant_unref);
+
+    /* Signals are delivered in order. Once the next device shows up, the
+     * AP signals were processed too. */
+    nmtstc_service_add_device(sinfo, client, "AddWiredDevice", "eth0");
+
+    g_assert_cmpint(nm_device_wifi_get_access_points(wifi)->len, ==, 0);
+    g_assert(!nm_device_wifi_get_active_access_point(wifi));
+}
+
 /*****************************************************************************/
 
 typedef struct {
@@ -491,6 +533,8 @@ test_devices_array(void)
     device = nm_client_get_device_by_iface(client, "eth1");
     g_assert(NM_IS_DEVICE_ETHERNET(device));
     g_assert(device == eth1);
+
+    g_assert(!nm_client_get_device_by_iface(client, "eth0"));
 }
 
 static void
@@ -933,6 +977,90 @@ test_activate_virtual_teardown(gconstpointer user_data)
     }
 }
 
+typedef struct {
+    GMainLoop *loop;
+    char     **active_paths;
+    char     **errors;
+} TestActivateManyInfo;
+
+static void
+activate_many_cb(GObject *object, GAsyncResult *result, gpointer user_data)
+{
+    TestActivateManyInfo *info  = user_data;
+    GError               *error = NULL;
+    gboolean              success;
+
+    success = nm_client_activate_connections_finish(NM_CLIENT(object),
+                                                    result,
+                                                    &info->active_paths,
+                                                    &info->errors,
+                                                    &error);
+    g_assert_no_error(error);
+    g_assert(success);
+    g_main_loop_quit(info->loop);
+}
+
+static void
+test_activate_many(void)
+{
+    nmtstc_auto_service_cleanup NMTstcServiceInfo *sinfo  = NULL;
+    gs_unref_object NMClient                      *client = NULL;
+    gs_unref_object NMConnection                  *conn1  = NULL;
+    gs_unref_object NMConnection                  *conn2  = NULL;
+    NMConnection                                  *conn;
+    NMDevice                                      *device;
+    TestConnectionInfo                             conn_info = {gl.loop, NULL};
+    TestActivateManyInfo                           info      = {gl.loop, NULL, NULL};
+
+    sinfo = nmtstc_service_init();
+    if (!nmtstc_service_available(sinfo))
+        return;
+
+    client = nmtstc_client_new(TRUE);
+
+    device = nmtstc_service_add_device(sinfo, client, "AddWiredDevice", "eth0");
+
+    conn = nmtst_create_minimal_connection("test-ac-1", NULL, NM_SETTING_WIRED_SETTING_NAME, NULL);
+    nm_client_add_connection_async(client, conn, TRUE, NULL, add_connection_cb, &conn_info);
+    g_main_loop_run(gl.loop);
+    g_object_unref(conn);
+    conn1 = NM_CONNECTION(g_steal_pointer(&conn_info.remote));
+
+    conn = nmtst_create_minimal_connection("test-ac-2", NULL, NM_SETTING_WIRED_SETTING_NAME, NULL);
+    nm_client_add_connection_async(client, conn, TRUE, NULL, add_connection_cb, &conn_info);
+    g_main_loop_run(gl.loop);
+    g_object_unref(conn);
+    conn2 = NM_CONNECTION(g_steal_pointer(&conn_info.remote));
+
+    /* The second item has neither a profile nor a device and fails. That
+     * must not affect the items before and after it. */
+    nm_client_activate_connections_async(client,
+                                         (NMConnection *[]){conn1, NULL, conn2},
+                                         (NMDevice *[]){device, NULL, NULL},
+                                         NULL,
+                                         3,
+                                         NULL,
+                                         activate_many_cb,
+                                         &info);
+    g_main_loop_run(gl.loop);
+
+    g_assert_cmpint(NM_PTRARRAY_LEN(info.active_paths), ==, 3);
+    g_assert_cmpint(NM_PTRARRAY_LEN(info.errors), ==, 3);
+
+    g_assert_cmpstr(info.active_paths[0], !=, "/");
+    g_assert_cmpstr(info.errors[0], ==, "");
+
+    g_assert_cmpstr(info.active_paths[1], ==, "/");
+    g_assert_cmpstr(info.errors[1], !=, "");
+
+    g_assert_cmpstr(info.active_paths[2], !=, "/");
+    g_assert_cmpstr(info.active_paths[2], !=, info.active_paths[0]);
+    g_assert_cmpstr(info.errors[2], ==, "");
+
+    g_strfreev(info.active_paths);
+    g_strfreev(info.errors);
+}
+
 static void
 test_device_connection_compatibility(void)
 {
@@ -1112,6 +1240,13 @@ test_connection_invalid(void)
     nmtst_assert_connection_unnormalizable(connections->pdata[idx[1]], 0, 0);
     nmtst_assert_connection_unnormalizable(connections->pdata[idx[2]], 0, 0);
 
+    g_assert(nm_client_get_connection_by_id(client, "test-connection-invalid-1")
+             == connections->pdata[idx[1]]);
+    g_assert(nm_client_get_connection_by_uuid(
+                 client,
+                 nm_connection_get_uuid(connections->pdata[idx[0]]))
+             == connections->pdata[idx[0]]);
+
     /**************************************************************************
      * After having the client up and running, add another invalid connection
      *************************************************************************/
@@ -1124,6 +1259,7 @@ test_connection_invalid(void)
                  NM_SETTING_CONNECTION_UUID,
                  (uuid2 = g_strdup(nmtst_uuid_generate())),
                  NULL);
+    g_assert(!nm_client_get_connection_by_uuid(client, uuid2));
     nmtstc_service_add_connection(my_sinfo, connection, FALSE, &path3);
 
     nmtst_main_loop_run(gl.loop, 1000);
@@ -1149,6 +1285,8 @@ test_connection_invalid(void)
     nmtst_assert_connection_unnormalizable(connections->pdata[idx[2]], 0, 0);
     nmtst_assert_connection_unnormalizable(connections->pdata[idx[3]], 0, 0);
 
+    g_assert(nm_client_get_connection_by_uuid(client, uuid2) == connections->pdata[idx[3]]);
+
     /**************************************************************************
      * Modify the invalid connection (still invalid)
      *************************************************************************/
@@ -1600,6 +1738,7 @@ main(int argc, char **argv)
     g_test_add_func("/libnm/device-added", test_device_added);
     g_test_add_func("/libnm/device-added-signal-after-init", test_device_added_signal_after_init);
     g_test_add_func("/libnm/wifi-ap-added-removed", test_wifi_ap_added_removed);
+    g_test_add_func("/libnm/wifi-ap-ignored", test_wifi_ap_ignored);
     g_test_add_func("/libnm/devices-array", test_devices_array);
     g_test_add_func("/libnm/client-nm-running", test_client_nm_running);
     g_test_add_func("/libnm/active-connections", test_active_connections);
@@ -1610,6 +1749,7 @@ main(int argc, char **argv)
     g_test_add_data_func("/libnm/activate-virtual/with-teardown/client",
                          GINT_TO_POINTER(false),
                          test_activate_virtual_teardown);
+    g_test_add_func("/libnm/activate-many", test_activate_many);
     g_test_add_func("/libnm/device-connection-compatibility", test_device_connection_compatibility);
     g_test_add_func("/libnm/connection/invalid", test_connection_invalid);
     g_test_add_func("/libnm/test_client_wait_shutdown", test_client_wait_shutdown);
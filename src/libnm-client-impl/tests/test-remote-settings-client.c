@@ -458,6 +458,291 @@ test_save_hostname(void)
 
 /*****************************************************************************/
 
+typedef struct {
+    GVariant *ret;
+    GError   *error;
+    gboolean  done;
+} ApplyConnectionsData;
+
+static void
+apply_connections_cb(GObject *s, GAsyncResult *result, gpointer user_data)
+{
+    ApplyConnectionsData *data = user_data;
+
+    data->ret  = nm_client_dbus_call_finish(gl.client, result, &data->error);
+    data->done = TRUE;
+}
+
+static GVariant *
+_apply_connections(GVariantBuilder *operations, GError **error)
+{
+    ApplyConnectionsData data = {};
+
+    nm_client_dbus_call(gl.client,
+                        NM_DBUS_PATH_SETTINGS,
+                        NM_DBUS_INTERFACE_SETTINGS,
+                        "ApplyConnections",
+                        g_variant_new("(a(soa{sa{sv}})u@a{sv})",
+                                      operations,
+                                      (guint32) NM_SETTINGS_ADD_CONNECTION2_FLAG_IN_MEMORY,
+                                      g_variant_new_array(G_VARIANT_TYPE("{sv}"), NULL, 0)),
+                        G_VARIANT_TYPE("(a(os))"),
+                        -1,
+                        NULL,
+                        apply_connections_cb,
+                        &data);
+
+    nmtst_main_context_iterate_until_assert(NULL, 5000, data.done);
+
+    g_propagate_error(error, data.error);
+    return data.ret;
+}
+
+static void
+_apply_connections_add_op(GVariantBuilder *operations,
+                          const char      *kind,
+                          const char      *path,
+                          NMConnection    *connection)
+{
+    GVariant *settings;
+
+    if (connection)
+        settings = nm_connection_to_dbus(connection, NM_CONNECTION_SERIALIZE_ALL);
+    else
+        settings = g_variant_new_array(G_VARIANT_TYPE("{sa{sv}}"), NULL, 0);
+
+    g_variant_builder_add(operations, "(so@a{sa{sv}})", kind, path, settings);
+}
+
+static void
+_apply_connections_assert_result(GVariant   *ret,
+                                 guint       idx,
+                                 const char *expected_path,
+                                 const char *expected_error)
+{
+    gs_unref_variant GVariant *results = NULL;
+    const char                *path;
+    const char                *error_msg;
+
+    results = g_variant_get_child_value(ret, 0);
+    g_assert_cmpint(idx, <, g_variant_n_children(results));
+    g_variant_get_child(results, idx, "(&o&s)", &path, &error_msg);
+    if (expected_path)
+        g_assert_cmpstr(path, ==, expected_path);
+    else
+        g_assert_cmpstr(path, !=, "/");
+    g_assert_cmpstr(error_msg, ==, expected_error);
+}
+
+static void
+test_apply_connections(void)
+{
+    gs_unref_object NMConnection *con_a  = NULL;
+    gs_unref_object NMConnection *con_b  = NULL;
+    gs_unref_object NMConnection *con_c  = NULL;
+    gs_unref_variant GVariant    *ret    = NULL;
+    gs_free_error GError         *error  = NULL;
+    gs_free char                 *path_a = NULL;
+    gs_free char                 *path_b = NULL;
+    NMRemoteConnection           *remote_a;
+    NMRemoteConnection           *remote_b;
+    GVariantBuilder               operations;
+
+    if (!nmtstc_service_available(gl.sinfo))
+        return;
+
+    con_a = nmtst_create_minimal_connection("apply-a", NULL, NM_SETTING_WIRED_SETTING_NAME, NULL);
+    con_b = nmtst_create_minimal_connection("apply-b", NULL, NM_SETTING_WIRED_SETTING_NAME, NULL);
+    con_c = nmtst_create_minimal_connection("apply-c", NULL, NM_SETTING_WIRED_SETTING_NAME, NULL);
+
+    /* Add two profiles with one call. */
+    g_variant_builder_init(&operations, G_VARIANT_TYPE("a(soa{sa{sv}})"));
+    _apply_connections_add_op(&operations, "add", "/", con_a);
+    _apply_connections_add_op(&operations, "add", "/", con_b);
+    ret = _apply_connections(&operations, &error);
+    nmtst_assert_success(ret, error);
+    _apply_connections_assert_result(ret, 0, NULL, "");
+    _apply_connections_assert_result(ret, 1, NULL, "");
+
+    nmtst_main_context_iterate_until_assert(
+        NULL,
+        5000,
+        nm_client_get_connection_by_uuid(gl.client, nm_connection_get_uuid(con_a))
+            && nm_client_get_connection_by_uuid(gl.client, nm_connection_get_uuid(con_b)));
+    remote_a = nm_client_get_connection_by_uuid(gl.client, nm_connection_get_uuid(con_a));
+    remote_b = nm_client_get_connection_by_uuid(gl.client, nm_connection_get_uuid(con_b));
+    path_a   = g_strdup(nm_connection_get_path(NM_CONNECTION(remote_a)));
+    path_b   = g_strdup(nm_connection_get_path(NM_CONNECTION(remote_b)));
+    nm_clear_pointer(&ret, g_variant_unref);
+
+    /* An invalid operation fails the whole call, and the valid update
+     * before it is not applied. */
+    g_object_set(nm_connection_get_setting_connection(con_a),
+                 NM_SETTING_CONNECTION_ID,
+                 "apply-a-renamed",
+                 NULL);
+    g_variant_builder_init(&operations, G_VARIANT_TYPE("a(soa{sa{sv}})"));
+    _apply_connections_add_op(&operations, "update", path_a, con_a);
+    _apply_connections_add_op(&operations, "delete", NM_DBUS_PATH_SETTINGS "/999", NULL);
+    ret = _apply_connections(&operations, &error);
+    g_assert_error(error, NM_SETTINGS_ERROR, NM_SETTINGS_ERROR_INVALID_ARGUMENTS);
+    g_assert(!ret);
+    g_clear_error(&error);
+
+    /* Each profile may only be referenced once. */
+    g_variant_builder_init(&operations, G_VARIANT_TYPE("a(soa{sa{sv}})"));
+    _apply_connections_add_op(&operations, "update", path_a, con_a);
+    _apply_connections_add_op(&operations, "delete", path_a, NULL);
+    ret = _apply_connections(&operations, &error);
+    g_assert_error(error, NM_SETTINGS_ERROR, NM_SETTINGS_ERROR_INVALID_ARGUMENTS);
+    g_assert(!ret);
+    g_clear_error(&error);
+
+    g_assert(nm_client_get_connection_by_path(gl.client, path_a) == remote_a);
+    g_assert(nm_client_get_connection_by_path(gl.client, path_b) == remote_b);
+    g_assert_cmpstr(nm_connection_get_id(NM_CONNECTION(remote_a)), ==, "apply-a");
+
+    /* Update, delete and add in one call. */
+    g_variant_builder_init(&operations, G_VARIANT_TYPE("a(soa{sa{sv}})"));
+    _apply_connections_add_op(&operations, "update", path_a, con_a);
+    _apply_connections_add_op(&operations, "delete", path_b, NULL);
+    _apply_connections_add_op(&operations, "add", "/", con_c);
+    ret = _apply_connections(&operations, &error);
+    nmtst_assert_success(ret, error);
+    _apply_connections_assert_result(ret, 0, path_a, "");
+    _apply_connections_assert_result(ret, 1, "/", "");
+    _apply_connections_assert_result(ret, 2, NULL, "");
+
+    nmtst_main_context_iterate_until_assert(
+        NULL,
+        5000,
+        !nm_client_get_connection_by_path(gl.client, path_b)
+            && nm_client_get_connection_by_uuid(gl.client, nm_connection_get_uuid(con_c))
+            && nm_streq0(nm_connection_get_id(NM_CONNECTION(remote_a)), "apply-a-renamed"));
+}
+
+/*****************************************************************************/
+
+static void
+_get_settings_call_counts(guint32 *out_n_get_settings, guint32 *out_n_get_connections_settings)
+{
+    gs_unref_variant GVariant *ret   = NULL;
+    gs_free_error GError      *error = NULL;
+
+    ret = g_dbus_proxy_call_sync(gl.sinfo->proxy,
+                                 "GetSettingsCallCounts",
+                                 NULL,
+                                 G_DBUS_CALL_FLAGS_NONE,
+                                 -1,
+                                 NULL,
+                                 &error);
+    nmtst_assert_success(ret, error);
+    g_variant_get(ret, "(uu)", out_n_get_settings, out_n_get_connections_settings);
+}
+
+static gboolean
+_client_has_connections(NMClient *client, const char *const *uuids, guint n_uuids)
+{
+    guint i;
+
+    for (i = 0; i < n_uuids; i++) {
+        if (!nm_client_get_connection_by_uuid(client, uuids[i]))
+            return FALSE;
+    }
+    return TRUE;
+}
+
+#define N_BULK_CONNECTIONS 5
+
+static void
+test_get_settings_bulk(void)
+{
+    gs_unref_object NMClient  *client = NULL;
+    gs_unref_variant GVariant *ret    = NULL;
+    gs_free_error GError      *error  = NULL;
+    char                      *uuids[N_BULK_CONNECTIONS];
+    const GPtrArray           *connections;
+    guint32                    n_get_settings_before;
+    guint32                    n_get_settings;
+    guint32                    n_bulk_before;
+    guint32                    n_bulk;
+    guint                      n_missing = 0;
+    guint                      i;
+
+    if (!nmtstc_service_available(gl.sinfo))
+        return;
+
+    for (i = 0; i < N_BULK_CONNECTIONS; i++) {
+        gs_unref_object NMConnection *connection = NULL;
+        gs_free char                 *id         = g_strdup_printf("bulk-%u", i);
+
+        connection =
+            nmtst_create_minimal_connection(id, NULL, NM_SETTING_WIRED_SETTING_NAME, NULL);
+        uuids[i] = g_strdup(nm_connection_get_uuid(connection));
+        nmtstc_service_add_connection(gl.sinfo, connection, TRUE, NULL);
+    }
+
+    /* Let the long-lived client fetch the new profiles first, so that its
+     * GetSettings() calls don't show up in the counts below. */
+    nmtst_main_context_iterate_until_assert(NULL,
+                                            5000,
+                                            _client_has_connections(gl.client,
+                                                                    (const char *const *) uuids,
+                                                                    N_BULK_CONNECTIONS));
+
+    /* The service deletes the first profile right before it answers the
+     * second page. The profiles behind it move one position up, so one of
+     * them would be skipped if the client didn't notice the changed serial
+     * and start over. */
+    ret = g_dbus_proxy_call_sync(gl.sinfo->proxy,
+                                 "AutoRemoveBetweenSettingsPages",
+                                 NULL,
+                                 G_DBUS_CALL_FLAGS_NONE,
+                                 -1,
+                                 NULL,
+                                 &error);
+    nmtst_assert_success(ret, error);
+
+    _get_settings_call_counts(&n_get_settings_before, &n_bulk_before);
+
+    _nm_client_set_get_settings_bulk_page_size(2);
+    client = nmtstc_client_new(TRUE);
+    _nm_client_set_get_settings_bulk_page_size(0);
+
+    _get_settings_call_counts(&n_get_settings, &n_bulk);
+
+    /* At least two pages, and one more after the restart. No profile was
+     * fetched individually. */
+    g_assert_cmpint(n_bulk - n_bulk_before, >=, 3);
+    g_assert_cmpint(n_get_settings, ==, n_get_settings_before);
+
+    for (i = 0; i < N_BULK_CONNECTIONS; i++) {
+        gs_free char       *id = g_strdup_printf("bulk-%u", i);
+        NMRemoteConnection *remote;
+
+        remote = nm_client_get_connection_by_uuid(client, uuids[i]);
+        if (!remote) {
+            /* The profile that the service deleted between the pages. */
+            n_missing++;
+            continue;
+        }
+        g_assert(nm_remote_connection_get_visible(remote));
+        g_assert_cmpstr(nm_connection_get_id(NM_CONNECTION(remote)), ==, id);
+    }
+    g_assert_cmpint(n_missing, <=, 1);
+
+    /* A profile that was skipped would be committed without settings and
+     * look invisible. */
+    connections = nm_client_get_connections(client);
+    for (i = 0; i < connections->len; i++)
+        g_assert(nm_remote_connection_get_visible(connections->pdata[i]));
+
+    for (i = 0; i < N_BULK_CONNECTIONS; i++)
+        g_free(uuids[i]);
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE();
 
 int
@@ -487,6 +772,8 @@ main(int argc, char **argv)
     g_test_add_func("/client/add_remove_connection", test_add_remove_connection);
     g_test_add_func("/client/add_bad_connection", test_add_bad_connection);
     g_test_add_func("/client/save_hostname", test_save_hostname);
+    g_test_add_func("/client/apply_connections", test_apply_connections);
+    g_test_add_func("/client/get_settings_bulk", test_get_settings_bulk);
 
     ret = g_test_run();
 
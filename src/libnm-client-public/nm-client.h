@@ -29,6 +29,15 @@ G_BEGIN_DECLS
  * @NM_CLIENT_INSTANCE_FLAGS_INITIALIZED_BAD: like @NM_CLIENT_INSTANCE_FLAGS_INITIALIZED_GOOD
  *   indicates that the instance completed initialization with failure. In that
  *   case the instance is unusable. Since: 1.42.
+ * @NM_CLIENT_INSTANCE_FLAGS_IGNORE_ACCESS_POINTS: don't track Wi-Fi access points
+ *   and Wi-Fi P2P peers. The objects are not created and D-Bus signals for them
+ *   are dropped early, so that properties like #NMDeviceWifi:access-points stay
+ *   empty. This flag can only be set during construction. Since: 1.52.
+ * @NM_CLIENT_INSTANCE_FLAGS_IGNORE_IP_CONFIGS: don't track #NMIPConfig and
+ *   #NMDhcpConfig objects of devices and active connections. This flag can
+ *   only be set during construction. Since: 1.52.
+ * @NM_CLIENT_INSTANCE_FLAGS_IGNORE_CHECKPOINTS: don't track #NMCheckpoint
+ *   objects. This flag can only be set during construction. Since: 1.52.
  *
  * Since: 1.24
  */
@@ -37,6 +46,9 @@ typedef enum /*< flags >*/ {
     NM_CLIENT_INSTANCE_FLAGS_NO_AUTO_FETCH_PERMISSIONS = 0x1,
     NM_CLIENT_INSTANCE_FLAGS_INITIALIZED_GOOD          = 0x2,
     NM_CLIENT_INSTANCE_FLAGS_INITIALIZED_BAD           = 0x4,
+    NM_CLIENT_INSTANCE_FLAGS_IGNORE_ACCESS_POINTS      = 0x8,
+    NM_CLIENT_INSTANCE_FLAGS_IGNORE_IP_CONFIGS         = 0x10,
+    NM_CLIENT_INSTANCE_FLAGS_IGNORE_CHECKPOINTS        = 0x20,
 } NMClientInstanceFlags;
 
 #define NM_TYPE_CLIENT            (nm_client_get_type())
@@ -314,6 +326,22 @@ void nm_client_activate_connection_async(NMClient           *client,
 NMActiveConnection *
 nm_client_activate_connection_finish(NMClient *client, GAsyncResult *result, GError **error);
 
+NM_AVAILABLE_IN_1_52
+void nm_client_activate_connections_async(NMClient           *client,
+                                          NMConnection *const *connections,
+                                          NMDevice *const     *devices,
+                                          const char *const   *specific_objects,
+                                          guint               n_items,
+                                          GCancellable       *cancellable,
+                                          GAsyncReadyCallback callback,
+                                          gpointer            user_data);
+NM_AVAILABLE_IN_1_52
+gboolean nm_client_activate_connections_finish(NMClient     *client,
+                                               GAsyncResult *result,
+                                               char       ***out_active_paths,
+                                               char       ***out_errors,
+                                               GError      **error);
+
 void                nm_client_add_and_activate_connection_async(NMClient           *client,
                                                                 NMConnection       *partial,
                                                                 NMDevice           *device,
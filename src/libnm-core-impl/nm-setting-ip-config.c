@@ -596,6 +596,11 @@ struct NMIPRoute {
     GHashTable *attributes;
 
     gint64 metric;
+
+    /* @dest and @next_hop in binary form, so that they don't need to be
+     * parsed again. @next_hop_bin is zero if there is no next hop. */
+    NMIPAddr dest_bin;
+    NMIPAddr next_hop_bin;
 };
 
 /**
@@ -638,12 +643,14 @@ nm_ip_route_new(int         family,
 
     route  = g_slice_new(NMIPRoute);
     *route = (NMIPRoute){
-        .refcount = 1,
-        .family   = family,
-        .dest     = canonicalize_ip_binary(family, &dest_bin, FALSE),
-        .prefix   = prefix,
-        .next_hop = canonicalize_ip_binary(family, next_hop ? &next_hop_bin : NULL, TRUE),
-        .metric   = metric,
+        .refcount     = 1,
+        .family       = family,
+        .dest         = canonicalize_ip_binary(family, &dest_bin, FALSE),
+        .prefix       = prefix,
+        .next_hop     = canonicalize_ip_binary(family, next_hop ? &next_hop_bin : NULL, TRUE),
+        .metric       = metric,
+        .dest_bin     = dest_bin,
+        .next_hop_bin = next_hop ? next_hop_bin : nm_ip_addr_zero,
     };
 
     return route;
@@ -691,6 +698,9 @@ nm_ip_route_new_binary(int           family,
         .next_hop = canonicalize_ip_binary(family, next_hop, TRUE),
         .metric   = metric,
     };
+    nm_ip_addr_set(family, &route->dest_bin, dest);
+    if (route->next_hop)
+        nm_ip_addr_set(family, &route->next_hop_bin, next_hop);
 
     return route;
 }
@@ -762,8 +772,9 @@ nm_ip_route_equal_full(NMIPRoute *route, NMIPRoute *other, guint cmp_flags)
                          FALSE);
 
     if (route->prefix != other->prefix || route->metric != other->metric
-        || strcmp(route->dest, other->dest) != 0
-        || g_strcmp0(route->next_hop, other->next_hop) != 0)
+        || route->family != other->family
+        || !nm_ip_addr_equal(route->family, &route->dest_bin, &other->dest_bin)
+        || !nm_ip_addr_equal(route->family, &route->next_hop_bin, &other->next_hop_bin))
         return FALSE;
     if (cmp_flags == NM_IP_ROUTE_EQUAL_CMP_FLAGS_WITH_ATTRS) {
         GHashTableIter iter;
@@ -826,12 +837,12 @@ nm_ip_route_dup(NMIPRoute *route)
     g_return_val_if_fail(route != NULL, NULL);
     g_return_val_if_fail(route->refcount > 0, NULL);
 
-    copy = nm_ip_route_new(route->family,
-                           route->dest,
-                           route->prefix,
-                           route->next_hop,
-                           route->metric,
-                           NULL);
+    copy = nm_ip_route_new_binary(route->family,
+                                  &route->dest_bin,
+                                  route->prefix,
+                                  route->next_hop ? &route->next_hop_bin : NULL,
+                                  route->metric,
+                                  NULL);
     if (route->attributes) {
         GHashTableIter iter;
         const char    *key;
@@ -903,7 +914,8 @@ nm_ip_route_set_dest(NMIPRoute *route, const char *dest)
     }
 
     g_free(route->dest);
-    route->dest = canonicalize_ip_binary(route->family, &dest_bin, FALSE);
+    route->dest     = canonicalize_ip_binary(route->family, &dest_bin, FALSE);
+    route->dest_bin = dest_bin;
 }
 
 /**
@@ -921,7 +933,7 @@ nm_ip_route_get_dest_binary(NMIPRoute *route, gpointer dest)
     g_return_if_fail(route != NULL);
     g_return_if_fail(dest != NULL);
 
-    inet_pton(route->family, route->dest, dest);
+    nm_ip_addr_set(route->family, dest, &route->dest_bin);
 }
 
 /**
@@ -941,6 +953,7 @@ nm_ip_route_set_dest_binary(NMIPRoute *route, gconstpointer dest)
 
     g_free(route->dest);
     route->dest = nm_inet_ntop_dup(route->family, dest);
+    nm_ip_addr_set(route->family, &route->dest_bin, dest);
 }
 
 /**
@@ -1019,6 +1032,7 @@ nm_ip_route_set_next_hop(NMIPRoute *route, const char *next_hop)
 
     g_free(route->next_hop);
     route->next_hop = canonicalize_ip_binary(route->family, next_hop ? &next_hop_bin : NULL, TRUE);
+    route->next_hop_bin = route->next_hop ? next_hop_bin : nm_ip_addr_zero;
 }
 
 /**
@@ -1040,7 +1054,7 @@ nm_ip_route_get_next_hop_binary(NMIPRoute *route, gpointer next_hop)
     g_return_val_if_fail(next_hop != NULL, FALSE);
 
     if (route->next_hop) {
-        inet_pton(route->family, route->next_hop, next_hop);
+        nm_ip_addr_set(route->family, next_hop, &route->next_hop_bin);
         return TRUE;
     } else {
         memset(next_hop, 0, nm_utils_addr_family_to_size(route->family));
@@ -1065,6 +1079,10 @@ nm_ip_route_set_next_hop_binary(NMIPRoute *route, gconstpointer next_hop)
 
     g_free(route->next_hop);
     route->next_hop = canonicalize_ip_binary(route->family, next_hop, TRUE);
+    if (route->next_hop)
+        nm_ip_addr_set(route->family, &route->next_hop_bin, next_hop);
+    else
+        route->next_hop_bin = nm_ip_addr_zero;
 }
 
 /**
@@ -4808,6 +4826,82 @@ nm_setting_ip_config_add_route(NMSettingIPConfig *setting, NMIPRoute *route)
     return TRUE;
 }
 
+static guint
+_ip_route_hash(gconstpointer ptr)
+{
+    const NMIPRoute *route = ptr;
+    NMHashState      h;
+
+    nm_hash_init(&h, 1847613043u);
+    nm_hash_update_vals(&h, route->family, route->prefix, route->metric);
+    nm_hash_update_mem(&h, &route->dest_bin, nm_utils_addr_family_to_size(route->family));
+    nm_hash_update_mem(&h, &route->next_hop_bin, nm_utils_addr_family_to_size(route->family));
+    return nm_hash_complete(&h);
+}
+
+static gboolean
+_ip_route_equal(gconstpointer a, gconstpointer b)
+{
+    return nm_ip_route_equal_full((NMIPRoute *) a,
+                                  (NMIPRoute *) b,
+                                  NM_IP_ROUTE_EQUAL_CMP_FLAGS_WITH_ATTRS);
+}
+
+/**
+ * _nm_setting_ip_config_add_routes:
+ * @setting: the #NMSettingIPConfig
+ * @routes: the routes to add
+ * @len: the number of routes in @routes
+ *
+ * Like calling nm_setting_ip_config_add_route() for each route in @routes,
+ * but duplicates are detected via a hash table instead of a linear search
+ * for each route, and the property is only notified once.
+ *
+ * Returns: the number of routes that were added.
+ */
+guint
+_nm_setting_ip_config_add_routes(NMSettingIPConfig *setting, NMIPRoute *const *routes, guint len)
+{
+    NMSettingIPConfigPrivate      *priv;
+    gs_unref_hashtable GHashTable *idx     = NULL;
+    guint                          n_added = 0;
+    guint                          i;
+
+    g_return_val_if_fail(NM_IS_SETTING_IP_CONFIG(setting), 0);
+    g_return_val_if_fail(routes || len == 0, 0);
+
+    if (len == 0)
+        return 0;
+
+    /* Validate all routes first, so that we don't add only some of them. */
+    for (i = 0; i < len; i++) {
+        g_return_val_if_fail(routes[i], 0);
+        g_return_val_if_fail(routes[i]->family == NM_SETTING_IP_CONFIG_GET_ADDR_FAMILY(setting), 0);
+    }
+
+    priv = NM_SETTING_IP_CONFIG_GET_PRIVATE(setting);
+
+    idx = g_hash_table_new(_ip_route_hash, _ip_route_equal);
+    for (i = 0; i < priv->routes->len; i++)
+        g_hash_table_add(idx, priv->routes->pdata[i]);
+
+    for (i = 0; i < len; i++) {
+        NMIPRoute *route;
+
+        if (g_hash_table_contains(idx, routes[i]))
+            continue;
+
+        route = nm_ip_route_dup(routes[i]);
+        g_ptr_array_add(priv->routes, route);
+        g_hash_table_add(idx, route);
+        n_added++;
+    }
+
+    if (n_added > 0)
+        _notify(setting, PROP_ROUTES);
+    return n_added;
+}
+
 /**
  * nm_setting_ip_config_remove_route:
  * @setting: the #NMSettingIPConfig
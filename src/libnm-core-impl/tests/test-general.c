@@ -4582,6 +4582,54 @@ test_setting_compare_routes(void)
     nm_clear_pointer(&result, g_hash_table_unref);
 }
 
+static void
+test_setting_add_routes(void)
+{
+    gs_unref_object NMSetting *s   = NULL;
+    NMSettingIPConfig         *sip = NULL;
+    NMIPRoute                 *routes[5];
+    NMIPAddr                   addr;
+    guint                      i;
+
+    s   = nm_setting_ip4_config_new();
+    sip = NM_SETTING_IP_CONFIG(s);
+
+    routes[0] = nm_ip_route_new(AF_INET, "192.168.12.0", 24, "192.168.11.1", 473, NULL);
+    routes[1] = nm_ip_route_new(AF_INET, "192.168.12.0", 24, NULL, 473, NULL);
+    routes[2] = nm_ip_route_new(AF_INET, "192.168.12.0", 24, "192.168.11.1", 473, NULL);
+    routes[3] = nm_ip_route_dup(routes[0]);
+    nm_ip_route_set_attribute(routes[3], NM_IP_ROUTE_ATTRIBUTE_MTU, g_variant_new_uint32(1400));
+    routes[4] = nm_ip_route_new(AF_INET, "10.0.0.0", 8, "192.168.11.1", 473, NULL);
+
+    g_assert(nm_ip_route_equal(routes[0], routes[2]));
+    g_assert(!nm_ip_route_equal(routes[0], routes[1]));
+
+    nm_ip_route_set_dest(routes[4], "10.1.0.0");
+    nm_ip_route_get_dest_binary(routes[4], &addr);
+    g_assert_cmpint(addr.addr4, ==, nmtst_inet4_from_string("10.1.0.0"));
+    nm_ip_route_set_next_hop(routes[4], NULL);
+    g_assert(!nm_ip_route_get_next_hop_binary(routes[4], &addr));
+
+    g_assert(nm_setting_ip_config_add_route(sip, routes[0]));
+    g_assert_cmpint(_nm_setting_ip_config_add_routes(sip, routes, G_N_ELEMENTS(routes)), ==, 3);
+    g_assert_cmpint(nm_setting_ip_config_get_num_routes(sip), ==, 4);
+    g_assert_cmpint(_nm_setting_ip_config_add_routes(sip, routes, G_N_ELEMENTS(routes)), ==, 0);
+
+    /* A route of the wrong family rejects the whole list. */
+    nm_ip_route_unref(routes[1]);
+    routes[1] = nm_ip_route_new(AF_INET, "192.168.13.0", 24, NULL, 473, NULL);
+    nm_ip_route_unref(routes[2]);
+    routes[2] = nm_ip_route_new(AF_INET6, "1:2::", 64, NULL, 473, NULL);
+    NMTST_EXPECT_LIBNM_CRITICAL(
+        NMTST_G_RETURN_MSG(routes[i]->family == NM_SETTING_IP_CONFIG_GET_ADDR_FAMILY(setting)));
+    g_assert_cmpint(_nm_setting_ip_config_add_routes(sip, routes, G_N_ELEMENTS(routes)), ==, 0);
+    g_test_assert_expected_messages();
+    g_assert_cmpint(nm_setting_ip_config_get_num_routes(sip), ==, 4);
+
+    for (i = 0; i < G_N_ELEMENTS(routes); i++)
+        nm_ip_route_unref(routes[i]);
+}
+
 static void
 test_setting_compare_wired_cloned_mac_address(void)
 {
@@ -11643,6 +11691,7 @@ main(int argc, char **argv)
     g_test_add_func("/core/general/test_setting_compare_id", test_setting_compare_id);
     g_test_add_func("/core/general/test_setting_compare_addresses", test_setting_compare_addresses);
     g_test_add_func("/core/general/test_setting_compare_routes", test_setting_compare_routes);
+    g_test_add_func("/core/general/test_setting_add_routes", test_setting_add_routes);
     g_test_add_func("/core/general/test_setting_compare_wired_cloned_mac_address",
                     test_setting_compare_wired_cloned_mac_address);
     g_test_add_func("/core/general/test_setting_compare_wirless_cloned_mac_address",
@@ -1179,6 +1179,9 @@ gboolean _nm_ip_tunnel_mode_is_layer2(NMIPTunnelMode mode);
 
 GPtrArray *_nm_setting_ip_config_get_dns_array(NMSettingIPConfig *setting);
 
+guint
+_nm_setting_ip_config_add_routes(NMSettingIPConfig *setting, NMIPRoute *const *routes, guint len);
+
 gboolean nm_connection_need_secrets_for_rerequest(NMConnection *connection);
 
 const GPtrArray *_nm_setting_ovs_port_get_trunks_arr(NMSettingOvsPort *self);
@@ -15,13 +15,47 @@
 
 /*****************************************************************************/
 
+/* Changes are not written by rewriting the entire file, but by appending
+ * them to a journal file next to it ("$filename.journal"). Each line in
+ * the journal is either "$key=$value" (set the raw value) or "$key" (remove
+ * the key). On load, the journal is replayed on top of the file.
+ *
+ * The first line of the journal is a header with the SHA256 checksum of
+ * the file that the records apply to. A journal whose header does not match
+ * the file is ignored. That happens if we crash after rewriting the file but
+ * before deleting the journal, or if somebody else (like an older version
+ * that does not know about the journal) rewrote the file in the meantime.
+ *
+ * Once the journal grows larger than the file itself (but at least
+ * JOURNAL_COMPACT_MIN_SIZE), the file is rewritten atomically and the
+ * journal deleted. A record is only valid if terminated by a newline,
+ * so a torn write at the end of the journal is ignored. */
+#define JOURNAL_SUFFIX           ".journal"
+#define JOURNAL_HEADER_PREFIX    "#base-sha256="
+#define JOURNAL_COMPACT_MIN_SIZE ((gsize) (64 * 1024))
+
 struct _NMKeyFileDB {
     NMKeyFileDBLogFcn      log_fcn;
     NMKeyFileDBGotDirtyFcn got_dirty_fcn;
     gpointer               user_data;
     const char            *group_name;
+    const char            *journal_filename;
     GKeyFile              *kf;
-    guint                  ref_count;
+
+    /* the checksum of the file as we last read or wrote it. */
+    char *base_checksum;
+
+    /* the keys that changed since the last write. */
+    GHashTable *pending_keys;
+
+    gsize base_size;
+    gsize journal_size;
+
+    guint   n_appends;
+    guint   n_compactions;
+    guint64 bytes_written;
+
+    guint ref_count;
 
     bool is_started : 1;
     bool dirty : 1;
@@ -29,6 +63,14 @@ struct _NMKeyFileDB {
 
     bool groups_pruned : 1;
 
+    /* the file needs to be rewritten on the next write. */
+    bool needs_compact : 1;
+
+    /* the journal ends with an incomplete record, or it does not belong
+     * to the current file. We must not append to it anymore, until it
+     * gets deleted by the next compaction. */
+    bool journal_unusable : 1;
+
     char filename[];
 };
 
@@ -93,7 +135,8 @@ nm_key_file_db_new(const char            *filename,
     l_filename = strlen(filename);
     l_group    = strlen(group_name);
 
-    self                = g_malloc0(sizeof(NMKeyFileDB) + l_filename + 1 + l_group + 1);
+    self = g_malloc0(sizeof(NMKeyFileDB) + l_filename + 1 + l_group + 1 + l_filename
+                     + NM_STRLEN(JOURNAL_SUFFIX) + 1);
     self->ref_count     = 1;
     self->log_fcn       = log_fcn;
     self->got_dirty_fcn = got_dirty_fcn;
@@ -102,6 +145,11 @@ nm_key_file_db_new(const char            *filename,
     memcpy(self->filename, filename, l_filename + 1);
     self->group_name = &self->filename[l_filename + 1];
     memcpy((char *) self->group_name, group_name, l_group + 1);
+    self->journal_filename = &self->group_name[l_group + 1];
+    memcpy((char *) self->journal_filename, filename, l_filename);
+    memcpy((char *) &self->journal_filename[l_filename],
+           JOURNAL_SUFFIX,
+           NM_STRLEN(JOURNAL_SUFFIX) + 1);
 
     return self;
 }
@@ -131,6 +179,8 @@ nm_key_file_db_unref(NMKeyFileDB *self)
         return;
 
     g_key_file_unref(self->kf);
+    nm_g_hash_table_unref(self->pending_keys);
+    g_free(self->base_checksum);
 
     g_free(self);
 }
@@ -166,24 +216,21 @@ nm_key_file_db_destroy(NMKeyFileDB *self)
 
 /*****************************************************************************/
 
-/* nm_key_file_db_start() is supposed to be called right away, after creating the
- * instance.
- *
- * It's not done as separate step after nm_key_file_db_new(), because we want to log,
- * and the log_fcn returns the self pointer (which we should not expose before
- * nm_key_file_db_new() returns. */
-void
-nm_key_file_db_start(NMKeyFileDB *self)
+static void
+_base_checksum_set(NMKeyFileDB *self, const char *contents, gsize contents_len)
+{
+    g_free(self->base_checksum);
+    self->base_checksum =
+        g_compute_checksum_for_data(G_CHECKSUM_SHA256, (const guchar *) contents, contents_len);
+}
+
+static void
+_base_load(NMKeyFileDB *self)
 {
     gs_free char         *contents = NULL;
     gsize                 contents_len;
     gs_free_error GError *error = NULL;
 
-    g_return_if_fail(_IS_KEY_FILE_DB(self, FALSE, FALSE));
-    g_return_if_fail(!self->is_started);
-
-    self->is_started = TRUE;
-
     if (!nm_utils_file_get_contents(-1,
                                     self->filename,
                                     20 * 1024 * 1024,
@@ -193,9 +240,12 @@ nm_key_file_db_start(NMKeyFileDB *self)
                                     NULL,
                                     &error)) {
         _LOGD("failed to read \"%s\": %s", self->filename, error->message);
+        _base_checksum_set(self, "", 0);
         return;
     }
 
+    _base_checksum_set(self, contents, contents_len);
+
     if (!g_key_file_load_from_data(self->kf,
                                    contents,
                                    contents_len,
@@ -205,9 +255,108 @@ nm_key_file_db_start(NMKeyFileDB *self)
         return;
     }
 
+    self->base_size = contents_len;
+
     _LOGD("loaded keyfile-db for \"%s\"", self->filename);
 }
 
+static void
+_journal_load(NMKeyFileDB *self)
+{
+    gs_free char         *contents = NULL;
+    gsize                 contents_len;
+    gs_free_error GError *error = NULL;
+    const char           *end;
+    const char           *line;
+    gsize                 line_len;
+    const char           *cur;
+    gsize                 cur_len;
+    gs_free char         *header    = NULL;
+    guint                 n_records = 0;
+
+    if (!nm_utils_file_get_contents(-1,
+                                    self->journal_filename,
+                                    20 * 1024 * 1024,
+                                    NM_UTILS_FILE_GET_CONTENTS_FLAG_NONE,
+                                    &contents,
+                                    &contents_len,
+                                    NULL,
+                                    &error)) {
+        if (!nm_utils_error_is_notfound(error))
+            _LOGD("failed to read journal \"%s\": %s", self->journal_filename, error->message);
+        return;
+    }
+
+    self->journal_size = contents_len;
+
+    if (contents_len == 0)
+        return;
+
+    /* Only consider records terminated by a newline. Anything after the last
+     * newline is a torn write, which we drop. */
+    end     = memrchr(contents, '\n', contents_len);
+    cur_len = end ? (gsize) (end - contents) + 1u : 0u;
+    if (cur_len != contents_len) {
+        _LOGD("ignore incomplete record at the end of journal \"%s\"", self->journal_filename);
+        self->journal_unusable = TRUE;
+    }
+
+    cur    = contents;
+    header = g_strconcat(JOURNAL_HEADER_PREFIX, self->base_checksum, NULL);
+    if (!nm_utils_parse_next_line(&cur, &cur_len, &line, &line_len) || line_len != strlen(header)
+        || memcmp(line, header, line_len) != 0) {
+        _LOGD("ignore journal \"%s\" which does not belong to \"%s\"",
+              self->journal_filename,
+              self->filename);
+        self->journal_unusable = TRUE;
+        return;
+    }
+
+    while (nm_utils_parse_next_line(&cur, &cur_len, &line, &line_len)) {
+        gs_free char *key = NULL;
+        const char   *eq;
+
+        if (line_len == 0)
+            continue;
+
+        eq = memchr(line, '=', line_len);
+        if (eq == line)
+            continue;
+
+        if (eq) {
+            gs_free char *value = NULL;
+
+            key   = g_strndup(line, eq - line);
+            value = g_strndup(&eq[1], line_len - (eq - line) - 1u);
+            g_key_file_set_value(self->kf, self->group_name, key, value);
+        } else {
+            key = g_strndup(line, line_len);
+            g_key_file_remove_key(self->kf, self->group_name, key, NULL);
+        }
+        n_records++;
+    }
+
+    _LOGD("replayed %u records from journal \"%s\"", n_records, self->journal_filename);
+}
+
+/* nm_key_file_db_start() is supposed to be called right away, after creating the
+ * instance.
+ *
+ * It's not done as separate step after nm_key_file_db_new(), because we want to log,
+ * and the log_fcn returns the self pointer (which we should not expose before
+ * nm_key_file_db_new() returns. */
+void
+nm_key_file_db_start(NMKeyFileDB *self)
+{
+    g_return_if_fail(_IS_KEY_FILE_DB(self, FALSE, FALSE));
+    g_return_if_fail(!self->is_started);
+
+    self->is_started = TRUE;
+
+    _base_load(self);
+    _journal_load(self);
+}
+
 /*****************************************************************************/
 
 const char *
@@ -246,11 +395,24 @@ nm_key_file_db_get_string_list(NMKeyFileDB *self, const char *key, gsize *out_le
 
 /*****************************************************************************/
 
+static void
+_pending_add(NMKeyFileDB *self, const char *key)
+{
+    if (!self->pending_keys)
+        self->pending_keys = g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, NULL);
+    if (!g_hash_table_contains(self->pending_keys, key))
+        g_hash_table_add(self->pending_keys, g_strdup(key));
+}
+
 static void
 _got_dirty(NMKeyFileDB *self, const char *key)
 {
     nm_assert(_IS_KEY_FILE_DB(self, TRUE, FALSE));
-    nm_assert(!self->dirty);
+
+    _pending_add(self, key);
+
+    if (self->dirty)
+        return;
 
     _LOGD("updated entry for %s.%s", self->group_name, key);
 
@@ -264,30 +426,26 @@ _got_dirty(NMKeyFileDB *self, const char *key)
 void
 nm_key_file_db_remove_key(NMKeyFileDB *self, const char *key)
 {
-    gboolean got_dirty = FALSE;
-
     g_return_if_fail(_IS_KEY_FILE_DB(self, TRUE, FALSE));
 
     if (!key)
         return;
 
-    if (!self->dirty) {
-        gs_free_error GError *error = NULL;
+    /* We always check whether the key changed (and not only when we are
+     * not yet dirty), because we need to track which keys to write to
+     * the journal. */
+    if (!g_key_file_has_key(self->kf, self->group_name, key, NULL))
+        return;
 
-        g_key_file_has_key(self->kf, self->group_name, key, &error);
-        got_dirty = (error != NULL);
-    }
     g_key_file_remove_key(self->kf, self->group_name, key, NULL);
-
-    if (got_dirty)
-        _got_dirty(self, key);
+    _got_dirty(self, key);
 }
 
 void
 nm_key_file_db_set_value(NMKeyFileDB *self, const char *key, const char *value)
 {
     gs_free char *old_value = NULL;
-    gboolean      got_dirty = FALSE;
+    gs_free char *new_value = NULL;
 
     g_return_if_fail(_IS_KEY_FILE_DB(self, TRUE, FALSE));
     g_return_if_fail(key);
@@ -297,26 +455,12 @@ nm_key_file_db_set_value(NMKeyFileDB *self, const char *key, const char *value)
         return;
     }
 
-    if (!self->dirty) {
-        gs_free_error GError *error = NULL;
-
-        old_value = g_key_file_get_value(self->kf, self->group_name, key, &error);
-        if (error)
-            got_dirty = TRUE;
-    }
+    old_value = g_key_file_get_value(self->kf, self->group_name, key, NULL);
 
     g_key_file_set_value(self->kf, self->group_name, key, value);
 
-    if (!self->dirty && !got_dirty) {
-        gs_free_error GError *error     = NULL;
-        gs_free char         *new_value = NULL;
-
-        new_value = g_key_file_get_value(self->kf, self->group_name, key, &error);
-        if (error || !new_value || !nm_streq0(old_value, new_value))
-            got_dirty = TRUE;
-    }
-
-    if (got_dirty)
+    new_value = g_key_file_get_value(self->kf, self->group_name, key, NULL);
+    if (!new_value || !nm_streq0(old_value, new_value))
         _got_dirty(self, key);
 }
 
@@ -327,7 +471,7 @@ nm_key_file_db_set_string_list(NMKeyFileDB       *self,
                                gssize             len)
 {
     gs_free char *old_value = NULL;
-    gboolean      got_dirty = FALSE;
+    gs_free char *new_value = NULL;
 
     g_return_if_fail(_IS_KEY_FILE_DB(self, TRUE, FALSE));
     g_return_if_fail(key);
@@ -337,39 +481,162 @@ nm_key_file_db_set_string_list(NMKeyFileDB       *self,
         return;
     }
 
-    if (!self->dirty) {
-        gs_free_error GError *error = NULL;
-
-        old_value = g_key_file_get_value(self->kf, self->group_name, key, &error);
-        if (error)
-            got_dirty = TRUE;
-    }
+    old_value = g_key_file_get_value(self->kf, self->group_name, key, NULL);
 
     if (len < 0)
         len = NM_PTRARRAY_LEN(value);
 
     g_key_file_set_string_list(self->kf, self->group_name, key, value, len);
 
-    if (!self->dirty && !got_dirty) {
-        gs_free_error GError *error     = NULL;
-        gs_free char         *new_value = NULL;
+    new_value = g_key_file_get_value(self->kf, self->group_name, key, NULL);
+    if (!new_value || !nm_streq0(old_value, new_value))
+        _got_dirty(self, key);
+}
+
+/*****************************************************************************/
 
-        new_value = g_key_file_get_value(self->kf, self->group_name, key, &error);
-        if (error || !new_value || !nm_streq0(old_value, new_value))
-            got_dirty = TRUE;
+static gboolean
+_journal_append(NMKeyFileDB *self)
+{
+    nm_auto_free_gstring GString *str = NULL;
+    nm_auto_close int             fd  = -1;
+    GHashTableIter                iter;
+    const char                   *key;
+    const char                   *buf;
+    gsize                         len;
+    guint                         n_records;
+
+    n_records = nm_g_hash_table_size(self->pending_keys);
+    if (n_records == 0)
+        return TRUE;
+
+    str = g_string_new(NULL);
+    if (self->journal_size == 0) {
+        /* A new journal. Tie it to the current file. */
+        g_string_append(str, JOURNAL_HEADER_PREFIX);
+        g_string_append(str, self->base_checksum);
+        g_string_append_c(str, '\n');
     }
+    g_hash_table_iter_init(&iter, self->pending_keys);
+    while (g_hash_table_iter_next(&iter, (gpointer *) &key, NULL)) {
+        gs_free char *value = NULL;
 
-    if (got_dirty)
-        _got_dirty(self, key);
+        if (!key[0] || strpbrk(key, "=\n\r")) {
+            /* Cannot be represented in the journal. */
+            return FALSE;
+        }
+
+        value = g_key_file_get_value(self->kf, self->group_name, key, NULL);
+        if (value && strpbrk(value, "\n\r"))
+            return FALSE;
+
+        g_string_append(str, key);
+        if (value) {
+            g_string_append_c(str, '=');
+            g_string_append(str, value);
+        }
+        g_string_append_c(str, '\n');
+    }
+
+    fd = open(self->journal_filename, O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0666);
+    if (fd < 0) {
+        _LOGD("failure to open journal \"%s\": %s",
+              self->journal_filename,
+              nm_strerror_native(errno));
+        return FALSE;
+    }
+
+    buf = str->str;
+    len = str->len;
+    while (len > 0) {
+        gssize n;
+
+        n = write(fd, buf, len);
+        if (n < 0) {
+            int errsv = errno;
+
+            if (errsv == EINTR)
+                continue;
+
+            _LOGD("failure to write journal \"%s\": %s",
+                  self->journal_filename,
+                  nm_strerror_native(errsv));
+            /* We may have written part of a record. That one is ignored on
+             * load, but we must not append more records after it. */
+            self->journal_size += str->len - len;
+            self->bytes_written += str->len - len;
+            if (len != str->len)
+                self->journal_unusable = TRUE;
+            return FALSE;
+        }
+        buf += n;
+        len -= n;
+    }
+
+    self->journal_size += str->len;
+    self->bytes_written += str->len;
+    self->n_appends++;
+    g_hash_table_remove_all(self->pending_keys);
+
+    _LOGD("append %u records (%zu bytes) to journal \"%s\" (%u appends, %u compactions, "
+          "%" G_GUINT64_FORMAT " bytes written)",
+          n_records,
+          str->len,
+          self->journal_filename,
+          self->n_appends,
+          self->n_compactions,
+          self->bytes_written);
+    return TRUE;
 }
 
-/*****************************************************************************/
+static void
+_compact(NMKeyFileDB *self)
+{
+    gs_free_error GError *error    = NULL;
+    gs_free char         *contents = NULL;
+    gsize                 contents_len;
+
+    contents = g_key_file_to_data(self->kf, &contents_len, NULL);
+
+    if (!g_file_set_contents(self->filename, contents, contents_len, &error)) {
+        _LOGD("failure to write keyfile \"%s\": %s", self->filename, error->message);
+        return;
+    }
+
+    _base_checksum_set(self, contents, contents_len);
+    self->base_size = contents_len;
+    self->bytes_written += contents_len;
+    self->n_compactions++;
+    self->needs_compact = FALSE;
+    nm_clear_pointer(&self->pending_keys, g_hash_table_unref);
+
+    /* The file now contains everything from the journal. If we fail to
+     * delete the journal (or crash before), its header no longer matches
+     * the file and it gets ignored on load. But we also must not append
+     * to it, so retry on the next write. */
+    if (unlink(self->journal_filename) != 0 && errno != ENOENT) {
+        _LOGD("failure to delete journal \"%s\": %s",
+              self->journal_filename,
+              nm_strerror_native(errno));
+        self->journal_unusable = TRUE;
+        return;
+    }
+
+    self->journal_size     = 0;
+    self->journal_unusable = FALSE;
+
+    _LOGD("write keyfile: \"%s\" (%zu bytes, %u appends, %u compactions, %" G_GUINT64_FORMAT
+          " bytes written)",
+          self->filename,
+          contents_len,
+          self->n_appends,
+          self->n_compactions,
+          self->bytes_written);
+}
 
 void
 nm_key_file_db_to_file(NMKeyFileDB *self, gboolean force)
 {
-    gs_free_error GError *error = NULL;
-
     g_return_if_fail(_IS_KEY_FILE_DB(self, TRUE, FALSE));
 
     if (!force && !self->dirty)
@@ -377,10 +644,15 @@ nm_key_file_db_to_file(NMKeyFileDB *self, gboolean force)
 
     self->dirty = FALSE;
 
-    if (!g_key_file_save_to_file(self->kf, self->filename, &error)) {
-        _LOGD("failure to write keyfile \"%s\": %s", self->filename, error->message);
-    } else
-        _LOGD("write keyfile: \"%s\"", self->filename);
+    /* Append the changes to the journal first, even if we are about to
+     * compact. That way, they are not lost if the compaction fails. If
+     * it succeeds, the journal no longer matches the file and is ignored. */
+    if (!self->journal_unusable && !_journal_append(self))
+        self->needs_compact = TRUE;
+
+    if (force || self->needs_compact || self->journal_unusable
+        || self->journal_size > NM_MAX(JOURNAL_COMPACT_MIN_SIZE, self->base_size))
+        _compact(self);
 }
 
 /*****************************************************************************/
@@ -452,6 +724,7 @@ nm_key_file_db_prune(NMKeyFileDB *self,
         self->kf            = _key_file_new();
         kf_src              = kf_to_free;
         self->groups_pruned = TRUE;
+        self->needs_compact = TRUE;
         self->dirty         = TRUE;
     } else
         kf_src = self->kf;
@@ -466,10 +739,10 @@ nm_key_file_db_prune(NMKeyFileDB *self,
             keep = predicate(key, user_data);
 
             if (!keep) {
-                if (kf_dst == kf_src) {
+                if (kf_dst == kf_src)
                     g_key_file_remove_key(kf_dst, self->group_name, key, NULL);
-                    self->dirty = TRUE;
-                }
+                _pending_add(self, key);
+                self->dirty = TRUE;
                 continue;
             }
 
@@ -13,6 +13,7 @@
 #include "libnm-glib-aux/nm-time-utils.h"
 #include "libnm-glib-aux/nm-ref-string.h"
 #include "libnm-glib-aux/nm-io-utils.h"
+#include "libnm-glib-aux/nm-keyfile-aux.h"
 #include "libnm-glib-aux/nm-prioq.h"
 
 #include "libnm-glib-aux/nm-test-utils.h"
@@ -2848,6 +2849,129 @@ compare_ip6_addresses(void)
 
 /*****************************************************************************/
 
+static NMKeyFileDB *
+_kf_db_new_started(const char *filename)
+{
+    NMKeyFileDB *kf_db;
+
+    kf_db = nm_key_file_db_new(filename, "timestamps", NULL, NULL, NULL);
+    nm_key_file_db_start(kf_db);
+    return kf_db;
+}
+
+static void
+_kf_db_assert_value(NMKeyFileDB *kf_db, const char *key, const char *expected)
+{
+    gs_free char *value = NULL;
+
+    value = nm_key_file_db_get_value(kf_db, key);
+    g_assert_cmpstr(value, ==, expected);
+}
+
+static void
+test_nm_key_file_db(void)
+{
+    gs_free_error GError *error    = NULL;
+    gs_free char         *tmpdir   = NULL;
+    gs_free char         *filename = NULL;
+    gs_free char         *journal  = NULL;
+    gs_free char         *contents = NULL;
+    NMKeyFileDB          *kf_db;
+
+    tmpdir = g_dir_make_tmp("nm-test-kf-db-XXXXXX", &error);
+    nmtst_assert_success(tmpdir, error);
+    filename = g_build_filename(tmpdir, "timestamps", NULL);
+    journal  = g_strconcat(filename, ".journal", NULL);
+
+    /* Small changes are only appended to the journal. */
+    kf_db = _kf_db_new_started(filename);
+    nm_key_file_db_set_value(kf_db, "uuid-1", "100");
+    nm_key_file_db_set_value(kf_db, "uuid-2", "200");
+    nm_key_file_db_to_file(kf_db, FALSE);
+    nm_key_file_db_set_value(kf_db, "uuid-1", "101");
+    nm_key_file_db_remove_key(kf_db, "uuid-2");
+    nm_key_file_db_to_file(kf_db, FALSE);
+    nm_key_file_db_destroy(kf_db);
+    g_assert(!g_file_test(filename, G_FILE_TEST_EXISTS));
+    g_assert(g_file_test(journal, G_FILE_TEST_EXISTS));
+
+    kf_db = _kf_db_new_started(filename);
+    _kf_db_assert_value(kf_db, "uuid-1", "101");
+    _kf_db_assert_value(kf_db, "uuid-2", NULL);
+    nm_key_file_db_destroy(kf_db);
+
+    /* A torn record at the end of the journal is ignored, and the next write
+     * compacts the file. */
+    {
+        gs_free char *journal_contents = nmtst_file_get_contents(journal);
+
+        contents = g_strconcat(journal_contents, "uuid-1=99", NULL);
+    }
+    nmtst_file_set_contents(journal, contents);
+    kf_db = _kf_db_new_started(filename);
+    _kf_db_assert_value(kf_db, "uuid-1", "101");
+    nm_key_file_db_set_value(kf_db, "uuid-3", "300");
+    nm_key_file_db_to_file(kf_db, FALSE);
+    nm_key_file_db_destroy(kf_db);
+    g_assert(g_file_test(filename, G_FILE_TEST_EXISTS));
+    g_assert(!g_file_test(journal, G_FILE_TEST_EXISTS));
+
+    kf_db = _kf_db_new_started(filename);
+    _kf_db_assert_value(kf_db, "uuid-1", "101");
+    _kf_db_assert_value(kf_db, "uuid-3", "300");
+    nm_key_file_db_set_value(kf_db, "uuid-3", "301");
+    nm_key_file_db_to_file(kf_db, FALSE);
+    g_assert(g_file_test(journal, G_FILE_TEST_EXISTS));
+
+    /* Forcing a write compacts the file. */
+    nm_key_file_db_to_file(kf_db, TRUE);
+    nm_key_file_db_destroy(kf_db);
+    g_assert(!g_file_test(journal, G_FILE_TEST_EXISTS));
+
+    kf_db = _kf_db_new_started(filename);
+    _kf_db_assert_value(kf_db, "uuid-1", "101");
+    _kf_db_assert_value(kf_db, "uuid-3", "301");
+
+    /* A journal left over from before the last compaction (as after a crash
+     * before deleting it) does not override the file. */
+    nm_key_file_db_set_value(kf_db, "uuid-3", "302");
+    nm_key_file_db_to_file(kf_db, FALSE);
+    nm_clear_g_free(&contents);
+    contents = nmtst_file_get_contents(journal);
+    nm_key_file_db_set_value(kf_db, "uuid-3", "303");
+    nm_key_file_db_to_file(kf_db, TRUE);
+    nm_key_file_db_destroy(kf_db);
+    g_assert(!g_file_test(journal, G_FILE_TEST_EXISTS));
+    nmtst_file_set_contents(journal, contents);
+
+    kf_db = _kf_db_new_started(filename);
+    _kf_db_assert_value(kf_db, "uuid-1", "101");
+    _kf_db_assert_value(kf_db, "uuid-3", "303");
+    nm_key_file_db_set_value(kf_db, "uuid-4", "400");
+    nm_key_file_db_to_file(kf_db, FALSE);
+    nm_key_file_db_destroy(kf_db);
+    g_assert(!g_file_test(journal, G_FILE_TEST_EXISTS));
+
+    /* Neither does a journal for a file that somebody else rewrote. */
+    kf_db = _kf_db_new_started(filename);
+    nm_key_file_db_set_value(kf_db, "uuid-4", "401");
+    nm_key_file_db_to_file(kf_db, FALSE);
+    nm_key_file_db_destroy(kf_db);
+    g_assert(g_file_test(journal, G_FILE_TEST_EXISTS));
+    nmtst_file_set_contents(filename, "[timestamps]\nuuid-4=402\n");
+
+    kf_db = _kf_db_new_started(filename);
+    _kf_db_assert_value(kf_db, "uuid-1", NULL);
+    _kf_db_assert_value(kf_db, "uuid-4", "402");
+    nm_key_file_db_destroy(kf_db);
+    nmtst_file_unlink(journal);
+
+    nmtst_file_unlink(filename);
+    g_assert_cmpint(rmdir(tmpdir), ==, 0);
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE();
 
 int
@@ -2884,6 +3008,7 @@ main(int argc, char **argv)
     g_test_add_func("/general/test_nm_g_source_sentinel", test_nm_g_source_sentinel);
     g_test_add_func("/general/test_nm_ascii", test_nm_ascii);
     g_test_add_func("/general/test_parse_env_file", test_parse_env_file);
+    g_test_add_func("/general/test_nm_key_file_db", test_nm_key_file_db);
     g_test_add_func("/general/test_unbase64char", test_unbase64char);
     g_test_add_func("/general/test_unbase64mem1", test_unbase64mem1);
     g_test_add_func("/general/test_unbase64mem2", test_unbase64mem2);
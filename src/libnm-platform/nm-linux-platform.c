@@ -3105,9 +3105,10 @@ _wireguard_create_change_nlmsgs(NMPlatform                               *platfo
     idx_peer_curr        = IDX_NIL;
     idx_allowed_ips_curr = IDX_NIL;
 
-    /* TODO: for the moment, we always reset all peers and allowed-ips (WGDEVICE_F_REPLACE_PEERS, WGPEER_F_REPLACE_ALLOWEDIPS).
-     * The platform API should be extended to also support partial updates. In particular, configuring the same configuration
-     * multiple times, should not clear and re-add all settings, but rather sync the existing settings with the desired configuration. */
+    /* Whether all peers get replaced (WGDEVICE_F_REPLACE_PEERS) is up to the caller. Otherwise, only the
+     * peers in @peers are touched, according to their @peer_flags. That allows callers to only add, update
+     * or remove (WGPEER_F_REMOVE_ME) the peers that changed. The peers are split across multiple messages,
+     * if they don't fit into one. */
 
 again:
 
@@ -6282,6 +6283,7 @@ sysctl_set(NMPlatform *platform, const char *pathid, int dirfd, const char *path
         return FALSE;
     }
 
+    nm_platform_sysctl_account(platform, 0, 1);
     return sysctl_set_internal(platform, pathid, dirfd, path, value);
 }
 
@@ -6428,6 +6430,10 @@ sysctl_set_async(NMPlatform             *platform,
     } else
         dirfd_dup = -1;
 
+    /* The values are written on a worker thread. Account them here, on the
+     * main thread. */
+    nm_platform_sysctl_account(platform, 0, NM_PTRARRAY_LEN(values));
+
     info                = g_slice_new0(SysctlAsyncInfo);
     info->platform      = g_object_ref(platform);
     info->pathid        = g_strdup(pathid);
@@ -6587,6 +6593,8 @@ sysctl_get(NMPlatform *platform, const char *pathid, int dirfd, const char *path
         pathid = path;
     }
 
+    nm_platform_sysctl_account(platform, 1, 0);
+
     if (!nm_utils_file_get_contents(dirfd,
                                     path,
                                     1 * 1024 * 1024,
@@ -9403,6 +9411,10 @@ link_set_sriov_params_async(NMPlatform             *platform,
     sriov_async_call_next_step(async_state);
 }
 
+/* Sends the settings of all VFs in a single RTM_NEWLINK message. The
+ * settings are not compared with the current state of the VFs, because
+ * the platform cache does not parse IFLA_VFINFO_LIST. Every VF in @vfs
+ * gets all its settings sent again. */
 static gboolean
 link_set_sriov_vfs(NMPlatform *platform, int ifindex, const NMPlatformVF *const *vfs)
 {
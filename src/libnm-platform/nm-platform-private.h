@@ -11,6 +11,8 @@
 
 NMPCache *nm_platform_get_cache(NMPlatform *self);
 
+void nm_platform_sysctl_account(NMPlatform *self, guint n_get, guint n_set);
+
 #define NMTST_ASSERT_PLATFORM_NETNS_CURRENT(platform)                                          \
     G_STMT_START                                                                               \
     {                                                                                          \
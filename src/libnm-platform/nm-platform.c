@@ -246,6 +246,16 @@ typedef struct _NMPlatformPrivate {
     CList              ip6_dadfailed_lst_head;
     NMDedupMultiIndex *multi_idx;
     NMPCache          *cache;
+
+    /* Number of sysctl reads/writes issued via this instance. */
+    guint64 sysctl_n_get;
+    guint64 sysctl_n_set;
+
+    /* ifindex -> TcSyncData. The qdiscs/tfilters that nm_platform_tc_sync() configured last. */
+    GHashTable *tc_sync_hash;
+
+    /* Number of qdisc/tfilter add and delete requests issued via this instance. */
+    guint64 tc_n_requests;
 } NMPlatformPrivate;
 
 G_DEFINE_TYPE(NMPlatform, nm_platform, G_TYPE_OBJECT)
@@ -785,6 +795,41 @@ nm_platform_sysctl_get(NMPlatform *self, const char *pathid, int dirfd, const ch
     return klass->sysctl_get(self, pathid, dirfd, path);
 }
 
+/* Called by the platform implementations for each sysctl read and write,
+ * including the ones they do internally without going through
+ * nm_platform_sysctl_get() and nm_platform_sysctl_set(). */
+void
+nm_platform_sysctl_account(NMPlatform *self, guint n_get, guint n_set)
+{
+    NMPlatformPrivate *priv = NM_PLATFORM_GET_PRIVATE(self);
+
+    priv->sysctl_n_get += n_get;
+    priv->sysctl_n_set += n_set;
+}
+
+/**
+ * nm_platform_sysctl_get_stats:
+ * @self: platform instance
+ * @out_n_get: (out) (optional): the number of sysctl reads
+ * @out_n_set: (out) (optional): the number of sysctl writes
+ *
+ * Returns the number of sysctl accesses done through @self so far. Each
+ * one costs at least an open(), a read() or write() and a close() on
+ * procfs/sysfs. Callers can compare two snapshots to account the sysctl
+ * accesses of an operation.
+ */
+void
+nm_platform_sysctl_get_stats(NMPlatform *self, guint64 *out_n_get, guint64 *out_n_set)
+{
+    NMPlatformPrivate *priv;
+
+    _CHECK_SELF_VOID(self, klass);
+
+    priv = NM_PLATFORM_GET_PRIVATE(self);
+    NM_SET_OUT(out_n_get, priv->sysctl_n_get);
+    NM_SET_OUT(out_n_set, priv->sysctl_n_set);
+}
+
 /**
  * nm_platform_sysctl_get_int32:
  * @self: platform instance
@@ -5940,6 +5985,7 @@ nm_platform_qdisc_add(NMPlatform *self, NMPNlmFlags flags, const NMPlatformQdisc
 
     _LOG3D("adding or updating a qdisc: %s",
            nm_platform_qdisc_to_string(qdisc, sbuf, sizeof(sbuf)));
+    NM_PLATFORM_GET_PRIVATE(self)->tc_n_requests++;
     return klass->qdisc_add(self, flags, qdisc);
 }
 
@@ -5949,6 +5995,7 @@ nm_platform_qdisc_delete(NMPlatform *self, int ifindex, guint32 parent, gboolean
     _CHECK_SELF(self, klass, -NME_BUG);
 
     _LOG3D("deleting a qdisc: parent 0x%08x", parent);
+    NM_PLATFORM_GET_PRIVATE(self)->tc_n_requests++;
     return klass->qdisc_delete(self, ifindex, parent, log_error);
 }
 
@@ -5966,6 +6013,7 @@ nm_platform_tfilter_add(NMPlatform *self, NMPNlmFlags flags, const NMPlatformTfi
 
     _LOG3D("adding or updating a tfilter: %s",
            nm_platform_tfilter_to_string(tfilter, sbuf, sizeof(sbuf)));
+    NM_PLATFORM_GET_PRIVATE(self)->tc_n_requests++;
     return klass->tfilter_add(self, flags, tfilter);
 }
 
@@ -5975,9 +6023,289 @@ nm_platform_tfilter_delete(NMPlatform *self, int ifindex, guint32 parent, gboole
     _CHECK_SELF(self, klass, -NME_BUG);
 
     _LOG3D("deleting a tfilter: parent 0x%08x", parent);
+    NM_PLATFORM_GET_PRIVATE(self)->tc_n_requests++;
     return klass->tfilter_delete(self, ifindex, parent, log_error);
 }
 
+/**
+ * nm_platform_tc_get_stats:
+ * @self: platform instance
+ * @out_n_requests: (out) (optional): the number of qdisc and tfilter
+ *   add and delete requests
+ *
+ * Returns the number of tc requests sent through @self so far. Each one
+ * is a netlink message to the kernel.
+ */
+void
+nm_platform_tc_get_stats(NMPlatform *self, guint64 *out_n_requests)
+{
+    _CHECK_SELF_VOID(self, klass);
+
+    NM_SET_OUT(out_n_requests, NM_PLATFORM_GET_PRIVATE(self)->tc_n_requests);
+}
+
+typedef struct {
+    /* The qdiscs/tfilters that were requested. */
+    GPtrArray *qdiscs;
+    GPtrArray *tfilters;
+
+    /* The qdiscs/tfilters in the cache right after the sync, that is, as the
+     * kernel reports them. */
+    GPtrArray *plat_qdiscs;
+    GPtrArray *plat_tfilters;
+} TcSyncData;
+
+static void
+_tc_sync_data_free(gpointer data)
+{
+    TcSyncData *tc_data = data;
+
+    nm_g_ptr_array_unref(tc_data->qdiscs);
+    nm_g_ptr_array_unref(tc_data->tfilters);
+    nm_g_ptr_array_unref(tc_data->plat_qdiscs);
+    nm_g_ptr_array_unref(tc_data->plat_tfilters);
+    nm_g_slice_free(tc_data);
+}
+
+static GPtrArray *
+_tc_sync_clone_objs(GPtrArray *objs)
+{
+    GPtrArray *arr;
+    guint      i;
+
+    if (!objs || objs->len == 0)
+        return NULL;
+
+    arr = g_ptr_array_new_full(objs->len, (GDestroyNotify) nmp_object_unref);
+    for (i = 0; i < objs->len; i++) {
+        const NMPObject *o = objs->pdata[i];
+        NMPObject       *obj;
+
+        /* The "kind" strings of the caller's objects have a limited lifetime.
+         * Intern them, like the platform cache does. */
+        obj = nmp_object_new(NMP_OBJECT_GET_TYPE(o), &o->object);
+        if (NMP_OBJECT_GET_TYPE(o) == NMP_OBJECT_TYPE_QDISC)
+            obj->qdisc.kind = g_intern_string(obj->qdisc.kind);
+        else {
+            obj->tfilter.kind        = g_intern_string(obj->tfilter.kind);
+            obj->tfilter.action.kind = g_intern_string(obj->tfilter.action.kind);
+        }
+        g_ptr_array_add(arr, obj);
+    }
+    return arr;
+}
+
+static gboolean
+_tc_sync_objs_equal(GPtrArray *a, GPtrArray *b)
+{
+    guint len = nm_g_ptr_array_len(a);
+    guint i;
+
+    if (len != nm_g_ptr_array_len(b))
+        return FALSE;
+
+    for (i = 0; i < len; i++) {
+        if (nmp_object_cmp(a->pdata[i], b->pdata[i]) != 0)
+            return FALSE;
+    }
+    return TRUE;
+}
+
+static GPtrArray *
+_tc_sync_lookup_cache(NMPlatform *self, NMPObjectType obj_type, int ifindex)
+{
+    NMPLookup lookup;
+
+    return nm_platform_lookup_clone(self,
+                                    nmp_lookup_init_object_by_ifindex(&lookup, obj_type, ifindex),
+                                    NULL,
+                                    NULL);
+}
+
+static gboolean
+_tc_sync_cache_unchanged(NMPlatform *self, NMPObjectType obj_type, int ifindex, GPtrArray *objs)
+{
+    const NMDedupMultiHeadEntry *head_entry;
+    NMPLookup                    lookup;
+    guint                        i;
+
+    head_entry = nm_platform_lookup(self,
+                                    nmp_lookup_init_object_by_ifindex(&lookup, obj_type, ifindex));
+
+    if ((head_entry ? head_entry->len : 0u) != nm_g_ptr_array_len(objs))
+        return FALSE;
+
+    /* The kernel fills in settings that we did not explicitly set, so the
+     * requested objects cannot be compared with the cached ones. Instead,
+     * compare the cache with what the kernel reported after our last sync.
+     * Any external change, including one of the parameters, shows up. */
+    for (i = 0; i < nm_g_ptr_array_len(objs); i++) {
+        const NMPObject *o = objs->pdata[i];
+        const NMPObject *obj;
+
+        obj = nm_platform_lookup_obj(self, NMP_CACHE_ID_TYPE_OBJECT_TYPE, o);
+        if (!obj || !nmp_object_equal(obj, o))
+            return FALSE;
+    }
+    return TRUE;
+}
+
+static const NMPObject *
+_tc_sync_find_by_parent(GPtrArray *objs, guint32 parent)
+{
+    guint i;
+
+    for (i = 0; i < nm_g_ptr_array_len(objs); i++) {
+        const NMPObject *o = objs->pdata[i];
+
+        if ((NMP_OBJECT_GET_TYPE(o) == NMP_OBJECT_TYPE_QDISC ? o->qdisc.parent : o->tfilter.parent)
+            == parent)
+            return o;
+    }
+    return NULL;
+}
+
+static gboolean
+_tc_sync_qdisc_unchanged(NMPlatform *self, TcSyncData *tc_data, const NMPObject *qdisc)
+{
+    const NMPObject *o;
+    const NMPObject *plat_obj;
+
+    if (!tc_data)
+        return FALSE;
+
+    /* We cannot compare the requested qdisc with the cached one, as the kernel
+     * fills in defaults and handles. Instead, check that we requested the same
+     * qdisc last time, and that the cache still shows what the kernel reported
+     * after that sync. */
+    o = _tc_sync_find_by_parent(tc_data->qdiscs, qdisc->qdisc.parent);
+    if (!o || nmp_object_cmp(o, qdisc) != 0)
+        return FALSE;
+
+    o = _tc_sync_find_by_parent(tc_data->plat_qdiscs, qdisc->qdisc.parent);
+    if (!o)
+        return FALSE;
+
+    plat_obj = nm_platform_lookup_obj(self, NMP_CACHE_ID_TYPE_OBJECT_TYPE, o);
+    return plat_obj && nmp_object_equal(plat_obj, o);
+}
+
+static gboolean
+_tc_sync_qdisc_is_stale(const NMPObject *plat_obj, GPtrArray *known_qdiscs)
+{
+    const NMPlatformQdisc *qdisc = NMP_OBJECT_CAST_QDISC(plat_obj);
+    guint                  i;
+
+    /* The kernel's default qdiscs have no handle and cannot be deleted. */
+    if (qdisc->handle == 0)
+        return FALSE;
+
+    if (_tc_sync_find_by_parent(known_qdiscs, qdisc->parent))
+        return FALSE;
+
+    if (NM_IN_SET(qdisc->parent, TC_H_ROOT, TC_H_INGRESS))
+        return TRUE;
+
+    /* Only delete the children of qdiscs that we keep. The others go away
+     * together with their parent. */
+    for (i = 0; i < nm_g_ptr_array_len(known_qdiscs); i++) {
+        const NMPlatformQdisc *q = NMP_OBJECT_CAST_QDISC(known_qdiscs->pdata[i]);
+
+        if (q->handle != 0 && TC_H_MAJ(q->handle) == TC_H_MAJ(qdisc->parent))
+            return TRUE;
+    }
+    return FALSE;
+}
+
+static gboolean
+_tc_sync_tfilters_unchanged(NMPlatform *self,
+                            int         ifindex,
+                            TcSyncData *tc_data,
+                            GPtrArray  *known_tfilters)
+{
+    if (!tc_data) {
+        gs_unref_ptrarray GPtrArray *plat_tfilters = NULL;
+
+        if (nm_g_ptr_array_len(known_tfilters) > 0)
+            return FALSE;
+
+        plat_tfilters = _tc_sync_lookup_cache(self, NMP_OBJECT_TYPE_TFILTER, ifindex);
+        return nm_g_ptr_array_len(plat_tfilters) == 0;
+    }
+
+    return _tc_sync_objs_equal(known_tfilters, tc_data->tfilters)
+           && _tc_sync_cache_unchanged(self,
+                                       NMP_OBJECT_TYPE_TFILTER,
+                                       ifindex,
+                                       tc_data->plat_tfilters);
+}
+
+static void
+_tc_sync_remember(NMPlatform *self,
+                  int         ifindex,
+                  gboolean    success,
+                  GPtrArray  *known_qdiscs,
+                  GPtrArray  *known_tfilters)
+{
+    NMPlatformPrivate *priv = NM_PLATFORM_GET_PRIVATE(self);
+    TcSyncData        *tc_data;
+
+    if (!success
+        || (nm_g_ptr_array_len(known_qdiscs) == 0 && nm_g_ptr_array_len(known_tfilters) == 0)) {
+        if (priv->tc_sync_hash)
+            g_hash_table_remove(priv->tc_sync_hash, GINT_TO_POINTER(ifindex));
+        return;
+    }
+
+    if (!priv->tc_sync_hash)
+        priv->tc_sync_hash = g_hash_table_new_full(nm_direct_hash, NULL, NULL, _tc_sync_data_free);
+
+    tc_data  = g_slice_new(TcSyncData);
+    *tc_data = (TcSyncData){
+        .qdiscs        = _tc_sync_clone_objs(known_qdiscs),
+        .tfilters      = _tc_sync_clone_objs(known_tfilters),
+        .plat_qdiscs   = _tc_sync_lookup_cache(self, NMP_OBJECT_TYPE_QDISC, ifindex),
+        .plat_tfilters = _tc_sync_lookup_cache(self, NMP_OBJECT_TYPE_TFILTER, ifindex),
+    };
+    g_hash_table_insert(priv->tc_sync_hash, GINT_TO_POINTER(ifindex), tc_data);
+}
+
+static gboolean
+_tc_sync_full(NMPlatform *self, int ifindex, GPtrArray *known_qdiscs, GPtrArray *known_tfilters)
+{
+    guint    i;
+    gboolean success = TRUE;
+
+    nm_platform_qdisc_delete(self, ifindex, TC_H_ROOT, FALSE);
+    nm_platform_qdisc_delete(self, ifindex, TC_H_INGRESS, FALSE);
+
+    /* At this point we can only have a root default qdisc
+     * (which can't be deleted). Ensure it doesn't have any
+     * filters attached.
+     */
+    nm_platform_tfilter_delete(self, ifindex, TC_H_ROOT, FALSE);
+
+    if (known_qdiscs) {
+        for (i = 0; i < known_qdiscs->len; i++) {
+            const NMPObject *q = g_ptr_array_index(known_qdiscs, i);
+
+            success &=
+                (nm_platform_qdisc_add(self, NMP_NLM_FLAG_ADD, NMP_OBJECT_CAST_QDISC(q)) >= 0);
+        }
+    }
+
+    if (known_tfilters) {
+        for (i = 0; i < known_tfilters->len; i++) {
+            const NMPObject *q = g_ptr_array_index(known_tfilters, i);
+
+            success &=
+                (nm_platform_tfilter_add(self, NMP_NLM_FLAG_ADD, NMP_OBJECT_CAST_TFILTER(q)) >= 0);
+        }
+    }
+
+    return success;
+}
+
 /**
  * nm_platform_tc_sync:
  * @self: the #NMPlatform instance
@@ -5992,6 +6320,16 @@ nm_platform_tfilter_delete(NMPlatform *self, int ifindex, guint32 parent, gboole
  * NMPlatformTfilter instances which "kind" string have a limited
  * lifetime.
  *
+ * If the platform caches tc objects, only the objects that differ are
+ * touched. Qdiscs that are no longer requested are deleted, and changed
+ * or missing ones are replaced. Replacing a qdisc with one of the same
+ * kind changes it in place, so its queue and children are kept. The
+ * tfilters are re-added only if they changed, as the kernel cannot
+ * replace a tfilter without knowing its handle and priority.
+ *
+ * Without the tc cache, the root and ingress qdiscs are deleted and
+ * everything is added again.
+ *
  * Returns: %TRUE on success.
  */
 gboolean
@@ -6000,39 +6338,84 @@ nm_platform_tc_sync(NMPlatform *self,
                     GPtrArray  *known_qdiscs,
                     GPtrArray  *known_tfilters)
 {
-    guint    i;
-    gboolean success = TRUE;
+    NMPlatformPrivate           *priv;
+    gs_unref_ptrarray GPtrArray *plat_qdiscs   = NULL;
+    gs_unref_ptrarray GPtrArray *plat_tfilters = NULL;
+    TcSyncData                  *tc_data;
+    guint                        n_changes = 0;
+    guint                        i;
+    guint                        j;
+    gboolean                     success = TRUE;
 
     nm_assert(NM_IS_PLATFORM(self));
     nm_assert(ifindex > 0);
 
-    nm_platform_qdisc_delete(self, ifindex, TC_H_ROOT, FALSE);
-    nm_platform_qdisc_delete(self, ifindex, TC_H_INGRESS, FALSE);
+    priv = NM_PLATFORM_GET_PRIVATE(self);
 
-    /* At this point we can only have a root default qdisc
-     * (which can't be deleted). Ensure it doesn't have any
-     * filters attached.
-     */
-    nm_platform_tfilter_delete(self, ifindex, TC_H_ROOT, FALSE);
+    if (!priv->cache_tc)
+        return _tc_sync_full(self, ifindex, known_qdiscs, known_tfilters);
 
-    if (known_qdiscs) {
-        for (i = 0; i < known_qdiscs->len; i++) {
-            const NMPObject *q = g_ptr_array_index(known_qdiscs, i);
+    tc_data = priv->tc_sync_hash
+                  ? g_hash_table_lookup(priv->tc_sync_hash, GINT_TO_POINTER(ifindex))
+                  : NULL;
 
-            success &=
-                (nm_platform_qdisc_add(self, NMP_NLM_FLAG_ADD, NMP_OBJECT_CAST_QDISC(q)) >= 0);
+    plat_qdiscs = _tc_sync_lookup_cache(self, NMP_OBJECT_TYPE_QDISC, ifindex);
+    for (i = 0; i < nm_g_ptr_array_len(plat_qdiscs); i++) {
+        const NMPObject *o = plat_qdiscs->pdata[i];
+
+        if (_tc_sync_qdisc_is_stale(o, known_qdiscs)) {
+            nm_platform_qdisc_delete(self, ifindex, NMP_OBJECT_CAST_QDISC(o)->parent, FALSE);
+            n_changes++;
         }
     }
 
-    if (known_tfilters) {
-        for (i = 0; i < known_tfilters->len; i++) {
-            const NMPObject *q = g_ptr_array_index(known_tfilters, i);
+    /* The qdiscs are ordered so that parents come before their children. */
+    for (i = 0; i < nm_g_ptr_array_len(known_qdiscs); i++) {
+        const NMPObject *q = known_qdiscs->pdata[i];
+
+        if (_tc_sync_qdisc_unchanged(self, tc_data, q))
+            continue;
+
+        success &=
+            (nm_platform_qdisc_add(self, NMP_NLM_FLAG_REPLACE, NMP_OBJECT_CAST_QDISC(q)) >= 0);
+        n_changes++;
+    }
+
+    if (!_tc_sync_tfilters_unchanged(self, ifindex, tc_data, known_tfilters)) {
+        plat_tfilters = _tc_sync_lookup_cache(self, NMP_OBJECT_TYPE_TFILTER, ifindex);
+
+        /* Delete all tfilters on the parents that have or will have some. */
+        for (i = 0; i < nm_g_ptr_array_len(plat_tfilters); i++) {
+            guint32 parent = NMP_OBJECT_CAST_TFILTER(plat_tfilters->pdata[i])->parent;
+
+            if (!_tc_sync_find_by_parent(known_tfilters, parent))
+                nm_platform_tfilter_delete(self, ifindex, parent, FALSE);
+        }
+        for (i = 0; i < nm_g_ptr_array_len(known_tfilters); i++) {
+            guint32 parent = NMP_OBJECT_CAST_TFILTER(known_tfilters->pdata[i])->parent;
+
+            for (j = 0; j < i; j++) {
+                if (NMP_OBJECT_CAST_TFILTER(known_tfilters->pdata[j])->parent == parent)
+                    break;
+            }
+            if (j == i)
+                nm_platform_tfilter_delete(self, ifindex, parent, FALSE);
+        }
+
+        for (i = 0; i < nm_g_ptr_array_len(known_tfilters); i++) {
+            const NMPObject *q = known_tfilters->pdata[i];
 
             success &=
                 (nm_platform_tfilter_add(self, NMP_NLM_FLAG_ADD, NMP_OBJECT_CAST_TFILTER(q)) >= 0);
         }
+        n_changes++;
     }
 
+    if (n_changes == 0)
+        _LOG3D("tc: qdiscs and tfilters are already configured");
+
+    _tc_sync_remember(self, ifindex, success, known_qdiscs, known_tfilters);
+
     return success;
 }
 
@@ -9810,6 +10193,12 @@ nm_platform_cache_update_emit_signal(NMPlatform      *self,
         && NM_IN_SET(cache_op, NMP_CACHE_OPS_ADDED, NMP_CACHE_OPS_UPDATED))
         _ip4_dev_route_blacklist_notify_route(self, o);
 
+    if (klass->obj_type == NMP_OBJECT_TYPE_LINK && cache_op == NMP_CACHE_OPS_REMOVED
+        && NM_PLATFORM_GET_PRIVATE(self)->tc_sync_hash) {
+        /* Forget what we configured on the link. The ifindex might get reused. */
+        g_hash_table_remove(NM_PLATFORM_GET_PRIVATE(self)->tc_sync_hash, GINT_TO_POINTER(ifindex));
+    }
+
     _LOG3t("emit signal %s %s: %s",
            klass->signal_type,
            nm_platform_signal_change_type_to_string((NMPlatformSignalChangeType) cache_op),
@@ -10060,6 +10449,7 @@ finalize(GObject *object)
     nm_clear_g_source(&priv->ip4_dev_route_blacklist_check_id);
     nm_clear_g_source(&priv->ip4_dev_route_blacklist_gc_timeout_id);
     nm_clear_pointer(&priv->ip4_dev_route_blacklist_hash, g_hash_table_unref);
+    nm_clear_pointer(&priv->tc_sync_hash, g_hash_table_unref);
     g_clear_object(&self->_netns);
     nm_dedup_multi_index_unref(priv->multi_idx);
     nmp_cache_free(priv->cache);
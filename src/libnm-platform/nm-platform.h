@@ -1593,6 +1593,7 @@ void     nm_platform_sysctl_set_async(NMPlatform             *self,
                                       gpointer                data,
                                       GCancellable           *cancellable);
 char    *nm_platform_sysctl_get(NMPlatform *self, const char *pathid, int dirfd, const char *path);
+void     nm_platform_sysctl_get_stats(NMPlatform *self, guint64 *out_n_get, guint64 *out_n_set);
 gint32   nm_platform_sysctl_get_int32(NMPlatform *self,
                                       const char *pathid,
                                       int         dirfd,
@@ -2419,6 +2420,8 @@ gboolean nm_platform_tc_sync(NMPlatform *self,
                              GPtrArray  *known_qdiscs,
                              GPtrArray  *known_tfilters);
 
+void nm_platform_tc_get_stats(NMPlatform *self, guint64 *out_n_requests);
+
 const char *nm_platform_link_to_string(const NMPlatformLink *link, char *buf, gsize len);
 const char *nm_platform_lnk_bond_to_string(const NMPlatformLnkBond *lnk, char *buf, gsize len);
 const char *nm_platform_lnk_bridge_to_string(const NMPlatformLnkBridge *lnk, char *buf, gsize len);
@@ -1212,6 +1212,9 @@ command_done(GObject *object, GAsyncResult *res, gpointer user_data)
         g_string_assign(nmc->return_text, error->message);
     }
 
+    nm_assert(nmc->n_pending_cmds > 0);
+    nmc->n_pending_cmds--;
+
     if (!nmc->should_wait)
         g_main_loop_quit(loop);
 }
@@ -1480,6 +1483,7 @@ nmc_do_cmd(NmCli *nmc, const NMCCommand cmds[], const char *cmd, int argc, const
 
     task = nm_g_task_new(NULL, NULL, nmc_do_cmd, command_done, nmc);
     g_task_set_task_data(task, nmc, NULL);
+    nmc->n_pending_cmds++;
 
     if (argc == 0 && nmc->complete) {
         g_task_return_boolean(task, TRUE);
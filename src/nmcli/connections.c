@@ -141,11 +141,17 @@ NM_AUTO_DEFINE_FCN(AddConnectionInfo *,
 
 static guint progress_id = 0; /* ID of event source for displaying progress */
 
-static void
-quit(void)
+void
+nmc_connections_stop_progress(void)
 {
     if (nm_clear_g_source(&progress_id))
         nmc_terminal_erase_line();
+}
+
+static void
+quit(void)
+{
+    nmc_connections_stop_progress();
     g_main_loop_quit(loop);
 }
 
@@ -1174,6 +1180,11 @@ usage_connection_up(void)
           "Activate a device with a connection. The connection profile is selected\n"
           "automatically by NetworkManager.\n"
           "\n"
+          "ARGUMENTS := [id | uuid | path] <ID> [id | uuid | path] <ID> ...\n"
+          "\n"
+          "Activate several connections with a single request. Controllers are activated\n"
+          "before their ports. nmcli does not wait for these activations to complete.\n"
+          "\n"
           "ifname      - specifies the device to active the connection on\n"
           "ap          - specifies AP to connect to (only valid for Wi-Fi)\n"
           "nsp         - specifies NSP to connect to (only valid for WiMAX)\n"
@@ -3133,19 +3144,71 @@ nmc_activate_connection(NmCli              *nmc,
     return TRUE;
 }
 
+static void
+activate_connections_cb(GObject *client, GAsyncResult *result, gpointer user_data)
+{
+    NmCli                       *nmc;
+    gs_unref_ptrarray GPtrArray *connections  = NULL;
+    gs_strfreev char           **active_paths = NULL;
+    gs_strfreev char           **errors       = NULL;
+    gs_free_error GError        *error        = NULL;
+    gboolean                     failed       = FALSE;
+    guint                        i;
+
+    nm_utils_user_data_unpack(user_data, &nmc, &connections);
+
+    if (!nm_client_activate_connections_finish(NM_CLIENT(client),
+                                               result,
+                                               &active_paths,
+                                               &errors,
+                                               &error)) {
+        g_string_printf(nmc->return_text,
+                        _("Error: Connection activation failed: %s"),
+                        error->message);
+        nmc->return_value = NMC_RESULT_ERROR_CON_ACTIVATION;
+        quit();
+        return;
+    }
+
+    if (nmc->nmc_config.print_output == NMC_PRINT_PRETTY)
+        nmc_terminal_erase_line();
+
+    for (i = 0; i < connections->len && active_paths[i] && errors[i]; i++) {
+        NMConnection *connection = connections->pdata[i];
+
+        if (errors[i][0]) {
+            nmc_printerr(_("Error: Connection activation failed for '%s': %s\n"),
+                         nm_connection_get_id(connection),
+                         errors[i]);
+            failed = TRUE;
+        } else {
+            nmc_print(_("Connection activation started for '%s' (D-Bus active path: %s)\n"),
+                      nm_connection_get_id(connection),
+                      active_paths[i]);
+        }
+    }
+
+    if (failed) {
+        g_string_printf(nmc->return_text, _("Error: not all connections could be activated."));
+        nmc->return_value = NMC_RESULT_ERROR_CON_ACTIVATION;
+    }
+    quit();
+}
+
 static void
 do_connection_up(const NMCCommand *cmd, NmCli *nmc, int argc, const char *const *argv)
 {
-    NMConnection         *connection = NULL;
-    const char           *ifname     = NULL;
-    const char           *ap         = NULL;
-    const char           *nsp        = NULL;
-    const char           *pwds       = NULL;
-    gs_free_error GError *error      = NULL;
-    gs_strfreev char    **arg_arr    = NULL;
-    int                   arg_num;
-    const char *const   **argv_ptr;
-    int                  *argc_ptr;
+    NMConnection                *connection  = NULL;
+    gs_unref_ptrarray GPtrArray *connections = NULL;
+    const char                  *ifname      = NULL;
+    const char                  *ap          = NULL;
+    const char                  *nsp         = NULL;
+    const char                  *pwds        = NULL;
+    gs_free_error GError        *error       = NULL;
+    gs_strfreev char           **arg_arr     = NULL;
+    int                          arg_num;
+    const char *const          **argv_ptr;
+    int                         *argc_ptr;
 
     /*
      * Set default timeout for connection activation.
@@ -3207,6 +3270,16 @@ do_connection_up(const NMCCommand *cmd, NmCli *nmc, int argc, const char *const
             ap = *argv;
             if (argc == 1 && nmc->complete)
                 nmc_complete_bssid(nmc->client, ifname, ap);
+        } else if (nm_streq(*argv, "nsp")) {
+            argc--;
+            argv++;
+            if (!argc) {
+                g_string_printf(nmc->return_text, _("Error: %s argument is missing."), *(argv - 1));
+                nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+                return;
+            }
+
+            nsp = *argv;
         } else if (nm_streq(*argv, "passwd-file")) {
             argc--;
             argv++;
@@ -3220,6 +3293,24 @@ do_connection_up(const NMCCommand *cmd, NmCli *nmc, int argc, const char *const
                 nmc->return_value = NMC_RESULT_COMPLETE_FILE;
 
             pwds = *argv;
+        } else if (connection && !ifname && !ap && !nsp && !pwds) {
+            NMConnection *other;
+
+            /* Further connections to activate with the same request. */
+            other = get_connection(nmc, &argc, &argv, NULL, NULL, NULL, &error);
+            if (!other) {
+                if (nmc->complete)
+                    return;
+                g_string_printf(nmc->return_text, _("Error: %s."), error->message);
+                nmc->return_value = error->code;
+                return;
+            }
+            if (!connections) {
+                connections = g_ptr_array_new_with_free_func(g_object_unref);
+                g_ptr_array_add(connections, g_object_ref(connection));
+            }
+            g_ptr_array_add(connections, g_object_ref(other));
+            continue;
         } else if (!nmc->complete) {
             g_string_printf(nmc->return_text, _("Error: invalid extra argument '%s'."), *argv);
             nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
@@ -3232,6 +3323,32 @@ do_connection_up(const NMCCommand *cmd, NmCli *nmc, int argc, const char *const
     if (nmc->complete)
         return;
 
+    if (connections && (ifname || ap || nsp || pwds)) {
+        g_string_printf(nmc->return_text,
+                        _("Error: 'ifname', 'ap', 'nsp' and 'passwd-file' can only be used when "
+                          "activating a single connection."));
+        nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+        return;
+    }
+
+    if (connections) {
+        guint n_connections = connections->len;
+
+        nmc->should_wait++;
+        nm_client_activate_connections_async(
+            nmc->client,
+            (NMConnection *const *) connections->pdata,
+            NULL,
+            NULL,
+            n_connections,
+            NULL,
+            activate_connections_cb,
+            nm_utils_user_data_pack(nmc, g_steal_pointer(&connections)));
+        if (nmc->nmc_config.print_output == NMC_PRINT_PRETTY)
+            progress_id = g_timeout_add(120, progress_cb, _("preparing"));
+        return;
+    }
+
     /* Use nowait_flag instead of should_wait because exiting has to be postponed till
      * active_connection_state_cb() is called. That gives NM time to check our permissions
      * and we can follow activation progress.
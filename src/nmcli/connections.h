@@ -10,6 +10,8 @@
 
 void nmc_monitor_connections(NmCli *nmc);
 
+void nmc_connections_stop_progress(void);
+
 const char *nmc_connection_check_deprecated(NMConnection *c);
 
 gboolean nmc_process_connection_properties(NmCli              *nmc,
@@ -1066,11 +1066,17 @@ usage_device_checkpoint(void)
                    "checkpoint is automatically restored after timeout.\n\n"));
 }
 
-static void
-quit(void)
+void
+nmc_devices_stop_progress(void)
 {
     if (nm_clear_g_source(&progress_id))
         nmc_terminal_erase_line();
+}
+
+static void
+quit(void)
+{
+    nmc_devices_stop_progress();
     g_main_loop_quit(loop);
 }
 
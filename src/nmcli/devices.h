@@ -14,6 +14,8 @@ void nmc_complete_bssid(NMClient *client, const char *ifname, const char *bssid_
 
 void nmc_monitor_devices(NmCli *nmc);
 
+void nmc_devices_stop_progress(void);
+
 NMDevice **nmc_get_devices_sorted(NMClient *client);
 
 NMMetaColor nmc_device_state_to_color(NMDevice *device);
@@ -525,11 +525,14 @@ do_general_status(const NMCCommand *cmd, NmCli *nmc, int argc, const char *const
     show_nm_status(nmc, NULL, NULL);
 }
 
+static guint permissions_timeout_id = 0;
+
 static gboolean
 timeout_cb(gpointer user_data)
 {
     NmCli *nmc = (NmCli *) user_data;
 
+    permissions_timeout_id = 0;
     g_signal_handlers_disconnect_by_func(nmc->client, G_CALLBACK(permission_changed), nmc);
 
     g_string_printf(nmc->return_text, _("Error: Timeout %d sec expired."), nmc->timeout);
@@ -556,6 +559,7 @@ print_permissions(void *user_data)
     }
 
     g_signal_handlers_disconnect_by_func(nmc->client, G_CALLBACK(permission_changed), nmc);
+    nm_clear_g_source(&permissions_timeout_id);
 
     if (!is_running) {
         /* NetworkManager quit while we were waiting. */
@@ -613,7 +617,7 @@ show_nm_permissions(NmCli *nmc)
 
     if (nmc->timeout == -1)
         nmc->timeout = 10;
-    g_timeout_add_seconds(nmc->timeout, timeout_cb, nmc);
+    permissions_timeout_id = g_timeout_add_seconds(nmc->timeout, timeout_cb, nmc);
 
     nmc->should_wait++;
 
@@ -247,6 +247,7 @@ usage(void)
         "\n"
         "OPTIONS\n"
         "  -a, --ask                                ask for missing parameters\n"
+        "  -b, --batch <file>|-                     run commands from file or stdin, one per line\n"
         "  -c, --colors auto|yes|no                 whether to use colors in output\n"
         "  -e, --escape yes|no                      escape columns separators in values\n"
         "  -f, --fields <field,...>|all|common      specify fields to output\n"
@@ -723,6 +724,151 @@ set_colors(NmcColorOption   color_option,
 
 /*************************************************************************************/
 
+static void
+batch_command_cleanup(NmCli *nmc)
+{
+    /* Some commands register a secret agent or load a passwd-file for the
+     * duration of the command. When running a single command, that is
+     * released on exit. In batch mode, release it before the next command. */
+    if (nmc->secret_agent) {
+        nm_secret_agent_old_unregister(NM_SECRET_AGENT_OLD(nmc->secret_agent), NULL, NULL);
+        g_clear_object(&nmc->secret_agent);
+    }
+    nm_clear_pointer(&nmc->pwds_hash, g_hash_table_destroy);
+
+    nmc_connections_stop_progress();
+    nmc_devices_stop_progress();
+}
+
+static void
+run_batch(NmCli *nmc, const NMCCommand *cmds, const char *batch_file)
+{
+    gs_unref_ptrarray GPtrArray *argvs           = NULL;
+    gs_free char                *line            = NULL;
+    size_t                       line_size       = 0;
+    char                        *required_fields = nmc->required_fields;
+    int                          timeout         = nmc->timeout;
+    NMCResultCode                first_error     = NMC_RESULT_SUCCESS;
+    guint                        n_cmds          = 0;
+    guint                        n_failed        = 0;
+    guint                        lineno          = 0;
+    FILE                        *f;
+
+    if (nm_streq(batch_file, "-"))
+        f = stdin;
+    else {
+        f = fopen(batch_file, "re");
+        if (!f) {
+            int errsv = errno;
+
+            g_string_printf(nmc->return_text,
+                            _("Error: failed to open batch file '%s': %s."),
+                            batch_file,
+                            nm_strerror_native(errsv));
+            nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+            return;
+        }
+    }
+
+    /* Command handlers may keep pointers into their argument vector until the
+     * end (see nmc_do_cmd()). Keep all of them alive until the batch is done. */
+    argvs = g_ptr_array_new_with_free_func((GDestroyNotify) g_strfreev);
+
+    while (getline(&line, &line_size, f) != -1) {
+        gs_free_error GError *error = NULL;
+        gs_free char         *text  = NULL;
+        char                **argv  = NULL;
+        const char *const    *cmd_argv;
+        int                   cmd_argc;
+        const char           *s;
+        gint64                start_usec;
+
+        lineno++;
+
+        s = nm_str_skip_leading_spaces(line);
+        if (NM_IN_SET(s[0], '\0', '\n', '#'))
+            continue;
+
+        n_cmds++;
+
+        nmc->return_value    = NMC_RESULT_SUCCESS;
+        nmc->required_fields = required_fields;
+        nmc->timeout         = timeout;
+        nmc->nowait_flag     = TRUE;
+        nmc->should_wait     = 0;
+        g_string_assign(nmc->return_text, _("Success"));
+
+        start_usec = g_get_monotonic_time();
+
+        if (!g_shell_parse_argv(s, &cmd_argc, &argv, &error)) {
+            g_string_printf(nmc->return_text,
+                            _("Error: failed to parse command: %s."),
+                            error->message);
+            nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+        } else {
+            g_ptr_array_add(argvs, argv);
+            cmd_argv = (const char *const *) argv;
+
+            /* Accept lines copied from a shell script. */
+            if (nm_streq(cmd_argv[0], "nmcli")) {
+                cmd_argv++;
+                cmd_argc--;
+            }
+
+            nmc_do_cmd(nmc, cmds, *cmd_argv, cmd_argc, cmd_argv);
+            g_main_loop_run(loop);
+
+            /* A handler may quit the main loop before its command task
+             * completed. Let the task complete now, otherwise it would
+             * quit the main loop of the next command. */
+            while (nmc->n_pending_cmds > 0)
+                g_main_context_iteration(NULL, TRUE);
+
+            batch_command_cleanup(nmc);
+        }
+
+        if (nmc->return_value != NMC_RESULT_SUCCESS) {
+            n_failed++;
+            if (first_error == NMC_RESULT_SUCCESS)
+                first_error = nmc->return_value;
+        }
+
+        /* Report one line per command on stderr, so that stdout contains the
+         * same output as running the commands one by one. The message is the
+         * last field and may contain colons. */
+        text = g_strdelimit(g_strdup(nmc->return_text->str), "\n", ' ');
+        nmc_printerr("batch:%u:%d:%" G_GINT64_FORMAT ":%s\n",
+                     lineno,
+                     (int) nmc->return_value,
+                     g_get_monotonic_time() - start_usec,
+                     text);
+
+        if (nmc->return_value == 0x80 + SIGINT)
+            break;
+    }
+
+    if (f != stdin)
+        fclose(f);
+
+    nmc->required_fields = required_fields;
+
+    if (nmc->return_value == 0x80 + SIGINT) {
+        /* Interrupted. Keep the "terminated by signal" error. */
+        return;
+    }
+
+    if (n_failed > 0) {
+        nmc->return_value = first_error;
+        g_string_printf(nmc->return_text,
+                        _("Error: %u of %u batch commands failed."),
+                        n_failed,
+                        n_cmds);
+    } else {
+        nmc->return_value = NMC_RESULT_SUCCESS;
+        g_string_assign(nmc->return_text, _("Success"));
+    }
+}
+
 static gboolean
 process_command_line(NmCli *nmc, int argc, char **argv_orig)
 {
@@ -736,7 +882,8 @@ process_command_line(NmCli *nmc, int argc, char **argv_orig)
         {"agent", nmc_command_func_agent, NULL, FALSE, FALSE},
         {NULL, nmc_command_func_overview, usage, TRUE, TRUE},
     };
-    NmcColorOption     colors = NMC_USE_COLOR_AUTO;
+    NmcColorOption     colors     = NMC_USE_COLOR_AUTO;
+    gs_free char      *batch_file = NULL;
     const char        *base;
     const char *const *argv;
 
@@ -766,6 +913,7 @@ process_command_line(NmCli *nmc, int argc, char **argv_orig)
 
         if (argc == 1 && nmc->complete) {
             nmc_complete_strings(argv[0],
+                                 "--batch",
                                  "--overview",
                                  "--offline",
                                  "--terse",
@@ -881,6 +1029,10 @@ process_command_line(NmCli *nmc, int argc, char **argv_orig)
              * before the "-g <field>" option (-g may be still more practical and easy to remember than -t -f).
              */
             nmc->mode_specified = TRUE;
+        } else if (matches_arg(nmc, &argc, &argv, "-batch", &value)) {
+            if (argc == 1 && nmc->complete)
+                nmc->return_value = NMC_RESULT_COMPLETE_FILE;
+            nm_strdup_reset_take(&batch_file, g_steal_pointer(&value));
         } else if (matches_arg(nmc, &argc, &argv, "-nocheck", NULL)) {
             /* ignore for backward compatibility */
         } else if (matches_arg(nmc, &argc, &argv, "-wait", &value)) {
@@ -922,6 +1074,25 @@ process_command_line(NmCli *nmc, int argc, char **argv_orig)
                &nmc->palette_buffer,
                &nmc->nmc_config_mutable.palette);
 
+    if (batch_file && !nmc->complete) {
+        if (argc > 0) {
+            g_string_printf(nmc->return_text,
+                            _("Error: '--batch' reads commands from a file and cannot be "
+                              "combined with command '%s'."),
+                            argv[0]);
+            nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+            return FALSE;
+        }
+        if (nmc->nmc_config.offline) {
+            g_string_printf(nmc->return_text,
+                            _("Error: '--batch' cannot be combined with '--offline'."));
+            nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+            return FALSE;
+        }
+        run_batch(nmc, nmcli_cmds, batch_file);
+        return FALSE;
+    }
+
     /* Now run the requested command */
     nmc_do_cmd(nmc, nmcli_cmds, *argv, argc, argv);
 
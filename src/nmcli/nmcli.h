@@ -175,6 +175,9 @@ typedef struct _NmCli {
     /* Semaphore indicating whether nmcli should not end or not yet */
     int should_wait;
 
+    /* Number of command tasks that did not complete yet (see nmc_do_cmd()) */
+    guint n_pending_cmds;
+
     /* '--nowait' option; used for passing to callbacks */
     bool nowait_flag : 1;
 
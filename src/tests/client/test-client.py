@@ -2293,6 +2293,40 @@ class TestNmcli(unittest.TestCase):
         nmc.pexp.expect("NetworkManager is stopped")
         end_mon(self, nmc)
 
+    @Util.skip_without_pexpect
+    @nm_test
+    def test_batch(self):
+        # Mix commands that are done when their handler returns with
+        # commands that wait for D-Bus replies and for permissions. Every
+        # command must run to completion and report its own status.
+        with tempfile.NamedTemporaryFile("w", prefix="nm-test-client-batch.") as f:
+            f.write(
+                "general status\n"
+                "connection add type ethernet con-name con-batch ifname eth0\n"
+                "general permissions\n"
+                "# comment\n"
+                "nmcli connection show con-batch\n"
+                "connection modify con-batch ipv4.method link-local\n"
+                "connection show does-not-exist\n"
+                "general status\n"
+            )
+            f.flush()
+
+            nmc = Util.cmd_call_pexpect_nmcli(["--batch", f.name])
+            nmc.pexp.expect(r"batch:1:0:\d+:Success\r\n")
+            nmc.pexp.expect(r"Connection 'con-batch' \(.*\) successfully added.")
+            nmc.pexp.expect(r"batch:2:0:\d+:Success\r\n")
+            nmc.pexp.expect(r"batch:3:0:\d+:Success\r\n")
+            nmc.pexp.expect(r"connection.id: +con-batch\r\n")
+            nmc.pexp.expect(r"batch:5:0:\d+:Success\r\n")
+            nmc.pexp.expect(r"batch:6:0:\d+:Success\r\n")
+            nmc.pexp.expect(r"batch:7:10:\d+:Error: .*\r\n")
+            nmc.pexp.expect(r"batch:8:0:\d+:Success\r\n")
+            nmc.pexp.expect(pexpect.EOF)
+            nmc.pexp.close()
+            self.assertEqual(nmc.pexp.exitstatus, 10)
+            Util.valgrind_check_log(nmc.valgrind_log, "test_batch")
+
     @nm_test_no_dbus  # we need dbus, but we need to pass arguments to srv_start
     def test_version_warn(self):
         self.ctx.srv_start(srv_version="A.B.C")
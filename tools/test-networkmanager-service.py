@@ -487,6 +487,11 @@ class BusErr:
             self._dbus_error_name = "{}.PermissionDenied".format(IFACE_NM)
             dbus.DBusException.__init__(self, *args, **kwargs)
 
+    class InvalidArgumentsException(dbus.DBusException):
+        def __init__(self, *args, **kwargs):
+            self._dbus_error_name = "{}.InvalidArguments".format(IFACE_NM)
+            dbus.DBusException.__init__(self, *args, **kwargs)
+
     class UnknownDeviceException(dbus.DBusException):
         def __init__(self, *args, **kwargs):
             self._dbus_error_name = "{}.UnknownDevice".format(IFACE_NM)
@@ -497,6 +502,11 @@ class BusErr:
             self._dbus_error_name = "{}.UnknownConnection".format(IFACE_NM)
             dbus.DBusException.__init__(self, *args, **kwargs)
 
+    class InvalidSettingsArgumentsException(dbus.DBusException):
+        def __init__(self, *args, **kwargs):
+            self._dbus_error_name = "{}.InvalidArguments".format(IFACE_SETTINGS)
+            dbus.DBusException.__init__(self, *args, **kwargs)
+
     class InvalidHostnameException(dbus.DBusException):
         def __init__(self, *args, **kwargs):
             self._dbus_error_name = "{}.InvalidHostname".format(IFACE_SETTINGS)
@@ -1698,6 +1708,25 @@ class NetworkManager(ExportedObj):
 
         return ExportedObj.to_path(ac)
 
+    @dbus.service.method(
+        dbus_interface=IFACE_NM, in_signature="a(ooo)a{sv}", out_signature="a(os)"
+    )
+    def ActivateConnections(self, items, options):
+        if len(options) > 0:
+            raise BusErr.InvalidArgumentsException("Unknown extra option passed")
+
+        # Unlike the real daemon, this does not order controllers before
+        # their ports. Each item fails or succeeds on its own.
+        results = []
+        for conpath, devpath, specific_object in items:
+            try:
+                acpath = self.ActivateConnection(conpath, devpath, specific_object)
+            except dbus.DBusException as e:
+                results.append(("/", e.get_dbus_message()))
+                continue
+            results.append((acpath, ""))
+        return dbus.Array(results, signature="(os)")
+
     def active_connection_add(self, ac):
         ac.export()
         self.active_connections.append(ac)
@@ -1966,6 +1995,17 @@ class NetworkManager(ExportedObj):
     def AutoRemoveNextConnection(self):
         gl.settings.auto_remove_next_connection()
 
+    @dbus.service.method(IFACE_TEST, in_signature="", out_signature="")
+    def AutoRemoveBetweenSettingsPages(self):
+        gl.settings.auto_remove_between_settings_pages()
+
+    @dbus.service.method(IFACE_TEST, in_signature="", out_signature="uu")
+    def GetSettingsCallCounts(self):
+        return (
+            dbus.UInt32(gl.settings.n_get_settings),
+            dbus.UInt32(gl.settings.n_get_connections_settings),
+        )
+
     @dbus.service.method(
         dbus_interface=IFACE_TEST, in_signature="a{sa{sv}}b", out_signature="o"
     )
@@ -2111,12 +2151,14 @@ class Connection(ExportedObj):
             )
 
         self.con_hash = con_hash
+        gl.settings.connections_serial += 1
         self.Updated()
 
     @dbus.service.method(
         dbus_interface=IFACE_CONNECTION, in_signature="", out_signature="a{sa{sv}}"
     )
     def GetSettings(self):
+        gl.settings.n_get_settings += 1
         if hasattr(self, "_remove_next_connection_cb"):
             self._remove_next_connection_cb()
             raise BusErr.UnknownConnectionException("Connection not found")
@@ -2129,6 +2171,7 @@ class Connection(ExportedObj):
     )
     def SetVisible(self, vis):
         self.visible = vis
+        gl.settings.connections_serial += 1
         self.Updated()
 
     @dbus.service.method(
@@ -2182,6 +2225,10 @@ class Settings(ExportedObj):
         self.connections = {}
         self.c_counter = 0
         self.remove_next_connection = False
+        self.remove_between_settings_pages = False
+        self.connections_serial = 0
+        self.n_get_settings = 0
+        self.n_get_connections_settings = 0
 
         props = {
             PRP_SETTINGS_HOSTNAME: "foobar.baz",
@@ -2195,6 +2242,9 @@ class Settings(ExportedObj):
     def auto_remove_next_connection(self):
         self.remove_next_connection = True
 
+    def auto_remove_between_settings_pages(self):
+        self.remove_between_settings_pages = True
+
     def get_connection(self, path):
         return self.connections[path]
 
@@ -2234,6 +2284,121 @@ class Settings(ExportedObj):
     def AddConnection(self, con_hash):
         return self.add_connection(con_hash)
 
+    @dbus.service.method(
+        dbus_interface=IFACE_SETTINGS,
+        in_signature="uu",
+        out_signature="a{oa{sa{sv}}}ut",
+    )
+    def GetConnectionsSettings(self, offset, limit):
+        self.n_get_connections_settings += 1
+
+        if offset > 0 and self.remove_between_settings_pages:
+            # Simulate a profile that gets deleted while the client pages
+            # through the list. The remaining profiles move one position
+            # up, so the client must notice the new serial and start over.
+            self.remove_between_settings_pages = False
+            paths = self.get_connection_paths()
+            if paths:
+                self.delete_connection(self.connections[paths[0]])
+
+        paths = self.get_connection_paths()
+        start = min(offset, len(paths))
+        end = len(paths) if limit == 0 else min(start + limit, len(paths))
+
+        settings = {}
+        for path in paths[start:end]:
+            con_inst = self.connections.get(path)
+            if con_inst is None:
+                continue
+            if hasattr(con_inst, "_remove_next_connection_cb"):
+                con_inst._remove_next_connection_cb()
+                continue
+            if not con_inst.visible:
+                continue
+            settings[path] = con_inst.con_hash
+
+        return (
+            dbus.Dictionary(settings, signature="oa{sa{sv}}"),
+            dbus.UInt32(len(paths) - end),
+            dbus.UInt64(self.connections_serial),
+        )
+
+    @dbus.service.method(
+        dbus_interface=IFACE_SETTINGS,
+        in_signature="a(soa{sa{sv}})ua{sv}",
+        out_signature="a(os)",
+    )
+    def ApplyConnections(self, operations, flags, args):
+        to_disk = NM.SettingsAddConnection2Flags.TO_DISK
+        in_memory = NM.SettingsAddConnection2Flags.IN_MEMORY
+        block_autoconnect = NM.SettingsAddConnection2Flags.BLOCK_AUTOCONNECT
+
+        if flags & ~(to_disk | in_memory | block_autoconnect):
+            raise BusErr.InvalidSettingsArgumentsException("Unknown flags")
+        if bool(flags & to_disk) == bool(flags & in_memory):
+            raise BusErr.InvalidSettingsArgumentsException(
+                "Requires exactly one of to-disk (0x1) or in-memory (0x2) flags"
+            )
+        for name in args:
+            raise BusErr.InvalidSettingsArgumentsException(
+                "Unsupported argument '%s'" % (name)
+            )
+
+        # Like the daemon, validate all operations before touching any
+        # profile. An invalid operation fails the entire call.
+        uuids = set()
+        for kind, path, con_hash in operations:
+            if kind not in ["add", "update", "delete"]:
+                raise BusErr.InvalidSettingsArgumentsException(
+                    "unknown operation '%s'" % (kind)
+                )
+            if kind == "add":
+                if path != "/":
+                    raise BusErr.InvalidSettingsArgumentsException(
+                        'add requires "/" as connection path'
+                    )
+            elif path not in self.connections:
+                raise BusErr.InvalidSettingsArgumentsException(
+                    "connection '%s' does not exist" % (path)
+                )
+
+            if kind == "delete":
+                if len(con_hash) > 0:
+                    raise BusErr.InvalidSettingsArgumentsException(
+                        "delete does not accept settings"
+                    )
+                uuid = self.connections[path].get_uuid()
+            else:
+                NmUtil.con_hash_verify(con_hash)
+                uuid = NmUtil.con_hash_get_uuid(con_hash)
+                if kind == "add":
+                    if uuid in [c.get_uuid() for c in self.get_connections()]:
+                        raise BusErr.InvalidSettingException(
+                            "a connection with UUID '%s' already exists" % (uuid)
+                        )
+                elif uuid != self.connections[path].get_uuid():
+                    raise BusErr.InvalidSettingsArgumentsException(
+                        "update cannot change the connection UUID"
+                    )
+
+            if uuid in uuids:
+                raise BusErr.InvalidSettingsArgumentsException(
+                    "connection '%s' is referenced more than once" % (uuid)
+                )
+            uuids.add(uuid)
+
+        results = []
+        for kind, path, con_hash in operations:
+            if kind == "add":
+                results.append((self.add_connection(con_hash), ""))
+            elif kind == "update":
+                self.update_connection(con_hash, path)
+                results.append((path, ""))
+            else:
+                self.delete_connection(self.connections[path])
+                results.append(("/", ""))
+        return dbus.Array(results, signature="(os)")
+
     @dbus.service.method(
         dbus_interface=IFACE_SETTINGS, in_signature="", out_signature="b"
     )
@@ -2252,6 +2417,7 @@ class Settings(ExportedObj):
 
         con_inst.export()
         self.connections[con_inst.path] = con_inst
+        self.connections_serial += 1
         self.NewConnection(con_inst.path)
         self._dbus_property_set(
             IFACE_SETTINGS,
@@ -2286,6 +2452,7 @@ class Settings(ExportedObj):
 
     def delete_connection(self, con_inst):
         del self.connections[con_inst.path]
+        self.connections_serial += 1
         self._dbus_property_set(
             IFACE_SETTINGS,
             PRP_SETTINGS_CONNECTIONS,